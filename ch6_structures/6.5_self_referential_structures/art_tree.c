@@ -0,0 +1,1109 @@
+/*
+    Contains implementation of the adaptive radix tree declared in art_tree.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    A key is its bytes including the terminating NUL. As NUL ends every key, no key is a prefix of another, so
+    every key ends at a leaf and inner nodes never hold keys. It also means a NUL never appears in a node's
+    prefix (the bytes of a prefix are always followed by a byte that tells the children apart), so comparing a
+    prefix with a key always finds a difference before running off the end of the key.
+
+    A child pointer is either an inner node or a leaf, told apart by its lowest bit (set for leaves, which
+    malloc() never returns). Only the first MAX_PREFIX bytes of a compressed prefix are stored in the node.
+    Searches skip the rest and check the key at the leaf, and the operations that need the whole prefix read
+    it from any leaf below the node, as all of them share it.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "art_tree.h" // needed for adaptive radix tree operations
+#include <stdint.h>   // needed for uint8_t, uint16_t, uint32_t, uintptr_t
+#include <stdlib.h>   // needed for malloc(), free()
+#include <stddef.h>   // needed for size_t
+#include <string.h>   // needed for memcpy(), memmove(), memcmp(), strlen(), strcmp()
+
+// SSE2 search of Node16 where the compiler targets it (always on x86-64)
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h> // needed for _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#define ART_SSE2
+#endif
+
+// ***************************** CONSTANTS ***********************************************
+
+#define MAX_PREFIX 10 // bytes of a compressed prefix stored in a node
+
+// node types, named after how many children they hold
+#define NODE4 0
+#define NODE16 1
+#define NODE48 2
+#define NODE256 3
+
+// node sizes at which a node is replaced by the next smaller type after a deletion
+#define SHRINK16 3
+#define SHRINK48 12
+#define SHRINK256 37
+
+// tagged child pointers
+#define IS_LEAF(p) (((uintptr_t)(p)) & 1)
+#define AS_LEAF(p) ((struct artLeaf *)((uintptr_t)(p) - 1))
+#define TAG_LEAF(l) ((void *)((uintptr_t)(l) + 1))
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a leaf, which holds a key.
+
+    Fields:
+        length (size_t) : number of bytes of the key, including its NUL
+        key (char []) : the key (flexible array member)
+*/
+struct artLeaf
+{
+    size_t length;
+    char key[];
+};
+
+/*
+    Structure for the header shared by every inner node.
+
+    Fields:
+        type (uint8_t) : NODE4, NODE16, NODE48, or NODE256
+        count (uint16_t) : number of children
+        prefixLength (uint32_t) : length of the compressed prefix (bytes shared by every key below the node that
+            come after the byte leading to it)
+        prefix (unsigned char []) : the first MAX_PREFIX bytes of the prefix (or all of them if it is shorter)
+*/
+struct artNode
+{
+    uint8_t type;
+    uint16_t count;
+    uint32_t prefixLength;
+    unsigned char prefix[MAX_PREFIX];
+};
+
+/*
+    Structures for inner nodes of up to 4 and 16 children. keys[i] is the byte leading to children[i], and the
+    first count keys are sorted.
+*/
+struct artNode4
+{
+    struct artNode n;
+    unsigned char keys[4];
+    void *children[4];
+};
+
+struct artNode16
+{
+    struct artNode n;
+    unsigned char keys[16];
+    void *children[16];
+};
+
+/*
+    Structure for inner nodes of up to 48 children. index[b] is 1 + the slot in children of the child for byte
+    b, or 0 if there is none. Free slots are NULL.
+*/
+struct artNode48
+{
+    struct artNode n;
+    unsigned char index[256];
+    void *children[48];
+};
+
+/*
+    Structure for inner nodes of up to 256 children, children[b] is the child for byte b (or NULL).
+*/
+struct artNode256
+{
+    struct artNode n;
+    void *children[256];
+};
+
+/*
+    Structure that represents an adaptive radix tree.
+
+    Fields:
+        root (void *) : root child pointer (a node, a tagged leaf, or NULL)
+        size (size_t) : number of keys
+        memory (size_t) : number of bytes allocated for nodes and leaves
+*/
+struct ArtTree
+{
+    void *root;
+    size_t size;
+    size_t memory;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Allocation helpers. makeLeaf() copies a key of length bytes (including its NUL), createNode() makes an empty
+    node of a type, and freeNode() / freeLeaf() release them. The tree's memory count is kept up to date.
+
+    Runtime: O(1), O(length) for makeLeaf()
+*/
+static void *makeLeaf(ArtTree *t, const char *key, size_t length);
+static struct artNode *createNode(ArtTree *t, int type);
+static void freeNode(ArtTree *t, struct artNode *n);
+static void freeLeaf(ArtTree *t, struct artLeaf *l);
+
+/*
+    Retrieves the address of the child pointer of a node for a byte.
+
+    Parameters:
+        n (struct artNode *) : pointer to the node
+        b (unsigned char) : the byte
+
+    Output:
+        A pointer to the child pointer, or NULL if the node has no child for b.
+
+    Runtime: O(1)
+*/
+static void **findChild(struct artNode *n, unsigned char b);
+
+/*
+    Retrieve the child of a node with the smallest byte >= b (childAtOrAfter()) or the largest byte <= b
+    (childAtOrBefore()).
+
+    Parameters:
+        n (const struct artNode *) : pointer to the node
+        b (int) : the byte, which may be 256 for childAtOrAfter() and -1 for childAtOrBefore() (no child)
+        byte (int *) : where the byte of the child found is stored
+
+    Output:
+        The child, or NULL if there is none.
+
+    Runtime: O(256) at worst (Node48 and Node256 are scanned)
+*/
+static void *childAtOrAfter(const struct artNode *n, int b, int *byte);
+static void *childAtOrBefore(const struct artNode *n, int b, int *byte);
+
+/*
+    Adds a child for a byte the node doesn't have a child for, replacing the node with a larger one if it is
+    full.
+
+    Parameters:
+        t (ArtTree *) : pointer to the tree
+        ref (void **) : pointer to the child pointer that points to the node (updated if the node is replaced)
+        n (struct artNode *) : pointer to the node
+        b (unsigned char) : the byte
+        child (void *) : the child
+
+    Runtime: O(1) (O(256) when a node is replaced)
+*/
+static void addChild(ArtTree *t, void **ref, struct artNode *n, unsigned char b, void *child);
+
+/*
+    Removes the child for a byte from a node, replacing the node with a smaller one when it becomes sparse. A
+    Node4 left with a single child is replaced by that child, whose prefix absorbs the node's prefix and byte.
+
+    Parameters:
+        t (ArtTree *) : pointer to the tree
+        ref (void **) : pointer to the child pointer that points to the node (updated if the node is replaced)
+        n (struct artNode *) : pointer to the node
+        b (unsigned char) : the byte
+
+    Runtime: O(1) (O(256) when a node is replaced)
+*/
+static void removeChild(ArtTree *t, void **ref, struct artNode *n, unsigned char b);
+
+/*
+    Retrieve the leaf with the smallest (largest) key below a child pointer.
+
+    Parameters:
+        node (const void *) : the child pointer (not NULL)
+
+    Runtime: O(height of the subtree)
+*/
+static struct artLeaf *minimumLeaf(const void *node);
+static struct artLeaf *maximumLeaf(const void *node);
+
+/*
+    Counts how many bytes of a node's prefix match a key, starting at depth in the key. The bytes that are not
+    stored in the node are read from a leaf.
+
+    Parameters:
+        n (const struct artNode *) : pointer to the node
+        key (const char *) : the key
+        length (size_t) : length of the key including its NUL
+        depth (size_t) : position in the key that corresponds to the start of the prefix
+
+    Output:
+        The number of matching bytes, n->prefixLength if the whole prefix matches.
+
+    Runtime: O(prefix length)
+*/
+static size_t prefixMismatch(const struct artNode *n, const char *key, size_t length, size_t depth);
+
+/*
+    Compares a node's whole prefix with the bytes of a key starting at depth.
+
+    Parameters:
+        n (const struct artNode *) : pointer to the node
+        key (const char *) : the key
+        depth (size_t) : position in the key that corresponds to the start of the prefix
+
+    Output:
+        < 0, 0, or > 0 as the prefix is smaller than, equal to, or larger than the key's bytes. When it is not
+        0, every key below the node compares with key the same way.
+
+    Runtime: O(prefix length)
+*/
+static int comparePrefix(const struct artNode *n, const char *key, size_t depth);
+
+/*
+    Recursive helpers of artInsert(), artDelete(), artSuccessor(), artPredecessor(), artRange(), and
+    artFree(). Each works on the subtree behind a child pointer (ref, or node) whose prefix starts at depth in
+    the key.
+
+    Runtime: see the corresponding public function
+*/
+static int insertAt(ArtTree *t, void **ref, const char *key, size_t length, size_t depth);
+static int deleteAt(ArtTree *t, void **ref, const char *key, size_t length, size_t depth);
+static struct artLeaf *successorAt(const void *node, const char *key, size_t depth);
+static struct artLeaf *predecessorAt(const void *node, const char *key, size_t depth);
+static int rangeAt(const void *node, size_t depth, const char *low, const char *high, void (*visit)(const char *, void *), void *arg, size_t *count);
+static void freeAt(ArtTree *t, void *node);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+ArtTree *artCreate(void)
+{
+    ArtTree *t = (ArtTree *)malloc(sizeof(ArtTree));
+    t->root = NULL;
+    t->size = 0;
+    t->memory = 0;
+    return t;
+}
+
+const char *artSearch(const ArtTree *t, const char *key)
+{
+    size_t length = strlen(key) + 1;
+    size_t depth = 0;
+    const void *node = t->root;
+    while (node != NULL && !IS_LEAF(node))
+    {
+        // only the stored part of the prefix is checked, the leaf is compared in full
+        const struct artNode *n = (const struct artNode *)node;
+        if (n->prefixLength > 0)
+        {
+            size_t stored = n->prefixLength < MAX_PREFIX ? n->prefixLength : MAX_PREFIX;
+            if (depth + stored >= length || memcmp(n->prefix, key + depth, stored) != 0)
+            {
+                return NULL;
+            }
+            depth += n->prefixLength;
+            if (depth >= length)
+            {
+                return NULL;
+            }
+        }
+        void **child = findChild((struct artNode *)n, (unsigned char)key[depth]);
+        node = child != NULL ? *child : NULL;
+        depth++;
+    }
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    const struct artLeaf *l = AS_LEAF(node);
+    return l->length == length && memcmp(l->key, key, length) == 0 ? l->key : NULL;
+}
+
+const char *artMinimum(const ArtTree *t)
+{
+    return t->root != NULL ? minimumLeaf(t->root)->key : NULL;
+}
+
+const char *artMaximum(const ArtTree *t)
+{
+    return t->root != NULL ? maximumLeaf(t->root)->key : NULL;
+}
+
+const char *artPredecessor(const ArtTree *t, const char *key)
+{
+    struct artLeaf *l = t->root != NULL ? predecessorAt(t->root, key, 0) : NULL;
+    return l != NULL ? l->key : NULL;
+}
+
+const char *artSuccessor(const ArtTree *t, const char *key)
+{
+    struct artLeaf *l = t->root != NULL ? successorAt(t->root, key, 0) : NULL;
+    return l != NULL ? l->key : NULL;
+}
+
+int artInsert(ArtTree *t, const char *key)
+{
+    int inserted = insertAt(t, &t->root, key, strlen(key) + 1, 0);
+    t->size += inserted;
+    return inserted;
+}
+
+int artDelete(ArtTree *t, const char *key)
+{
+    int deleted = deleteAt(t, &t->root, key, strlen(key) + 1, 0);
+    t->size -= deleted;
+    return deleted;
+}
+
+size_t artRange(const ArtTree *t, const char *low, const char *high, void (*visit)(const char *, void *), void *arg)
+{
+    size_t count = 0;
+    if (t->root != NULL)
+    {
+        rangeAt(t->root, 0, low, high, visit, arg, &count);
+    }
+    return count;
+}
+
+size_t artSize(const ArtTree *t)
+{
+    return t->size;
+}
+
+size_t artMemory(const ArtTree *t)
+{
+    return t->memory;
+}
+
+void artFree(ArtTree *t)
+{
+    if (t->root != NULL)
+    {
+        freeAt(t, t->root);
+    }
+    free((void *)t);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static void *makeLeaf(ArtTree *t, const char *key, size_t length)
+{
+    struct artLeaf *l = (struct artLeaf *)malloc(sizeof(struct artLeaf) + length);
+    l->length = length;
+    memcpy(l->key, key, length);
+    t->memory += sizeof(struct artLeaf) + length;
+    return TAG_LEAF(l);
+}
+
+static struct artNode *createNode(ArtTree *t, int type)
+{
+    size_t bytes = 0;
+    switch (type)
+    {
+    case NODE4:
+        bytes = sizeof(struct artNode4);
+        break;
+    case NODE16:
+        bytes = sizeof(struct artNode16);
+        break;
+    case NODE48:
+        bytes = sizeof(struct artNode48);
+        break;
+    default:
+        bytes = sizeof(struct artNode256);
+        break;
+    }
+    // zeroed, so Node48's index and Node256's children start out empty
+    struct artNode *n = (struct artNode *)calloc(1, bytes);
+    n->type = (uint8_t)type;
+    t->memory += bytes;
+    return n;
+}
+
+static void freeNode(ArtTree *t, struct artNode *n)
+{
+    switch (n->type)
+    {
+    case NODE4:
+        t->memory -= sizeof(struct artNode4);
+        break;
+    case NODE16:
+        t->memory -= sizeof(struct artNode16);
+        break;
+    case NODE48:
+        t->memory -= sizeof(struct artNode48);
+        break;
+    default:
+        t->memory -= sizeof(struct artNode256);
+        break;
+    }
+    free((void *)n);
+}
+
+static void freeLeaf(ArtTree *t, struct artLeaf *l)
+{
+    t->memory -= sizeof(struct artLeaf) + l->length;
+    free((void *)l);
+}
+
+static void **findChild(struct artNode *n, unsigned char b)
+{
+    switch (n->type)
+    {
+    case NODE4:
+    {
+        struct artNode4 *n4 = (struct artNode4 *)n;
+        for (int i = 0; i < n->count; i++)
+        {
+            if (n4->keys[i] == b)
+            {
+                return &n4->children[i];
+            }
+        }
+        return NULL;
+    }
+    case NODE16:
+    {
+        struct artNode16 *n16 = (struct artNode16 *)n;
+#ifdef ART_SSE2
+        // compare b with all 16 keys at once, the mask has a bit for each equal key in use
+        __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)b), _mm_loadu_si128((const __m128i *)n16->keys));
+        int mask = _mm_movemask_epi8(cmp) & ((1 << n->count) - 1);
+        return mask != 0 ? &n16->children[__builtin_ctz((unsigned)mask)] : NULL;
+#else
+        for (int i = 0; i < n->count; i++)
+        {
+            if (n16->keys[i] == b)
+            {
+                return &n16->children[i];
+            }
+        }
+        return NULL;
+#endif
+    }
+    case NODE48:
+    {
+        struct artNode48 *n48 = (struct artNode48 *)n;
+        return n48->index[b] != 0 ? &n48->children[n48->index[b] - 1] : NULL;
+    }
+    default:
+    {
+        struct artNode256 *n256 = (struct artNode256 *)n;
+        return n256->children[b] != NULL ? &n256->children[b] : NULL;
+    }
+    }
+}
+
+static void *childAtOrAfter(const struct artNode *n, int b, int *byte)
+{
+    switch (n->type)
+    {
+    case NODE4:
+    case NODE16:
+    {
+        // Node4 and Node16 have the same layout up to the size of their arrays
+        const unsigned char *keys = n->type == NODE4 ? ((const struct artNode4 *)n)->keys : ((const struct artNode16 *)n)->keys;
+        void *const *children = n->type == NODE4 ? ((const struct artNode4 *)n)->children : ((const struct artNode16 *)n)->children;
+        for (int i = 0; i < n->count; i++)
+        {
+            if (keys[i] >= b)
+            {
+                *byte = keys[i];
+                return children[i];
+            }
+        }
+        return NULL;
+    }
+    case NODE48:
+    {
+        const struct artNode48 *n48 = (const struct artNode48 *)n;
+        for (int c = b; c < 256; c++)
+        {
+            if (n48->index[c] != 0)
+            {
+                *byte = c;
+                return n48->children[n48->index[c] - 1];
+            }
+        }
+        return NULL;
+    }
+    default:
+    {
+        const struct artNode256 *n256 = (const struct artNode256 *)n;
+        for (int c = b; c < 256; c++)
+        {
+            if (n256->children[c] != NULL)
+            {
+                *byte = c;
+                return n256->children[c];
+            }
+        }
+        return NULL;
+    }
+    }
+}
+
+static void *childAtOrBefore(const struct artNode *n, int b, int *byte)
+{
+    switch (n->type)
+    {
+    case NODE4:
+    case NODE16:
+    {
+        const unsigned char *keys = n->type == NODE4 ? ((const struct artNode4 *)n)->keys : ((const struct artNode16 *)n)->keys;
+        void *const *children = n->type == NODE4 ? ((const struct artNode4 *)n)->children : ((const struct artNode16 *)n)->children;
+        for (int i = n->count - 1; i >= 0; i--)
+        {
+            if (keys[i] <= b)
+            {
+                *byte = keys[i];
+                return children[i];
+            }
+        }
+        return NULL;
+    }
+    case NODE48:
+    {
+        const struct artNode48 *n48 = (const struct artNode48 *)n;
+        for (int c = b; c >= 0; c--)
+        {
+            if (n48->index[c] != 0)
+            {
+                *byte = c;
+                return n48->children[n48->index[c] - 1];
+            }
+        }
+        return NULL;
+    }
+    default:
+    {
+        const struct artNode256 *n256 = (const struct artNode256 *)n;
+        for (int c = b; c >= 0; c--)
+        {
+            if (n256->children[c] != NULL)
+            {
+                *byte = c;
+                return n256->children[c];
+            }
+        }
+        return NULL;
+    }
+    }
+}
+
+static void addChild(ArtTree *t, void **ref, struct artNode *n, unsigned char b, void *child)
+{
+    if (n->type == NODE4 || n->type == NODE16)
+    {
+        int capacity = n->type == NODE4 ? 4 : 16;
+        unsigned char *keys = n->type == NODE4 ? ((struct artNode4 *)n)->keys : ((struct artNode16 *)n)->keys;
+        void **children = n->type == NODE4 ? ((struct artNode4 *)n)->children : ((struct artNode16 *)n)->children;
+        if (n->count < capacity)
+        {
+            // keep the keys sorted for the ordered operations
+            int pos = 0;
+            while (pos < n->count && keys[pos] < b)
+            {
+                pos++;
+            }
+            memmove(keys + pos + 1, keys + pos, (size_t)(n->count - pos));
+            memmove(children + pos + 1, children + pos, (size_t)(n->count - pos) * sizeof(void *));
+            keys[pos] = b;
+            children[pos] = child;
+            n->count++;
+            return;
+        }
+
+        // full, move to the next larger type
+        struct artNode *bigger = createNode(t, n->type == NODE4 ? NODE16 : NODE48);
+        bigger->count = n->count;
+        bigger->prefixLength = n->prefixLength;
+        memcpy(bigger->prefix, n->prefix, MAX_PREFIX);
+        if (n->type == NODE4)
+        {
+            memcpy(((struct artNode16 *)bigger)->keys, keys, 4);
+            memcpy(((struct artNode16 *)bigger)->children, children, 4 * sizeof(void *));
+        }
+        else
+        {
+            struct artNode48 *n48 = (struct artNode48 *)bigger;
+            for (int i = 0; i < 16; i++)
+            {
+                n48->index[keys[i]] = (unsigned char)(i + 1);
+                n48->children[i] = children[i];
+            }
+        }
+        freeNode(t, n);
+        *ref = bigger;
+        addChild(t, ref, bigger, b, child);
+        return;
+    }
+
+    if (n->type == NODE48)
+    {
+        struct artNode48 *n48 = (struct artNode48 *)n;
+        if (n->count < 48)
+        {
+            int slot = 0;
+            while (n48->children[slot] != NULL)
+            {
+                slot++;
+            }
+            n48->children[slot] = child;
+            n48->index[b] = (unsigned char)(slot + 1);
+            n->count++;
+            return;
+        }
+        struct artNode256 *n256 = (struct artNode256 *)createNode(t, NODE256);
+        n256->n.count = n->count;
+        n256->n.prefixLength = n->prefixLength;
+        memcpy(n256->n.prefix, n->prefix, MAX_PREFIX);
+        for (int c = 0; c < 256; c++)
+        {
+            if (n48->index[c] != 0)
+            {
+                n256->children[c] = n48->children[n48->index[c] - 1];
+            }
+        }
+        freeNode(t, n);
+        *ref = n256;
+        n = (struct artNode *)n256;
+    }
+
+    ((struct artNode256 *)n)->children[b] = child;
+    n->count++;
+}
+
+static void removeChild(ArtTree *t, void **ref, struct artNode *n, unsigned char b)
+{
+    if (n->type == NODE4 || n->type == NODE16)
+    {
+        unsigned char *keys = n->type == NODE4 ? ((struct artNode4 *)n)->keys : ((struct artNode16 *)n)->keys;
+        void **children = n->type == NODE4 ? ((struct artNode4 *)n)->children : ((struct artNode16 *)n)->children;
+        int pos = 0;
+        while (keys[pos] != b)
+        {
+            pos++;
+        }
+        memmove(keys + pos, keys + pos + 1, (size_t)(n->count - pos - 1));
+        memmove(children + pos, children + pos + 1, (size_t)(n->count - pos - 1) * sizeof(void *));
+        n->count--;
+
+        if (n->type == NODE16 && n->count == SHRINK16)
+        {
+            struct artNode4 *n4 = (struct artNode4 *)createNode(t, NODE4);
+            n4->n.count = n->count;
+            n4->n.prefixLength = n->prefixLength;
+            memcpy(n4->n.prefix, n->prefix, MAX_PREFIX);
+            memcpy(n4->keys, keys, (size_t)n->count);
+            memcpy(n4->children, children, (size_t)n->count * sizeof(void *));
+            freeNode(t, n);
+            *ref = n4;
+        }
+        else if (n->type == NODE4 && n->count == 1)
+        {
+            // the only child takes the node's place, an inner child's prefix becomes node prefix + byte +
+            // child prefix (of which the first MAX_PREFIX bytes are stored)
+            void *child = children[0];
+            if (!IS_LEAF(child))
+            {
+                struct artNode *c = (struct artNode *)child;
+                unsigned char merged[MAX_PREFIX];
+                size_t used = n->prefixLength < MAX_PREFIX ? n->prefixLength : MAX_PREFIX;
+                memcpy(merged, n->prefix, used);
+                if (used < MAX_PREFIX)
+                {
+                    merged[used++] = keys[0];
+                }
+                if (used < MAX_PREFIX)
+                {
+                    size_t more = c->prefixLength < MAX_PREFIX - used ? c->prefixLength : MAX_PREFIX - used;
+                    memcpy(merged + used, c->prefix, more);
+                    used += more;
+                }
+                memcpy(c->prefix, merged, used);
+                c->prefixLength += n->prefixLength + 1;
+            }
+            freeNode(t, n);
+            *ref = child;
+        }
+        return;
+    }
+
+    if (n->type == NODE48)
+    {
+        struct artNode48 *n48 = (struct artNode48 *)n;
+        n48->children[n48->index[b] - 1] = NULL;
+        n48->index[b] = 0;
+        n->count--;
+        if (n->count == SHRINK48)
+        {
+            // bytes in increasing order give the sorted keys of a Node16
+            struct artNode16 *n16 = (struct artNode16 *)createNode(t, NODE16);
+            n16->n.count = n->count;
+            n16->n.prefixLength = n->prefixLength;
+            memcpy(n16->n.prefix, n->prefix, MAX_PREFIX);
+            int i = 0;
+            for (int c = 0; c < 256; c++)
+            {
+                if (n48->index[c] != 0)
+                {
+                    n16->keys[i] = (unsigned char)c;
+                    n16->children[i++] = n48->children[n48->index[c] - 1];
+                }
+            }
+            freeNode(t, n);
+            *ref = n16;
+        }
+        return;
+    }
+
+    struct artNode256 *n256 = (struct artNode256 *)n;
+    n256->children[b] = NULL;
+    n->count--;
+    if (n->count == SHRINK256)
+    {
+        struct artNode48 *n48 = (struct artNode48 *)createNode(t, NODE48);
+        n48->n.count = n->count;
+        n48->n.prefixLength = n->prefixLength;
+        memcpy(n48->n.prefix, n->prefix, MAX_PREFIX);
+        int slot = 0;
+        for (int c = 0; c < 256; c++)
+        {
+            if (n256->children[c] != NULL)
+            {
+                n48->children[slot] = n256->children[c];
+                n48->index[c] = (unsigned char)(++slot);
+            }
+        }
+        freeNode(t, n);
+        *ref = n48;
+    }
+}
+
+static struct artLeaf *minimumLeaf(const void *node)
+{
+    int byte = 0;
+    while (!IS_LEAF(node))
+    {
+        node = childAtOrAfter((const struct artNode *)node, 0, &byte);
+    }
+    return AS_LEAF(node);
+}
+
+static struct artLeaf *maximumLeaf(const void *node)
+{
+    int byte = 0;
+    while (!IS_LEAF(node))
+    {
+        node = childAtOrBefore((const struct artNode *)node, 255, &byte);
+    }
+    return AS_LEAF(node);
+}
+
+static size_t prefixMismatch(const struct artNode *n, const char *key, size_t length, size_t depth)
+{
+    size_t stored = n->prefixLength < MAX_PREFIX ? n->prefixLength : MAX_PREFIX;
+    size_t i = 0;
+    for (; i < stored && depth + i < length; i++)
+    {
+        if (n->prefix[i] != (unsigned char)key[depth + i])
+        {
+            return i;
+        }
+    }
+    if (n->prefixLength > MAX_PREFIX)
+    {
+        // the rest of the prefix is in every leaf below
+        const struct artLeaf *l = minimumLeaf(n);
+        for (; i < n->prefixLength && depth + i < length; i++)
+        {
+            if (l->key[depth + i] != key[depth + i])
+            {
+                return i;
+            }
+        }
+    }
+    return i;
+}
+
+static int comparePrefix(const struct artNode *n, const char *key, size_t depth)
+{
+    const unsigned char *prefix = n->prefixLength <= MAX_PREFIX ? n->prefix : (const unsigned char *)minimumLeaf(n)->key + depth;
+    for (size_t i = 0; i < n->prefixLength; i++)
+    {
+        unsigned char k = (unsigned char)key[depth + i];
+        if (prefix[i] != k)
+        {
+            return prefix[i] < k ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static int insertAt(ArtTree *t, void **ref, const char *key, size_t length, size_t depth)
+{
+    void *node = *ref;
+    if (node == NULL)
+    {
+        *ref = makeLeaf(t, key, length);
+        return 1;
+    }
+
+    if (IS_LEAF(node))
+    {
+        struct artLeaf *l = AS_LEAF(node);
+        if (l->length == length && memcmp(l->key, key, length) == 0)
+        {
+            return 0;
+        }
+        // the keys agree up to depth, a Node4 with their common bytes as its prefix separates them (neither is
+        // a prefix of the other, so they differ before either ends)
+        size_t common = 0;
+        while (l->key[depth + common] == key[depth + common])
+        {
+            common++;
+        }
+        struct artNode *n = createNode(t, NODE4);
+        n->prefixLength = (uint32_t)common;
+        memcpy(n->prefix, key + depth, common < MAX_PREFIX ? common : MAX_PREFIX);
+        *ref = n;
+        addChild(t, ref, n, (unsigned char)l->key[depth + common], node);
+        addChild(t, ref, n, (unsigned char)key[depth + common], makeLeaf(t, key, length));
+        return 1;
+    }
+
+    struct artNode *n = (struct artNode *)node;
+    if (n->prefixLength > 0)
+    {
+        size_t match = prefixMismatch(n, key, length, depth);
+        if (match < n->prefixLength)
+        {
+            // the key leaves the prefix after match bytes: a new Node4 takes the matching part, and n keeps
+            // what comes after the byte where they differ
+            struct artNode *parent = createNode(t, NODE4);
+            parent->prefixLength = (uint32_t)match;
+            memcpy(parent->prefix, key + depth, match < MAX_PREFIX ? match : MAX_PREFIX);
+            unsigned char nByte;
+            if (n->prefixLength <= MAX_PREFIX)
+            {
+                nByte = n->prefix[match];
+                n->prefixLength -= (uint32_t)(match + 1);
+                memmove(n->prefix, n->prefix + match + 1, n->prefixLength);
+            }
+            else
+            {
+                const struct artLeaf *l = minimumLeaf(n);
+                nByte = (unsigned char)l->key[depth + match];
+                n->prefixLength -= (uint32_t)(match + 1);
+                memcpy(n->prefix, l->key + depth + match + 1, n->prefixLength < MAX_PREFIX ? n->prefixLength : MAX_PREFIX);
+            }
+            *ref = parent;
+            addChild(t, ref, parent, nByte, n);
+            addChild(t, ref, parent, (unsigned char)key[depth + match], makeLeaf(t, key, length));
+            return 1;
+        }
+        depth += n->prefixLength;
+    }
+
+    void **child = findChild(n, (unsigned char)key[depth]);
+    if (child != NULL)
+    {
+        return insertAt(t, child, key, length, depth + 1);
+    }
+    addChild(t, ref, n, (unsigned char)key[depth], makeLeaf(t, key, length));
+    return 1;
+}
+
+static int deleteAt(ArtTree *t, void **ref, const char *key, size_t length, size_t depth)
+{
+    void *node = *ref;
+    if (node == NULL)
+    {
+        return 0;
+    }
+    if (IS_LEAF(node))
+    {
+        // only reached for a leaf at the root, other leaves are removed by their parent below
+        struct artLeaf *l = AS_LEAF(node);
+        if (l->length != length || memcmp(l->key, key, length) != 0)
+        {
+            return 0;
+        }
+        freeLeaf(t, l);
+        *ref = NULL;
+        return 1;
+    }
+
+    struct artNode *n = (struct artNode *)node;
+    if (n->prefixLength > 0)
+    {
+        if (prefixMismatch(n, key, length, depth) < n->prefixLength)
+        {
+            return 0;
+        }
+        depth += n->prefixLength;
+    }
+    if (depth >= length)
+    {
+        return 0;
+    }
+    unsigned char b = (unsigned char)key[depth];
+    void **child = findChild(n, b);
+    if (child == NULL)
+    {
+        return 0;
+    }
+    if (!IS_LEAF(*child))
+    {
+        return deleteAt(t, child, key, length, depth + 1);
+    }
+    struct artLeaf *l = AS_LEAF(*child);
+    if (l->length != length || memcmp(l->key, key, length) != 0)
+    {
+        return 0;
+    }
+    freeLeaf(t, l);
+    removeChild(t, ref, n, b);
+    return 1;
+}
+
+static struct artLeaf *successorAt(const void *node, const char *key, size_t depth)
+{
+    if (IS_LEAF(node))
+    {
+        struct artLeaf *l = AS_LEAF(node);
+        return strcmp(l->key, key) > 0 ? l : NULL;
+    }
+    const struct artNode *n = (const struct artNode *)node;
+    int c = comparePrefix(n, key, depth);
+    if (c != 0)
+    {
+        // the whole subtree is larger (then its minimum is the answer) or smaller than key
+        return c > 0 ? minimumLeaf(node) : NULL;
+    }
+    depth += n->prefixLength;
+
+    // the child on key's path may have a larger key, otherwise the next child's minimum is the successor
+    int b = (unsigned char)key[depth];
+    int byte = 0;
+    void **child = findChild((struct artNode *)n, (unsigned char)b);
+    if (child != NULL)
+    {
+        struct artLeaf *l = successorAt(*child, key, depth + 1);
+        if (l != NULL)
+        {
+            return l;
+        }
+    }
+    void *next = childAtOrAfter(n, b + 1, &byte);
+    return next != NULL ? minimumLeaf(next) : NULL;
+}
+
+static struct artLeaf *predecessorAt(const void *node, const char *key, size_t depth)
+{
+    if (IS_LEAF(node))
+    {
+        struct artLeaf *l = AS_LEAF(node);
+        return strcmp(l->key, key) < 0 ? l : NULL;
+    }
+    const struct artNode *n = (const struct artNode *)node;
+    int c = comparePrefix(n, key, depth);
+    if (c != 0)
+    {
+        return c < 0 ? maximumLeaf(node) : NULL;
+    }
+    depth += n->prefixLength;
+
+    int b = (unsigned char)key[depth];
+    int byte = 0;
+    void **child = findChild((struct artNode *)n, (unsigned char)b);
+    if (child != NULL)
+    {
+        struct artLeaf *l = predecessorAt(*child, key, depth + 1);
+        if (l != NULL)
+        {
+            return l;
+        }
+    }
+    void *prev = childAtOrBefore(n, b - 1, &byte);
+    return prev != NULL ? maximumLeaf(prev) : NULL;
+}
+
+static int rangeAt(const void *node, size_t depth, const char *low, const char *high, void (*visit)(const char *, void *), void *arg, size_t *count)
+{
+    // low (high) is NULL once every key below is known to be above (below) it. Returns 0 once a key above
+    // high is reached, which ends the walk.
+    if (IS_LEAF(node))
+    {
+        const struct artLeaf *l = AS_LEAF(node);
+        if (low != NULL && strcmp(l->key, low) < 0)
+        {
+            return 1;
+        }
+        if (high != NULL && strcmp(l->key, high) > 0)
+        {
+            return 0;
+        }
+        (*visit)(l->key, arg);
+        (*count)++;
+        return 1;
+    }
+
+    const struct artNode *n = (const struct artNode *)node;
+    if (n->prefixLength > 0)
+    {
+        int c = low != NULL ? comparePrefix(n, low, depth) : 1;
+        if (c < 0)
+        {
+            return 1;
+        }
+        low = c == 0 ? low : NULL;
+        c = high != NULL ? comparePrefix(n, high, depth) : -1;
+        if (c > 0)
+        {
+            return 0;
+        }
+        high = c == 0 ? high : NULL;
+        depth += n->prefixLength;
+    }
+
+    // children from low's byte on, up to high's byte
+    int b = low != NULL ? (unsigned char)low[depth] : 0;
+    int byte = 0;
+    const void *child = NULL;
+    while ((child = childAtOrAfter(n, b, &byte)) != NULL)
+    {
+        if (high != NULL && byte > (unsigned char)high[depth])
+        {
+            return 0;
+        }
+        const char *childLow = low != NULL && byte == (unsigned char)low[depth] ? low : NULL;
+        const char *childHigh = high != NULL && byte == (unsigned char)high[depth] ? high : NULL;
+        if (!rangeAt(child, depth + 1, childLow, childHigh, visit, arg, count))
+        {
+            return 0;
+        }
+        b = byte + 1;
+    }
+    return 1;
+}
+
+static void freeAt(ArtTree *t, void *node)
+{
+    if (IS_LEAF(node))
+    {
+        freeLeaf(t, AS_LEAF(node));
+        return;
+    }
+    struct artNode *n = (struct artNode *)node;
+    int b = 0;
+    int byte = 0;
+    void *child = NULL;
+    while ((child = childAtOrAfter(n, b, &byte)) != NULL)
+    {
+        freeAt(t, child);
+        b = byte + 1;
+    }
+    freeNode(t, n);
+}
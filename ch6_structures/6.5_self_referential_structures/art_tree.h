@@ -0,0 +1,176 @@
+/*
+    Contains declarations of an adaptive radix tree (ART), an ordered set of strings. It supports the ordered
+    set operations of trees.h (search, minimum, maximum, predecessor, successor, insertion, deletion, range).
+
+    A radix tree branches on one byte of the key per level instead of comparing whole keys, so a lookup reads
+    each byte of the key about once, where a BST calls strcmp() at every level and rereads the prefix the keys
+    share. To keep the nodes small, each inner node has one of 4 sizes (for up to 4, 16, 48, or 256 children)
+    and is grown or shrunk as children come and go. Chains of nodes with a single child are collapsed into a
+    prefix stored in the next node (path compression), so keys that share long prefixes (URLs, file paths)
+    don't need a node per shared byte. Nodes with 16 children are searched with SSE2 where it is available.
+
+    Keys are NUL terminated strings, ordered as by strcmp(). The tree keeps its own copy of every key.
+
+    For runtime calculations of the declared operations, they are done with respect to the length of the key
+    (L) and the number of keys in the tree (n). Unlike a BST, lookups don't depend on n.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef ART_TREE_H
+#define ART_TREE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the ArtTree. It is implemented via a structure that holds the root node, the number of
+    keys, and the number of bytes allocated.
+*/
+typedef struct ArtTree ArtTree;
+
+/*
+    Creates an empty ArtTree.
+
+    Output:
+        A pointer to the created ArtTree.
+
+    Runtime: O(1)
+*/
+ArtTree *artCreate(void);
+
+/*
+    Searches a provided tree for a provided key.
+
+    Parameters:
+        t (const ArtTree *) : pointer to the tree to search (not modified)
+        key (const char *) : the key being searched for (not modified)
+
+    Output:
+        A pointer to the tree's copy of key if it is in the tree, NULL otherwise. As with every pointer into the
+        tree returned below, it stays valid until the key is deleted.
+
+    Runtime: O(L)
+*/
+const char *artSearch(const ArtTree *t, const char *key);
+
+/*
+    Retrieve the tree's copy of the minimum and maximum keys of a provided tree.
+
+    Parameters:
+        t (const ArtTree *) : pointer to the tree (not modified)
+
+    Output:
+        A pointer to the minimum (maximum) key, or NULL if the tree is empty.
+
+    Runtime: O(height of the tree), at most the length of the key found
+*/
+const char *artMinimum(const ArtTree *t);
+const char *artMaximum(const ArtTree *t);
+
+/*
+    Retrieve the tree's copy of the largest key smaller (smallest key larger) than a provided key. As with
+    bstPredecessor() and bstSuccessor(), key does not need to be in the tree.
+
+    Parameters:
+        t (const ArtTree *) : pointer to the tree (not modified)
+        key (const char *) : the key (not modified)
+
+    Output:
+        A pointer to the predecessor (successor), or NULL if there is none.
+
+    Runtime: O(L + length of the key found)
+*/
+const char *artPredecessor(const ArtTree *t, const char *key);
+const char *artSuccessor(const ArtTree *t, const char *key);
+
+/*
+    Inserts a copy of a provided key into a provided tree.
+
+    Parameters:
+        t (ArtTree *) : pointer to the tree to insert into
+        key (const char *) : the key to insert
+
+    Output:
+        1 if key was inserted, 0 if it was already in the tree (the tree is unchanged).
+
+    Runtime: O(L)
+
+        NOTE: memory allocation is assumed to be independent
+*/
+int artInsert(ArtTree *t, const char *key);
+
+/*
+    Deletes a provided key from a provided tree.
+
+    Parameters:
+        t (ArtTree *) : pointer to the tree to delete from
+        key (const char *) : the key to delete (not modified)
+
+    Output:
+        1 if key was deleted, 0 if it was not in the tree (the tree is unchanged).
+
+    Runtime: O(L)
+*/
+int artDelete(ArtTree *t, const char *key);
+
+/*
+    Visits the keys of a provided tree in a range, in order.
+
+    Parameters:
+        t (const ArtTree *) : pointer to the tree (not modified)
+        low (const char *) : the smallest key to visit, or NULL to start at the minimum
+        high (const char *) : the largest key to visit, or NULL to stop at the maximum
+        visit (void (*) (const char *, void *)) : function called with each key and arg. It must not modify the
+            tree.
+        arg (void *) : passed to every call of visit (may be NULL)
+
+    Output:
+        The number of keys visited.
+
+    Runtime: O(length of low + length of high + total length of the keys visited)
+*/
+size_t artRange(const ArtTree *t, const char *low, const char *high, void (*visit)(const char *, void *), void *arg);
+
+/*
+    Retrieves the number of keys in a provided tree.
+
+    Parameters:
+        t (const ArtTree *) : pointer to the tree (not modified)
+
+    Output:
+        The number of keys in the tree.
+
+    Runtime: O(1)
+*/
+size_t artSize(const ArtTree *t);
+
+/*
+    Retrieves the number of bytes a provided tree has allocated for its nodes and keys (not counting
+    allocator overhead), to compare its footprint with other structures.
+
+    Parameters:
+        t (const ArtTree *) : pointer to the tree (not modified)
+
+    Output:
+        The number of bytes allocated.
+
+    Runtime: O(1)
+*/
+size_t artMemory(const ArtTree *t);
+
+/*
+    De-allocates the memory allocated to a provided tree.
+
+    Parameters:
+        t (ArtTree *) : pointer to the tree to free
+
+    Output:
+        The tree, its nodes, and its keys are freed. The calling function should set t to NULL afterwards to
+        avoid undefined behavior.
+
+    Runtime: O(n + # nodes)
+*/
+void artFree(ArtTree *t);
+
+#endif
@@ -0,0 +1,221 @@
+#include "art_tree.h"
+#include "trees.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#define LARGE_KEYS 20000 // number of keys used by the large test
+
+void printVisit(const char *key, void *arg);
+void countVisit(const char *key, void *arg);
+void makeKey(char *buffer, int i);
+void smallTest(void);
+void largeTest(void);
+void fanoutTest(void);
+void memoryTest(void);
+
+int main()
+{
+    smallTest();
+    largeTest();
+    fanoutTest();
+    memoryTest();
+    return 0;
+}
+
+void smallTest(void)
+{
+    ArtTree *t = artCreate();
+    printf("%p\n", (void *)artMinimum(t));          // (nil)
+    printf("%p\n", (void *)artSuccessor(t, "a"));   // (nil)
+    printf("%d\n", artDelete(t, "a"));              // 0
+
+    // "/usr/lib" is a prefix of other keys, and the long shared prefixes are more than a node stores
+    const char *keys[] = {"/usr/lib/libc.so", "/usr/lib/libm.so", "/usr/lib", "/usr/bin/gcc", "/usr/bin/g++",
+                          "/home/user/documents/notes.txt", "/home/user/documents/draft.txt", "/", "a", ""};
+    for (int i = 0; i < 10; i++)
+    {
+        artInsert(t, keys[i]);
+    }
+    printf("%d\n", artInsert(t, "/usr/lib"));               // 0
+    printf("%u\n", (unsigned)artSize(t));                   // 10
+    printf("%s\n", artSearch(t, "/usr/bin/gcc"));           // /usr/bin/gcc
+    printf("%p\n", (void *)artSearch(t, "/usr/bin/gc"));    // (nil)
+    printf("%p\n", (void *)artSearch(t, "/usr/bin/gccx"));  // (nil)
+    printf("%p\n", (void *)artSearch(t, "/home/user/documents/notez.txt")); // (nil)
+    printf("[%s]\n", artMinimum(t));                        // []
+    printf("%s\n", artMaximum(t));                          // a
+    printf("%s\n", artSuccessor(t, "/usr/lib"));            // /usr/lib/libc.so
+    printf("%s\n", artSuccessor(t, "/usr/c"));              // /usr/lib
+    printf("%s\n", artSuccessor(t, "/home/user/documents/m")); // /home/user/documents/notes.txt
+    printf("%s\n", artPredecessor(t, "/usr/lib"));          // /usr/bin/gcc
+    printf("%s\n", artPredecessor(t, "/home/user/documents/zzz")); // /home/user/documents/notes.txt
+    printf("%s\n", artPredecessor(t, "/home"));             // /
+    printf("%p\n", (void *)artSuccessor(t, "a"));           // (nil)
+    printf("%p\n", (void *)artPredecessor(t, ""));          // (nil)
+
+    size_t count = artRange(t, "/usr", "/usr/lib/libc.so", printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // /usr/bin/g++ /usr/bin/gcc /usr/lib /usr/lib/libc.so \n 4
+    count = artRange(t, "/home/user/documents/e", NULL, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // /home/user/documents/notes.txt /usr/bin/g++ ... a \n 7
+
+    printf("%d\n", artDelete(t, "/usr/lib"));         // 1
+    printf("%d\n", artDelete(t, "/usr/lib"));         // 0
+    printf("%d\n", artDelete(t, "/usr/lib/libc.s"));  // 0
+    printf("%s\n", artSuccessor(t, "/usr/bin/gcc"));  // /usr/lib/libc.so
+    for (int i = 0; i < 10; i++)
+    {
+        artDelete(t, keys[i]);
+    }
+    printf("%u %u\n", (unsigned)artSize(t), (unsigned)artMemory(t)); // 0 0
+    artFree(t);
+    printf("SMALL TEST DONE.\n");
+}
+
+void largeTest(void)
+{
+    // random insertions and deletions of keys with shared prefixes, so every node type grows and shrinks,
+    // checked against a presence array
+    ArtTree *t = artCreate();
+    char *present = (char *)calloc(LARGE_KEYS, 1);
+    char key[32];
+    srand(47);
+    for (int i = 0; i < 200000; i++)
+    {
+        int k = rand() % LARGE_KEYS;
+        makeKey(key, k);
+        if (rand() % 3 == 0)
+        {
+            present[k] = 0;
+            artDelete(t, key);
+        }
+        else
+        {
+            present[k] = 1;
+            artInsert(t, key);
+        }
+    }
+
+    // makeKey() numbers are zero padded, so key order is number order
+    int ok = 1;
+    size_t size = 0;
+    int prev = -1;
+    for (int k = 0; k < LARGE_KEYS; k++)
+    {
+        makeKey(key, k);
+        const char *found = artSearch(t, key);
+        ok = ok && (found != NULL) == present[k] && (found == NULL || strcmp(found, key) == 0);
+        if (present[k])
+        {
+            char expected[32];
+            const char *p = artPredecessor(t, key);
+            if (prev >= 0)
+            {
+                makeKey(expected, prev);
+            }
+            ok = ok && (prev < 0 ? p == NULL : p != NULL && strcmp(p, expected) == 0);
+            prev = k;
+            size++;
+        }
+        else
+        {
+            // the successor of a missing key is the next present one
+            int next = k + 1;
+            while (next < LARGE_KEYS && !present[next])
+            {
+                next++;
+            }
+            char expected[32];
+            makeKey(expected, next);
+            const char *s = artSuccessor(t, key);
+            ok = ok && (next == LARGE_KEYS ? s == NULL : s != NULL && strcmp(s, expected) == 0);
+        }
+    }
+    size_t visited = 0;
+    ok = ok && artRange(t, NULL, NULL, countVisit, &visited) == size && visited == size;
+    printf("%d\n", ok);                             // 1
+    printf("%d\n", artSize(t) == size);             // 1
+
+    for (int k = 0; k < LARGE_KEYS; k++)
+    {
+        makeKey(key, k);
+        artDelete(t, key);
+    }
+    printf("%u %u\n", (unsigned)artSize(t), (unsigned)artMemory(t)); // 0 0
+    artFree(t);
+    free(present);
+    printf("LARGE TEST DONE.\n");
+}
+
+void fanoutTest(void)
+{
+    // "k" followed by every byte gives a node with 255 children, which shrinks back down as they are deleted
+    ArtTree *t = artCreate();
+    char key[3] = {'k', 0, 0};
+    for (int c = 255; c >= 1; c--)
+    {
+        key[1] = (char)c;
+        artInsert(t, key);
+    }
+    artInsert(t, "j");
+    int ok = 1;
+    for (int c = 1; c <= 255; c++)
+    {
+        // delete every other byte, then every remaining one, checking the order in between
+        if (c % 2 == 0)
+        {
+            key[1] = (char)c;
+            ok = ok && artDelete(t, key) == 1;
+        }
+    }
+    size_t count = 0;
+    ok = ok && artRange(t, "k", NULL, countVisit, &count) == 128;
+    for (int c = 1; c <= 255; c += 2)
+    {
+        key[1] = (char)c;
+        const char *s = artSuccessor(t, key);
+        ok = ok && (c == 255 ? s == NULL : s != NULL && (unsigned char)s[1] == c + 2);
+        ok = ok && artDelete(t, key) == 1;
+    }
+    printf("%d\n", ok);                    // 1
+    printf("%s\n", artMaximum(t));          // j
+    printf("%u\n", (unsigned)artSize(t));   // 1
+    artFree(t);
+    printf("FANOUT TEST DONE.\n");
+}
+
+void memoryTest(void)
+{
+    // the same URLs in the tree and in BST nodes (trees.h) with their keys inline, rounded up to 16 bytes
+    ArtTree *t = artCreate();
+    char key[64];
+    size_t bstBytes = 0;
+    for (int i = 0; i < LARGE_KEYS; i++)
+    {
+        sprintf(key, "https://example.com/catalog/item/%d", i);
+        artInsert(t, key);
+        bstBytes += sizeof(struct bstNode) + (strlen(key) + 1 + 15) / 16 * 16;
+    }
+    printf("%d\n", artMemory(t) < bstBytes); // 1
+    artFree(t);
+    printf("MEMORY TEST DONE.\n");
+}
+
+void makeKey(char *buffer, int i)
+{
+    // numbers split into path components, so keys share prefixes of every length
+    sprintf(buffer, "key/%02d/%02d/%d", i / 1000, i / 10 % 100, i);
+}
+
+void printVisit(const char *key, void *arg)
+{
+    (void)arg;
+    printf("%s ", key);
+}
+
+void countVisit(const char *key, void *arg)
+{
+    (void)key;
+    (*(size_t *)arg)++;
+}
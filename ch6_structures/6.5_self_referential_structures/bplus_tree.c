@@ -0,0 +1,727 @@
+/*
+    Contains implementation of the B+-tree declared in bplus_tree.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    Every node is a single nodeBytes allocation. A leaf holds up to leafCap keys, an internal node up to
+    innerCap keys (separators) and one more child than keys. Both have room for one extra key (and child), so
+    an insertion is always done in place first and an overfull node is then split in two.
+
+    Separator i of an internal node is <= every key under child i + 1 and > every key under child i, so a
+    search follows the child at the position of the first separator larger than the key.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "bplus_tree.h" // needed for B+-tree operations
+#include <stdlib.h>     // needed for malloc(), free()
+#include <stddef.h>     // needed for size_t
+#include <string.h>     // needed for memcpy(), memmove()
+#include <stdio.h>      // needed for printf()
+
+// ***************************** CONSTANTS ***********************************************
+
+#define MIN_NODE_BYTES 256  // smallest allowed node size (4 cache lines)
+#define MAX_NODE_BYTES 4096 // largest allowed node size (a page), unless keys are too big to fit 4 per node
+#define MIN_NODE_KEYS 4     // fewest keys a node must be able to hold
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a node of the tree.
+
+    Fields:
+        prev (struct BPlusNode *) : previous leaf in key order (leaves only, NULL for the first leaf)
+        next (struct BPlusNode *) : next leaf in key order (leaves only, NULL for the last leaf)
+        isLeaf (int) : 1 for a leaf, 0 for an internal node
+        count (int) : number of keys in the node
+        data (char []) : a leaf's keys, or an internal node's children followed by its keys (flexible array
+            member, see leafKey(), children(), and innerKey())
+*/
+struct BPlusNode
+{
+    struct BPlusNode *prev;
+    struct BPlusNode *next;
+    int isLeaf;
+    int count;
+    char data[];
+};
+
+/*
+    Structure that represents a B+-tree.
+
+    Fields:
+        root (struct BPlusNode *) : root node (an empty leaf for an empty tree)
+        comp (int (*) (const void *, const void *)) : key comparison function
+        keySize (size_t) : size of every key
+        nodeBytes (size_t) : size of every node
+        leafCap (int) : maximum number of keys in a leaf
+        innerCap (int) : maximum number of keys in an internal node
+        height (size_t) : number of levels
+        count (size_t) : number of keys
+        up (char *) : keySize bytes for the separator passed up by a split
+*/
+struct BPlusTree
+{
+    struct BPlusNode *root;
+    int (*comp)(const void *, const void *);
+    size_t keySize;
+    size_t nodeBytes;
+    int leafCap;
+    int innerCap;
+    size_t height;
+    size_t count;
+    char *up;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Allocates an empty node.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree the node is for
+        isLeaf (int) : 1 for a leaf, 0 for an internal node
+
+    Output:
+        A pointer to the node, with no keys and NULL leaf links.
+
+    Runtime: O(1)
+*/
+static struct BPlusNode *createNode(const BPlusTree *t, int isLeaf);
+
+/*
+    Retrieve a node's children array (internal nodes only), and a pointer to its i-th key.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree the node is in
+        n (const struct BPlusNode *) : pointer to the node
+        i (int) : index of the key
+
+    Runtime: O(1)
+*/
+static struct BPlusNode **children(const struct BPlusNode *n);
+static char *nodeKey(const BPlusTree *t, const struct BPlusNode *n, int i);
+
+/*
+    Binary searches the keys of a node.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree the node is in
+        n (const struct BPlusNode *) : pointer to the node
+        key (const void *) : the key being searched for
+
+    Output:
+        lowerBound() : index of the first key >= key (count if there is none)
+        upperBound() : index of the first key > key (count if there is none), which is also the index of the
+            child of an internal node to search for key
+
+    Runtime: O(log(B))
+*/
+static int lowerBound(const BPlusTree *t, const struct BPlusNode *n, const void *key);
+static int upperBound(const BPlusTree *t, const struct BPlusNode *n, const void *key);
+
+/*
+    Finds the leaf where a key is or would be.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree
+        key (const void *) : the key
+
+    Output:
+        A pointer to the leaf.
+
+    Runtime: O(log(n))
+*/
+static struct BPlusNode *findLeaf(const BPlusTree *t, const void *key);
+
+/*
+    Inserts a key into the subtree rooted at a node.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree
+        n (struct BPlusNode *) : root of the subtree
+        key (const void *) : the key
+        right (struct BPlusNode **) : set to the new right sibling of n when n is split
+
+    Output:
+        0 if key was already in the subtree, 1 if it was inserted, and 2 if it was inserted and n had to be
+        split. In that case the separator for *right has been copied into t->up.
+
+    Runtime: O(B * log_B(n))
+*/
+static int insertInto(BPlusTree *t, struct BPlusNode *n, const void *key, struct BPlusNode **right);
+
+/*
+    Deletes a key from the subtree rooted at a node. Children left with too few keys are fixed on the way
+    back up, the node itself may be left with too few keys (for its parent to fix).
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree
+        n (struct BPlusNode *) : root of the subtree
+        key (const void *) : the key
+
+    Output:
+        1 if key was deleted, 0 if it was not in the subtree.
+
+    Runtime: O(B * log_B(n))
+*/
+static int deleteFrom(BPlusTree *t, struct BPlusNode *n, const void *key);
+
+/*
+    Gives a child of an internal node that has too few keys enough keys again, either by moving one key over
+    from a sibling that can spare one or by merging it with a sibling.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree
+        p (struct BPlusNode *) : the parent
+        i (int) : index of the child in p
+
+    Runtime: O(B)
+*/
+static void fixChild(BPlusTree *t, struct BPlusNode *p, int i);
+
+/*
+    Moves the last key of child i - 1 to child i (borrowFromLeft()), or the first key of child i + 1 to
+    child i (borrowFromRight()), of an internal node, updating the separator between them.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree
+        p (struct BPlusNode *) : the parent
+        i (int) : index of the child receiving the key
+
+    Runtime: O(B)
+*/
+static void borrowFromLeft(BPlusTree *t, struct BPlusNode *p, int i);
+static void borrowFromRight(BPlusTree *t, struct BPlusNode *p, int i);
+
+/*
+    Merges child s + 1 of an internal node into child s and removes separator s from the parent.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree
+        p (struct BPlusNode *) : the parent
+        s (int) : index of the left child
+
+    Runtime: O(B)
+*/
+static void merge(BPlusTree *t, struct BPlusNode *p, int s);
+
+/*
+    Frees a node and every node below it.
+
+    Parameters:
+        n (struct BPlusNode *) : the node
+
+    Runtime: O(# nodes in the subtree)
+*/
+static void freeNode(struct BPlusNode *n);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+BPlusTree *bptCreate(size_t keySize, int (*comp)(const void *, const void *), size_t nodeBytes)
+{
+    if (keySize == 0)
+    {
+        return NULL;
+    }
+    if (nodeBytes < MIN_NODE_BYTES)
+    {
+        nodeBytes = MIN_NODE_BYTES;
+    }
+    if (nodeBytes > MAX_NODE_BYTES)
+    {
+        nodeBytes = MAX_NODE_BYTES;
+    }
+
+    // one key (and child) of each node is the spare slot used before a split
+    size_t ptr = sizeof(struct BPlusNode *);
+    size_t avail = nodeBytes - sizeof(struct BPlusNode);
+    while ((avail - 2 * ptr) / (keySize + ptr) < MIN_NODE_KEYS + 1)
+    {
+        nodeBytes *= 2;
+        avail = nodeBytes - sizeof(struct BPlusNode);
+    }
+
+    BPlusTree *t = (BPlusTree *)malloc(sizeof(BPlusTree));
+    t->comp = comp;
+    t->keySize = keySize;
+    t->nodeBytes = nodeBytes;
+    t->leafCap = (int)(avail / keySize) - 1;
+    t->innerCap = (int)((avail - 2 * ptr) / (keySize + ptr)) - 1;
+    t->height = 1;
+    t->count = 0;
+    t->up = (char *)malloc(keySize);
+    t->root = createNode(t, 1);
+    return t;
+}
+
+const void *bptSearch(const BPlusTree *t, const void *key)
+{
+    struct BPlusNode *leaf = findLeaf(t, key);
+    int i = lowerBound(t, leaf, key);
+    if (i < leaf->count && (*t->comp)(nodeKey(t, leaf, i), key) == 0)
+    {
+        return nodeKey(t, leaf, i);
+    }
+    return NULL;
+}
+
+const void *bptMinimum(const BPlusTree *t)
+{
+    struct BPlusNode *n = t->root;
+    while (!n->isLeaf)
+    {
+        n = children(n)[0];
+    }
+    return n->count > 0 ? nodeKey(t, n, 0) : NULL;
+}
+
+const void *bptMaximum(const BPlusTree *t)
+{
+    struct BPlusNode *n = t->root;
+    while (!n->isLeaf)
+    {
+        n = children(n)[n->count];
+    }
+    return n->count > 0 ? nodeKey(t, n, n->count - 1) : NULL;
+}
+
+const void *bptPredecessor(const BPlusTree *t, const void *key)
+{
+    // only the root can be an empty leaf, so the previous leaf always has a last key
+    struct BPlusNode *leaf = findLeaf(t, key);
+    int i = lowerBound(t, leaf, key);
+    if (i > 0)
+    {
+        return nodeKey(t, leaf, i - 1);
+    }
+    return leaf->prev != NULL ? nodeKey(t, leaf->prev, leaf->prev->count - 1) : NULL;
+}
+
+const void *bptSuccessor(const BPlusTree *t, const void *key)
+{
+    struct BPlusNode *leaf = findLeaf(t, key);
+    int i = upperBound(t, leaf, key);
+    if (i < leaf->count)
+    {
+        return nodeKey(t, leaf, i);
+    }
+    return leaf->next != NULL ? nodeKey(t, leaf->next, 0) : NULL;
+}
+
+int bptInsert(BPlusTree *t, const void *key)
+{
+    struct BPlusNode *right = NULL;
+    int res = insertInto(t, t->root, key, &right);
+    if (res == 0)
+    {
+        return 0;
+    }
+
+    // root was split, the tree grows a level
+    if (res == 2)
+    {
+        struct BPlusNode *newRoot = createNode(t, 0);
+        children(newRoot)[0] = t->root;
+        children(newRoot)[1] = right;
+        memcpy(nodeKey(t, newRoot, 0), t->up, t->keySize);
+        newRoot->count = 1;
+        t->root = newRoot;
+        t->height++;
+    }
+    t->count++;
+    return 1;
+}
+
+int bptDelete(BPlusTree *t, const void *key)
+{
+    if (!deleteFrom(t, t->root, key))
+    {
+        return 0;
+    }
+
+    // root is allowed to have too few keys, except an internal root without separators has a single child
+    // which takes its place
+    if (!t->root->isLeaf && t->root->count == 0)
+    {
+        struct BPlusNode *old = t->root;
+        t->root = children(old)[0];
+        free((void *)old);
+        t->height--;
+    }
+    t->count--;
+    return 1;
+}
+
+size_t bptRange(const BPlusTree *t, const void *low, const void *high, void (*visit)(const void *, void *), void *arg)
+{
+    // find the first key in the range, then walk the leaf links
+    struct BPlusNode *leaf = NULL;
+    int i = 0;
+    if (low != NULL)
+    {
+        leaf = findLeaf(t, low);
+        i = lowerBound(t, leaf, low);
+    }
+    else
+    {
+        leaf = t->root;
+        while (!leaf->isLeaf)
+        {
+            leaf = children(leaf)[0];
+        }
+    }
+
+    size_t visited = 0;
+    while (leaf != NULL)
+    {
+        for (; i < leaf->count; i++)
+        {
+            if (high != NULL && (*t->comp)(nodeKey(t, leaf, i), high) > 0)
+            {
+                return visited;
+            }
+            (*visit)(nodeKey(t, leaf, i), arg);
+            visited++;
+        }
+        leaf = leaf->next;
+        i = 0;
+    }
+    return visited;
+}
+
+size_t bptSize(const BPlusTree *t)
+{
+    return t->count;
+}
+
+size_t bptHeight(const BPlusTree *t)
+{
+    return t->height;
+}
+
+void bptPrint(const BPlusTree *t, const char *(*toString)(const void *))
+{
+    struct BPlusNode *leaf = t->root;
+    while (!leaf->isLeaf)
+    {
+        leaf = children(leaf)[0];
+    }
+    for (; leaf != NULL; leaf = leaf->next)
+    {
+        for (int i = 0; i < leaf->count; i++)
+        {
+            printf("%s\n", (*toString)(nodeKey(t, leaf, i)));
+        }
+    }
+}
+
+void bptFree(BPlusTree *t)
+{
+    freeNode(t->root);
+    t->root = NULL;
+    free((void *)t->up);
+    t->up = NULL;
+    free((void *)t);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static struct BPlusNode *createNode(const BPlusTree *t, int isLeaf)
+{
+    struct BPlusNode *n = (struct BPlusNode *)malloc(t->nodeBytes);
+    n->prev = NULL;
+    n->next = NULL;
+    n->isLeaf = isLeaf;
+    n->count = 0;
+    return n;
+}
+
+static struct BPlusNode **children(const struct BPlusNode *n)
+{
+    return (struct BPlusNode **)n->data;
+}
+
+static char *nodeKey(const BPlusTree *t, const struct BPlusNode *n, int i)
+{
+    // internal node keys come after the innerCap + 2 children
+    size_t offset = n->isLeaf ? 0 : (size_t)(t->innerCap + 2) * sizeof(struct BPlusNode *);
+    return (char *)n->data + offset + (size_t)i * t->keySize;
+}
+
+static int lowerBound(const BPlusTree *t, const struct BPlusNode *n, const void *key)
+{
+    int lo = 0;
+    int hi = n->count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if ((*t->comp)(nodeKey(t, n, mid), key) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int upperBound(const BPlusTree *t, const struct BPlusNode *n, const void *key)
+{
+    int lo = 0;
+    int hi = n->count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if ((*t->comp)(nodeKey(t, n, mid), key) <= 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static struct BPlusNode *findLeaf(const BPlusTree *t, const void *key)
+{
+    struct BPlusNode *n = t->root;
+    while (!n->isLeaf)
+    {
+        n = children(n)[upperBound(t, n, key)];
+    }
+    return n;
+}
+
+static int insertInto(BPlusTree *t, struct BPlusNode *n, const void *key, struct BPlusNode **right)
+{
+    size_t ks = t->keySize;
+    if (n->isLeaf)
+    {
+        int pos = lowerBound(t, n, key);
+        if (pos < n->count && (*t->comp)(nodeKey(t, n, pos), key) == 0)
+        {
+            return 0;
+        }
+        // spare slot guarantees room for one more key
+        memmove(nodeKey(t, n, pos + 1), nodeKey(t, n, pos), (size_t)(n->count - pos) * ks);
+        memcpy(nodeKey(t, n, pos), key, ks);
+        n->count++;
+        if (n->count <= t->leafCap)
+        {
+            return 1;
+        }
+
+        // overfull, the upper half of the keys moves to a new leaf linked in after n
+        struct BPlusNode *r = createNode(t, 1);
+        r->count = n->count / 2;
+        n->count -= r->count;
+        memcpy(nodeKey(t, r, 0), nodeKey(t, n, n->count), (size_t)r->count * ks);
+        r->next = n->next;
+        if (r->next != NULL)
+        {
+            r->next->prev = r;
+        }
+        r->prev = n;
+        n->next = r;
+
+        // leaf keys are all kept, the first key of r is copied up as its separator
+        memcpy(t->up, nodeKey(t, r, 0), ks);
+        *right = r;
+        return 2;
+    }
+
+    int i = upperBound(t, n, key);
+    struct BPlusNode *childRight = NULL;
+    int res = insertInto(t, children(n)[i], key, &childRight);
+    if (res != 2)
+    {
+        return res;
+    }
+
+    // child i was split, add its separator as key i and its new sibling as child i + 1
+    struct BPlusNode **c = children(n);
+    memmove(nodeKey(t, n, i + 1), nodeKey(t, n, i), (size_t)(n->count - i) * ks);
+    memcpy(nodeKey(t, n, i), t->up, ks);
+    memmove(c + i + 2, c + i + 1, (size_t)(n->count - i) * sizeof(struct BPlusNode *));
+    c[i + 1] = childRight;
+    n->count++;
+    if (n->count <= t->innerCap)
+    {
+        return 1;
+    }
+
+    // overfull, the middle key moves up and the keys (and children) after it move to a new node
+    struct BPlusNode *r = createNode(t, 0);
+    int mid = n->count / 2;
+    r->count = n->count - mid - 1;
+    memcpy(nodeKey(t, r, 0), nodeKey(t, n, mid + 1), (size_t)r->count * ks);
+    memcpy(children(r), c + mid + 1, (size_t)(r->count + 1) * sizeof(struct BPlusNode *));
+    memcpy(t->up, nodeKey(t, n, mid), ks);
+    n->count = mid;
+    *right = r;
+    return 2;
+}
+
+static int deleteFrom(BPlusTree *t, struct BPlusNode *n, const void *key)
+{
+    if (n->isLeaf)
+    {
+        int pos = lowerBound(t, n, key);
+        if (pos == n->count || (*t->comp)(nodeKey(t, n, pos), key) != 0)
+        {
+            return 0;
+        }
+        n->count--;
+        memmove(nodeKey(t, n, pos), nodeKey(t, n, pos + 1), (size_t)(n->count - pos) * t->keySize);
+        return 1;
+    }
+
+    // separators equal to a deleted key are left alone, they still separate the children correctly
+    int i = upperBound(t, n, key);
+    struct BPlusNode *child = children(n)[i];
+    if (!deleteFrom(t, child, key))
+    {
+        return 0;
+    }
+    if (child->count < (child->isLeaf ? t->leafCap : t->innerCap) / 2)
+    {
+        fixChild(t, n, i);
+    }
+    return 1;
+}
+
+static void fixChild(BPlusTree *t, struct BPlusNode *p, int i)
+{
+    struct BPlusNode **c = children(p);
+    int min = (c[i]->isLeaf ? t->leafCap : t->innerCap) / 2;
+
+    // prefer borrowing, which doesn't change the parent's number of keys
+    if (i > 0 && c[i - 1]->count > min)
+    {
+        borrowFromLeft(t, p, i);
+    }
+    else if (i < p->count && c[i + 1]->count > min)
+    {
+        borrowFromRight(t, p, i);
+    }
+    // neither sibling can spare a key, so the child and a sibling fit in one node together
+    else if (i > 0)
+    {
+        merge(t, p, i - 1);
+    }
+    else
+    {
+        merge(t, p, i);
+    }
+}
+
+static void borrowFromLeft(BPlusTree *t, struct BPlusNode *p, int i)
+{
+    size_t ks = t->keySize;
+    struct BPlusNode *n = children(p)[i];
+    struct BPlusNode *l = children(p)[i - 1];
+    memmove(nodeKey(t, n, 1), nodeKey(t, n, 0), (size_t)n->count * ks);
+    if (n->isLeaf)
+    {
+        // last key of l moves over and becomes the new separator
+        memcpy(nodeKey(t, n, 0), nodeKey(t, l, l->count - 1), ks);
+        memcpy(nodeKey(t, p, i - 1), nodeKey(t, n, 0), ks);
+    }
+    else
+    {
+        // separator moves down into n, last key of l moves up to replace it, and the last child of l follows
+        struct BPlusNode **nc = children(n);
+        memmove(nc + 1, nc, (size_t)(n->count + 1) * sizeof(struct BPlusNode *));
+        nc[0] = children(l)[l->count];
+        memcpy(nodeKey(t, n, 0), nodeKey(t, p, i - 1), ks);
+        memcpy(nodeKey(t, p, i - 1), nodeKey(t, l, l->count - 1), ks);
+    }
+    l->count--;
+    n->count++;
+}
+
+static void borrowFromRight(BPlusTree *t, struct BPlusNode *p, int i)
+{
+    size_t ks = t->keySize;
+    struct BPlusNode *n = children(p)[i];
+    struct BPlusNode *r = children(p)[i + 1];
+    if (n->isLeaf)
+    {
+        // first key of r moves over, and the next key of r becomes the new separator
+        memcpy(nodeKey(t, n, n->count), nodeKey(t, r, 0), ks);
+        memmove(nodeKey(t, r, 0), nodeKey(t, r, 1), (size_t)(r->count - 1) * ks);
+        memcpy(nodeKey(t, p, i), nodeKey(t, r, 0), ks);
+    }
+    else
+    {
+        // separator moves down into n, first key of r moves up to replace it, and the first child of r follows
+        struct BPlusNode **rc = children(r);
+        memcpy(nodeKey(t, n, n->count), nodeKey(t, p, i), ks);
+        children(n)[n->count + 1] = rc[0];
+        memcpy(nodeKey(t, p, i), nodeKey(t, r, 0), ks);
+        memmove(nodeKey(t, r, 0), nodeKey(t, r, 1), (size_t)(r->count - 1) * ks);
+        memmove(rc, rc + 1, (size_t)r->count * sizeof(struct BPlusNode *));
+    }
+    r->count--;
+    n->count++;
+}
+
+static void merge(BPlusTree *t, struct BPlusNode *p, int s)
+{
+    size_t ks = t->keySize;
+    struct BPlusNode **pc = children(p);
+    struct BPlusNode *l = pc[s];
+    struct BPlusNode *r = pc[s + 1];
+    if (l->isLeaf)
+    {
+        memcpy(nodeKey(t, l, l->count), nodeKey(t, r, 0), (size_t)r->count * ks);
+        l->count += r->count;
+        l->next = r->next;
+        if (l->next != NULL)
+        {
+            l->next->prev = l;
+        }
+    }
+    else
+    {
+        // separator comes down between the keys of l and r
+        memcpy(nodeKey(t, l, l->count), nodeKey(t, p, s), ks);
+        memcpy(nodeKey(t, l, l->count + 1), nodeKey(t, r, 0), (size_t)r->count * ks);
+        memcpy(children(l) + l->count + 1, children(r), (size_t)(r->count + 1) * sizeof(struct BPlusNode *));
+        l->count += r->count + 1;
+    }
+    free((void *)r);
+
+    // remove separator s and child s + 1 from the parent
+    memmove(nodeKey(t, p, s), nodeKey(t, p, s + 1), (size_t)(p->count - s - 1) * ks);
+    memmove(pc + s + 1, pc + s + 2, (size_t)(p->count - s - 1) * sizeof(struct BPlusNode *));
+    p->count--;
+}
+
+static void freeNode(struct BPlusNode *n)
+{
+    // height is O(log_B(n)), so recursion depth is small
+    if (!n->isLeaf)
+    {
+        for (int i = 0; i <= n->count; i++)
+        {
+            freeNode(children(n)[i]);
+        }
+    }
+    free((void *)n);
+}
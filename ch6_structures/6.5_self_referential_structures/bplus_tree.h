@@ -0,0 +1,191 @@
+/*
+    Contains declarations of a B+-tree for fixed size generic keys. It supports the same ordered set operations
+    as the BST in trees.h (search, minimum, maximum, predecessor, successor, insertion, deletion, printing), but
+    each node holds an array of keys that fills a few cache lines, instead of a single key. A lookup then visits
+    about log_B(n) nodes rather than log_2(n), e.g. 3 or 4 nodes instead of about 24 for 16 million keys, and
+    the keys inside a node are read sequentially.
+
+    Every key is stored in a leaf, and the leaves are linked in order so that range scans, predecessors and
+    successors step from leaf to leaf without going back up the tree.
+
+    For runtime calculations of the declared operations, they are done with respect to the number of keys (n)
+    in the tree and the number of keys that fit in a node (B). Operations regarding key data such as comparison
+    and string conversion are considered to be O(1).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the BPlusTree. It is implemented via a structure that holds the root node and the
+    parameters supplied to bptCreate().
+*/
+typedef struct BPlusTree BPlusTree;
+
+/*
+    Creates an empty BPlusTree.
+
+    Parameters:
+        keySize (size_t) : size in bytes of every key. Keys are copied into the nodes byte for byte (memcpy()),
+            so they must not contain pointers to data the tree should own.
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on keys
+        nodeBytes (size_t) : size in bytes of a node. It is clamped to [256, 4096] and then grown if needed so
+            that a node holds at least 4 keys.
+
+    Output:
+        A pointer to the created BPlusTree, or NULL if keySize is 0.
+
+    Runtime: O(1)
+*/
+BPlusTree *bptCreate(size_t keySize, int (*comp)(const void *, const void *), size_t nodeBytes);
+
+/*
+    Searches a provided tree for a provided key.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree to search (not modified)
+        key (const void *) : pointer to the key being searched for (not modified)
+
+    Output:
+        A pointer to the tree's copy of key if it is in the tree, NULL otherwise. As with every pointer into the
+        tree returned below, it is only valid until the tree is next modified (keys move between nodes).
+
+    Runtime: O(log(n))
+*/
+const void *bptSearch(const BPlusTree *t, const void *key);
+
+/*
+    Retrieve the tree's copy of the minimum and maximum keys of a provided tree.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree (not modified)
+
+    Output:
+        A pointer to the minimum (maximum) key, or NULL if the tree is empty.
+
+    Runtime: O(log_B(n))
+*/
+const void *bptMinimum(const BPlusTree *t);
+const void *bptMaximum(const BPlusTree *t);
+
+/*
+    Retrieve the tree's copy of the largest key smaller (smallest key larger) than a provided key. As with
+    bstPredecessor() and bstSuccessor(), key does not need to be in the tree.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree (not modified)
+        key (const void *) : pointer to the key (not modified)
+
+    Output:
+        A pointer to the predecessor (successor), or NULL if there is none.
+
+    Runtime: O(log(n))
+*/
+const void *bptPredecessor(const BPlusTree *t, const void *key);
+const void *bptSuccessor(const BPlusTree *t, const void *key);
+
+/*
+    Inserts a copy of a provided key into a provided tree.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree to insert into
+        key (const void *) : pointer to the key to insert (keySize bytes are copied)
+
+    Output:
+        1 if key was inserted, 0 if it was already in the tree (the tree is unchanged).
+
+    Runtime: O(B * log_B(n))    (shifting keys inside a node is a memmove())
+
+        NOTE: memory allocation is assumed to be independent
+*/
+int bptInsert(BPlusTree *t, const void *key);
+
+/*
+    Deletes a provided key from a provided tree.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree to delete from
+        key (const void *) : pointer to the key to delete (not modified)
+
+    Output:
+        1 if key was deleted, 0 if it was not in the tree (the tree is unchanged).
+
+    Runtime: O(B * log_B(n))
+*/
+int bptDelete(BPlusTree *t, const void *key);
+
+/*
+    Visits the keys of a provided tree in a range, in order.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree (not modified)
+        low (const void *) : pointer to the smallest key to visit, or NULL to start at the minimum
+        high (const void *) : pointer to the largest key to visit, or NULL to stop at the maximum
+        visit (void (*) (const void *, void *)) : function called with each key and arg. It must not modify the
+            tree.
+        arg (void *) : passed to every call of visit (may be NULL)
+
+    Output:
+        The number of keys visited.
+
+    Runtime: O(log(n) + k)    k = # keys in the range
+*/
+size_t bptRange(const BPlusTree *t, const void *low, const void *high, void (*visit)(const void *, void *), void *arg);
+
+/*
+    Retrieves the number of keys in a provided tree.
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree (not modified)
+
+    Output:
+        The number of keys in the tree.
+
+    Runtime: O(1)
+*/
+size_t bptSize(const BPlusTree *t);
+
+/*
+    Retrieves the height of a provided tree (1 for a tree whose root is a leaf, including the empty tree).
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree (not modified)
+
+    Output:
+        The number of nodes on every path from the root to a leaf.
+
+    Runtime: O(1)
+*/
+size_t bptHeight(const BPlusTree *t);
+
+/*
+    Prints the keys of a provided tree in order, one per line, like bstPrint().
+
+    Parameters:
+        t (const BPlusTree *) : pointer to the tree to print (not modified)
+        toString (const char * (*) (const void *)) : pointer to a function that converts a key into a string
+
+    Runtime: O(n)
+*/
+void bptPrint(const BPlusTree *t, const char *(*toString)(const void *));
+
+/*
+    De-allocates the memory allocated to a provided tree.
+
+    Parameters:
+        t (BPlusTree *) : pointer to the tree to free
+
+    Output:
+        The tree and all of its nodes are freed. The calling function should set t to NULL afterwards to avoid
+        undefined behavior.
+
+    Runtime: O(n / B)
+*/
+void bptFree(BPlusTree *t);
+
+#endif
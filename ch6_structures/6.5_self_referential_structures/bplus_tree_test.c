@@ -0,0 +1,191 @@
+#include "bplus_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+BPlusTree *t = NULL;
+
+int intCmp(const void *a, const void *b);
+const char *intToString(const void *i);
+const char *strToString(const void *s);
+void sumVisit(const void *key, void *arg);
+void shuffle(int *a, int n);
+void smallTest(void);
+void largeTest(void);
+void stringTest(void);
+
+int main()
+{
+    smallTest();
+    largeTest();
+    stringTest();
+    return 0;
+}
+
+void smallTest(void)
+{
+    printf("%p\n", (void *)bptCreate(0, intCmp, 256)); // (nil)
+
+    t = bptCreate(sizeof(int), intCmp, 256);
+    printf("%p\n", bptMinimum(t));                  // (nil)
+    printf("%p\n", bptSuccessor(t, &(int){1}));     // (nil)
+    printf("%d\n", bptDelete(t, &(int){1}));        // 0
+
+    int keys[] = {50, 20, 80, 10, 30, 70, 90};
+    for (int i = 0; i < 7; i++)
+    {
+        bptInsert(t, &keys[i]);
+    }
+    printf("%d\n", bptInsert(t, &keys[0]));                  // 0
+    printf("%u\n", (unsigned)bptSize(t));                    // 7
+    printf("%d\n", *(const int *)bptSearch(t, &keys[4]));    // 30
+    printf("%p\n", bptSearch(t, &(int){40}));               // (nil)
+    printf("%d\n", *(const int *)bptMinimum(t));             // 10
+    printf("%d\n", *(const int *)bptMaximum(t));             // 90
+    printf("%d\n", *(const int *)bptPredecessor(t, &(int){50})); // 30
+    printf("%d\n", *(const int *)bptPredecessor(t, &(int){55})); // 50
+    printf("%d\n", *(const int *)bptSuccessor(t, &(int){50}));   // 70
+    printf("%p\n", bptSuccessor(t, &(int){90}));            // (nil)
+    printf("%p\n", bptPredecessor(t, &(int){10}));          // (nil)
+    bptPrint(t, intToString);                                // 10 20 30 50 70 80 90
+
+    printf("%d\n", bptDelete(t, &keys[0])); // 1
+    printf("%d\n", bptDelete(t, &keys[0])); // 0
+    printf("%u\n", (unsigned)bptSize(t));   // 6
+
+    bptFree(t);
+    t = NULL;
+    printf("SMALL TEST DONE.\n");
+}
+
+void largeTest(void)
+{
+    // small nodes so the tree has several levels
+    t = bptCreate(sizeof(int), intCmp, 256);
+    int n = 200000;
+    int *keys = (int *)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++)
+    {
+        keys[i] = 2 * i;
+    }
+    shuffle(keys, n);
+    for (int i = 0; i < n; i++)
+    {
+        bptInsert(t, &keys[i]);
+    }
+    printf("%u\n", (unsigned)bptSize(t));                           // 200000
+    printf("%d\n", bptHeight(t) >= 3 && bptHeight(t) <= 5);         // 1
+
+    int found = 1;
+    for (int i = 0; i < n; i++)
+    {
+        int odd = 2 * i + 1;
+        found = found && bptSearch(t, &keys[i]) != NULL && bptSearch(t, &odd) == NULL;
+        found = found && (i == n - 1 || *(const int *)bptSuccessor(t, &odd) == odd + 1);
+        found = found && *(const int *)bptPredecessor(t, &odd) == odd - 1;
+    }
+    printf("%d\n", found); // 1
+
+    // keys in [1000, 2000] are 1000, 1002, ..., 2000
+    long sum = 0;
+    printf("%u\n", (unsigned)bptRange(t, &(int){1000}, &(int){2000}, sumVisit, &sum)); // 501
+    printf("%ld\n", sum);                                                          // 751500
+    printf("%u\n", (unsigned)bptRange(t, NULL, NULL, sumVisit, &sum));             // 200000
+
+    // delete three quarters of the keys in another random order, forcing borrows and merges
+    shuffle(keys, n);
+    for (int i = 0; i < 3 * n / 4; i++)
+    {
+        bptDelete(t, &keys[i]);
+    }
+    found = bptSize(t) == (size_t)(n / 4);
+    for (int i = 0; i < n; i++)
+    {
+        found = found && (bptSearch(t, &keys[i]) != NULL) == (i >= 3 * n / 4);
+    }
+    printf("%d\n", found); // 1
+
+    // in order traversal is still sorted
+    int prev = -1;
+    int sorted = 1;
+    const void *k = bptMinimum(t);
+    while (k != NULL)
+    {
+        sorted = sorted && *(const int *)k > prev;
+        prev = *(const int *)k;
+        k = bptSuccessor(t, k);
+    }
+    printf("%d\n", sorted); // 1
+
+    // empty the tree, it shrinks back to a single leaf
+    for (int i = 3 * n / 4; i < n; i++)
+    {
+        bptDelete(t, &keys[i]);
+    }
+    printf("%u\n", (unsigned)bptSize(t));   // 0
+    printf("%u\n", (unsigned)bptHeight(t)); // 1
+    printf("%p\n", bptMaximum(t));          // (nil)
+
+    free(keys);
+    bptFree(t);
+    t = NULL;
+    printf("LARGE TEST DONE.\n");
+}
+
+void stringTest(void)
+{
+    // fixed size string keys, a node size too small for 4 of them is grown (to 2048 bytes, 9 keys per leaf)
+    t = bptCreate(200, (int (*)(const void *, const void *))strcmp, 256);
+    char key[200] = {0};
+    const char *words[] = {"pear", "apple", "fig", "kiwi", "banana", "cherry", "grape", "lime"};
+    for (int i = 0; i < 8; i++)
+    {
+        strcpy(key, words[i]);
+        bptInsert(t, key);
+    }
+    printf("%u\n", (unsigned)bptHeight(t)); // 1
+    printf("%s\n", (const char *)bptSuccessor(t, "fig"));   // grape
+    printf("%s\n", (const char *)bptPredecessor(t, "fig")); // cherry
+    bptPrint(t, strToString); // apple banana cherry fig grape kiwi lime pear
+    bptFree(t);
+    t = NULL;
+    printf("STRING TEST DONE.\n");
+}
+
+int intCmp(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+const char *intToString(const void *i)
+{
+    static char buf[16];
+    sprintf(buf, "%d", *(const int *)i);
+    return buf;
+}
+
+const char *strToString(const void *s)
+{
+    return (const char *)s;
+}
+
+void sumVisit(const void *key, void *arg)
+{
+    *(long *)arg += *(const int *)key;
+}
+
+void shuffle(int *a, int n)
+{
+    // fixed seed so the output is the same every run
+    srand(35);
+    for (int i = n - 1; i > 0; i--)
+    {
+        int j = rand() % (i + 1);
+        int tmp = a[i];
+        a[i] = a[j];
+        a[j] = tmp;
+    }
+}
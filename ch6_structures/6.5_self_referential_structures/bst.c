@@ -4,9 +4,11 @@
 
     File format :
         1.  Necessary headers
-        2.  Private (static) helper function declarations 
-        3.  Public header function definitions 
-        4.  Private (static) helper function definitions 
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations 
+        5.  Public header function definitions 
+        6.  Private (static) helper function definitions 
 
     For runtime calculations of the declarad operations, they are done with respect to the number of nodes (n)
     in the BST. Operations regarding node data such as copying, size, comparison, and string conversion are
@@ -20,18 +22,172 @@
 #include <stddef.h> // needed for size_t
 #include <stdlib.h> // needed for malloc(), free()
 #include <stdio.h>  // needed for printf()
+#include <string.h> // needed for memcpy()
+#ifdef BST_THREADS
+#include <pthread.h> // needed for pthread_create(), pthread_join() in the parallel set operations
+#endif
+
+// ***************************** CONSTANTS ***********************************************
+
+#define ARENA_BLOCK_SIZE 65536 // bytes per arena block (a node larger than this gets a block of its own)
+#define NODE_ALIGNMENT 16      // alignment of nodes, and of the keys stored right after them
+#define PATH_STACK_SIZE 64     // nodes of a search path kept on the call stack before a bstPath moves to the heap
+#define PREFETCH_AHEAD 8       // frozen search prefetches the key pointers this many positions (3 levels) ahead
+#define PARALLEL_GRAIN 8192    // fewest nodes in each half of a set operation for it to get its own thread
+
+// the set operations fork at most this many levels deep when compiled with BST_THREADS (up to 2^depth threads)
+#ifndef BST_FORK_DEPTH
+#define BST_FORK_DEPTH 3
+#endif
+
+// set operations run by setOperation()
+#define SET_UNION 0
+#define SET_INTERSECTION 1
+#define SET_DIFFERENCE 2
+
+// software prefetch where the compiler supports it, otherwise nothing
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address)
+#endif
+
+// bytes rounded up to a multiple of NODE_ALIGNMENT
+#define ALIGN_UP(bytes) (((bytes) + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT)
+
+// offset of a node's value (or its key, if it has no value) from the start of the node, and of the first node
+// from the start of an arena block
+#define KEY_OFFSET ALIGN_UP(sizeof(struct bstNode))
+#define BLOCK_HEADER_SIZE ALIGN_UP(sizeof(struct bstArenaBlock))
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a block of a bstArena. Nodes are carved out of the block one after another, starting
+    BLOCK_HEADER_SIZE bytes from its start.
+
+    Fields:
+        next (struct bstArenaBlock *) : pointer to the previously filled block (blocks form a SLL)
+        used (size_t) : number of node bytes in use
+        capacity (size_t) : number of node bytes the block holds
+*/
+struct bstArenaBlock
+{
+    struct bstArenaBlock *next;
+    size_t used;
+    size_t capacity;
+};
+
+/*
+    Structure that represents a node arena (declared in trees.h).
+
+    Fields:
+        blocks (struct bstArenaBlock *) : most recent block (head of the SLL of blocks)
+*/
+struct bstArena
+{
+    struct bstArenaBlock *blocks;
+};
+
+/*
+    Structure for the nodes visited by a search, so that their sizes can be updated once the outcome of an 
+    insertion or deletion is known without comparing keys again. 
+
+    Fields:
+        nodes (struct bstNode **) : the visited nodes from the root down (local, or a heap array for long paths)
+        length (size_t) : number of nodes
+        capacity (size_t) : length of the nodes array
+        local (struct bstNode *[]) : storage used for paths of up to PATH_STACK_SIZE nodes
+*/
+struct bstPath
+{
+    struct bstNode **nodes;
+    size_t length;
+    size_t capacity;
+    struct bstNode *local[PATH_STACK_SIZE];
+};
+
+/*
+    Structure that represents a range cursor (declared in trees.h). 
+
+    Fields:
+        stack (struct bstPath) : nodes with keys >= the low bound that have not been returned yet, and whose 
+            right subtrees have not been visited. The top is the next node in order.
+        high (const void *) : the high bound, or NULL for none
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the tree
+*/
+struct bstCursor
+{
+    struct bstPath stack;
+    const void *high;
+    int (*comp)(const void *, const void *);
+};
+
+/*
+    Structure that represents a frozen snapshot of a BST (declared in trees.h). 
+
+    Fields:
+        keys (const void **) : pointers to the key copies in Eytzinger (breadth first) order, from index 1. The 
+            children of position k are at 2k and 2k + 1, so a search needs no child pointers. 
+        data (char *) : the key copies, in the same order as keys
+        n (size_t) : number of keys
+*/
+struct bstSnapshot
+{
+    const void **keys;
+    char *data;
+    size_t n;
+};
+
+/*
+    Structure that represents an insertion hint (declared in trees.h). 
+
+    Fields:
+        path (struct bstPath) : nodes from the root down to the node of the last key inserted or found through 
+            the hint (empty before the first insertion)
+*/
+struct bstHint
+{
+    struct bstPath path;
+};
+
+#ifdef BST_THREADS
+/*
+    Structure for a recursive set operation run on another thread. 
+
+    Fields:
+        op (int) : SET_UNION, SET_INTERSECTION, or SET_DIFFERENCE
+        a, b (struct bstNode *) : the trees to combine
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the trees
+        forks (int) : number of levels the operation may still fork
+        result (struct bstNode *) : root of the combined tree, set by the thread
+*/
+struct setTask
+{
+    int op;
+    struct bstNode *a;
+    struct bstNode *b;
+    int (*comp)(const void *, const void *);
+    int forks;
+    struct bstNode *result;
+};
+#endif
 
 // ***************************** PRIVATE HELPER FUNCTIONS DEFINITIONS ***************************************
 
 /*
-    Creates a new node containing a copy of the data referenced by a provided key. 
+    Creates a new node containing a copy of the data referenced by a provided key. The key is stored inline, 
+    directly after the node (at offset KEY_OFFSET), so a node and its key take a single allocation. A map node
+    also has room for a value (left uninitialized), which goes at KEY_OFFSET with the key after it. 
 
     Parameters: 
+        arena (struct bstArena *) : arena to allocate the node from, or NULL to allocate it with malloc()
         key (const void *) : pointer to key to add 
         copy (void (*) (void *, const void *)) : pointer to a function that copies a value referenced by a const source 
             pointer (2nd param) to be referenced by a destination pointer (1st param)
         size (size_t (*) (const void *)) : pointer to a function that retrieves the allocation size (in bytes) of the 
             data referenced by a given const void pointer. 
+        valueSize (size_t) : size of the node's value, 0 for a node without one
 
     Output: 
         Assuming that copy and size have been implemented properly such that a new bstNode can be created 
@@ -44,7 +200,7 @@
 
     Runtime: O(1) 
 */
-static struct bstNode *createNewNode(const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *));
+static struct bstNode *createNewNode(struct bstArena *arena, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), size_t valueSize);
 
 /*
     Deletes a node from a BST that has 2 children. 
@@ -53,8 +209,6 @@ static struct bstNode *createNewNode(const void *key, void (*copy)(void *, const
         root (struct bstNode *) : pointer to the root of the BST to delete from 
         curr (struct bstNode *) : pointer to node to be deleted 
         prev (struct bstNode *) : pointer to curr's parent or NULL if curr is the root
-        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used in the
-            search / construction of the BST. 
 
     Output: 
         A pointer to the BST with curr removed from the tree is returned. For this particular implementation
@@ -63,7 +217,7 @@ static struct bstNode *createNewNode(const void *key, void (*copy)(void *, const
 
     Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
 */
-static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstNode *curr, struct bstNode *prev, int (*comp)(const void *, const void *));
+static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstNode *curr, struct bstNode *prev);
 
 /*
     Deletes a node from a BST that has only 1 child. 
@@ -72,15 +226,13 @@ static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstN
         root (struct bstNode *) : pointer to the root of the BST to delete from 
         curr (struct bstNode *) : pointer to node to be deleted 
         prev (struct bstNode *) : pointer to curr's parent or NULL if curr is the root
-        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used in the
-            search / construction of the BST. 
 
     Output: 
         A pointer to the BST with curr removed from the tree is returned.
 
     Runtime: O(1)
 */
-static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode *curr, struct bstNode *prev, int (*comp)(const void *, const void *));
+static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode *curr, struct bstNode *prev);
 
 /*
     Deletes a node from a BST that has only no children. 
@@ -89,20 +241,19 @@ static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode
         root (struct bstNode *) : pointer to the root of the BST to delete from 
         curr (struct bstNode *) : pointer to node to be deleted 
         prev (struct bstNode *) : pointer to curr's parent or NULL if curr is the root
-        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used in the
-            search / construction of the BST. 
 
     Output: 
         A pointer to the BST with curr removed from the tree is returned.
 
     Runtime: O(1)
 */
-static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, struct bstNode *prev, int (*comp)(const void *, const void *));
+static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, struct bstNode *prev);
 
 /*
     Frees the storage held by a provided bstNode and marks it as freed. 
 
     Parameters: 
+        arena (struct bstArena *) : arena the node was allocated from, or NULL if it was allocated with malloc()
         node (struct bstNode *) : pointer to bstNode to be freed 
 
     Output: 
@@ -114,11 +265,338 @@ static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, st
             calling function. 
             2.  Marking the children of the referenced bstNode as NULL can lead to dangling pointers if the referenced
             data is not freed previously. 
-            3.  However, the key data is freed which is allocated dynamically in bstInsert().
+            3.  However, the key data is freed which is allocated dynamically in bstInsert() (as part of the node).
+            4.  Nodes in an arena are only marked, their memory is reclaimed when the arena is freed.
 
     Runtime: O(1)   - memory de-allocation is independent
 */
-static void freeBstNode(struct bstNode *node);
+static void freeBstNode(struct bstArena *arena, struct bstNode *node);
+
+/*
+    Allocates memory from a provided arena. 
+
+    Parameters: 
+        arena (struct bstArena *) : arena to allocate from 
+        bytes (size_t) : number of bytes needed
+
+    Output: 
+        A pointer to bytes bytes of memory aligned to NODE_ALIGNMENT. The memory is only released by
+        bstArenaFree(). A new block is started when the current one cannot fit the request.
+
+    Runtime: O(1)   - memory allocation is independent
+*/
+static void *arenaAlloc(struct bstArena *arena, size_t bytes);
+
+/*
+    Shared implementation of bstInsertOrFind(), bstArenaInsert(), and bstUpsert(), nodes are allocated from 
+    arena (or with malloc() if arena is NULL) with room for a value of valueSize bytes. See bstInsertOrFind() 
+    for the other parameters and output. 
+*/
+static struct bstNode *insertOrFind(struct bstArena *arena, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), size_t valueSize, struct bstNode **node);
+
+/*
+    Shared implementation of bstDelete() and bstArenaDelete(), the deleted node is released to arena (or with 
+    free() if arena is NULL). See bstDelete() for the other parameters and output. 
+*/
+static struct bstNode *deleteKey(struct bstArena *arena, struct bstNode *root, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Retrieves the height of a possibly empty AVL subtree. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the subtree (may be NULL)
+
+    Output: 
+        0 if node is NULL, node->height otherwise.
+
+    Runtime: O(1)
+*/
+static int height(struct bstNode *node);
+
+/*
+    Retrieves the number of nodes of a possibly empty subtree. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the subtree (may be NULL)
+
+    Output: 
+        0 if node is NULL, node->size otherwise.
+
+    Runtime: O(1)
+*/
+static size_t subtreeSize(struct bstNode *node);
+
+/*
+    Recomputes the height and size of a node from those of its children. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the node to update (not NULL), whose children are up to date
+
+    Runtime: O(1)
+*/
+static void updateNode(struct bstNode *node);
+
+/*
+    Path operations: pathInit() makes an empty path, pathPush() appends a node (moving the path to the heap 
+    when it outgrows local), and pathFree() releases any heap storage. 
+
+    Parameters: 
+        path (struct bstPath *) : pointer to the path 
+        node (struct bstNode *) : node to append 
+
+    Runtime: O(1) amortized
+*/
+static void pathInit(struct bstPath *path);
+static void pathPush(struct bstPath *path, struct bstNode *node);
+static void pathFree(struct bstPath *path);
+
+/*
+    Rotates a subtree to the left, making the root's right child the new root of the subtree. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the subtree, which must have a right child
+
+    Output: 
+        A pointer to the new root of the subtree. The in order of the subtree is unchanged and the heights of
+        the 2 nodes that moved are updated.
+
+    Runtime: O(1)
+*/
+static struct bstNode *rotateLeft(struct bstNode *node);
+
+/*
+    Rotates a subtree to the right, making the root's left child the new root of the subtree. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the subtree, which must have a left child
+
+    Output: 
+        A pointer to the new root of the subtree. The in order of the subtree is unchanged and the heights of
+        the 2 nodes that moved are updated.
+
+    Runtime: O(1)
+*/
+static struct bstNode *rotateRight(struct bstNode *node);
+
+/*
+    Restores the AVL property at the root of a subtree whose children are balanced and whose children's 
+    heights differ by at most 2. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the subtree (not NULL)
+
+    Output: 
+        A pointer to the new root of the subtree, after 0, 1, or 2 rotations. Heights are updated.
+
+    Runtime: O(1)
+*/
+static struct bstNode *rebalance(struct bstNode *node);
+
+/*
+    Recursive helper of avlInsert() that inserts into the subtree rooted at a provided node. 
+
+    Parameters: 
+        arena (struct bstArena *) : arena to allocate from, or NULL to use malloc()
+        node (struct bstNode *) : pointer to the root of the subtree (may be NULL)
+        key, copy, size, comp : see avlInsert()
+
+    Output: 
+        A pointer to the new root of the balanced subtree.
+
+    Runtime: O(log(n))    n = # nodes in subtree
+*/
+static struct bstNode *avlInsertNode(struct bstArena *arena, struct bstNode *node, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+
+/*
+    Recursive helper of avlDelete() that deletes from the subtree rooted at a provided node. 
+
+    Parameters: 
+        arena (struct bstArena *) : arena the nodes were allocated from, or NULL if they came from malloc()
+        node (struct bstNode *) : pointer to the root of the subtree (may be NULL)
+        key, comp : see avlDelete()
+
+    Output: 
+        A pointer to the new root of the balanced subtree.
+
+    Runtime: O(log(n))    n = # nodes in subtree
+*/
+static struct bstNode *avlDeleteNode(struct bstArena *arena, struct bstNode *node, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Unlinks the minimum node from a non-empty AVL subtree without freeing it. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the subtree (not NULL)
+        min (struct bstNode **) : pointer to where the unlinked minimum node is stored
+
+    Output: 
+        A pointer to the new root of the balanced subtree without its minimum.
+
+    Runtime: O(log(n))    n = # nodes in subtree
+*/
+static struct bstNode *avlRemoveMinimum(struct bstNode *node, struct bstNode **min);
+
+/*
+    Recursive helper of bstBuildFromSorted() that builds a perfectly balanced BST from a range of sorted keys. 
+
+    Parameters: 
+        keys (const void *const *) : array of pointers to sorted, distinct keys
+        lo (size_t) : index of the first key of the range 
+        hi (size_t) : index after the last key of the range 
+        copy, size : see bstInsert()
+
+    Output: 
+        A pointer to the root of the built tree (NULL for an empty range), with heights set. 
+
+    Runtime: O(hi - lo)
+*/
+static struct bstNode *buildBalanced(const void *const *keys, size_t lo, size_t hi, void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Sorts an array of key pointers with a bottom up merge sort (stable, O(n) extra space). 
+
+    Parameters: 
+        keys (const void **) : array of pointers to keys, sorted in place 
+        n (size_t) : length of keys
+        comp : see bstInsert()
+
+    Runtime: O(n*log(n))
+*/
+static void sortKeys(const void **keys, size_t n, int (*comp)(const void *, const void *));
+
+/*
+    Performs count left rotations down the right spine of a vine (see bstRebalance()). 
+
+    Parameters: 
+        pseudoRoot (struct bstNode *) : node whose right child is the top of the vine
+        count (size_t) : number of rotations
+
+    Runtime: O(count)
+*/
+static void compressVine(struct bstNode *pseudoRoot, size_t count);
+
+/*
+    Recomputes the height and size fields of every node of a tree bottom up. 
+
+    Parameters: 
+        node (struct bstNode *) : pointer to the root of the tree (may be NULL)
+
+    Runtime: O(n), recursion depth is the height of the tree
+*/
+static void updateTree(struct bstNode *node);
+
+/*
+    Pushes a node and its chain of left descendants (its left spine) onto a path. 
+
+    Parameters: 
+        path (struct bstPath *) : pointer to the path 
+        node (struct bstNode *) : top of the spine (may be NULL)
+
+    Runtime: O(length of the spine)
+*/
+static void pushLeftSpine(struct bstPath *path, struct bstNode *node);
+
+/*
+    Counts the keys of a BST smaller than (or equal to) a provided key, using the size fields. 
+
+    Parameters: 
+        root, key, comp : see bstRank()
+        orEqual (int) : 1 to also count a key equal to key, 0 otherwise
+
+    Output: 
+        The number of keys < key, or <= key if orEqual is 1.
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
+*/
+static size_t countBelow(struct bstNode *root, const void *key, int (*comp)(const void *, const void *), int orEqual);
+
+/*
+    Places the nodes of a BST into Eytzinger order, by visiting the positions of the implicit tree in order 
+    while taking nodes from a cursor in order. 
+
+    Parameters: 
+        order (const void **) : array receiving the nodes (as pointers) at positions 1 to n
+        k (size_t) : position to fill (and the subtree below it)
+        n (size_t) : number of nodes
+        cursor (struct bstCursor *) : cursor over the whole BST
+
+    Runtime: O(n), recursion depth is O(log(n))
+*/
+static void fillEytzinger(const void **order, size_t k, size_t n, struct bstCursor *cursor);
+
+/*
+    Branch free descent of a snapshot. At each position the search goes right if the key there is smaller 
+    than key (or not larger, if orEqual is 1), and left otherwise. 
+
+    Parameters: 
+        snapshot (const struct bstSnapshot *) : pointer to the snapshot
+        key, comp : see bstSearch()
+        orEqual (int) : 1 to also go right on a key equal to key
+
+    Output: 
+        The position past the last leaf reached. Its bits after the leading 1 are the directions taken (0 for 
+        left, 1 for right).
+
+    Runtime: O(log(n))
+*/
+static size_t frozenDescend(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *), int orEqual);
+
+/*
+    Joins 2 AVL trees whose keys are all smaller in left than in right, without a middle node: the minimum of 
+    right is unlinked and used as the middle node of avlJoin(). 
+
+    Parameters: 
+        left (struct bstNode *) : pointer to the root of the smaller keys (may be NULL)
+        right (struct bstNode *) : pointer to the root of the larger keys (may be NULL)
+
+    Output: 
+        A pointer to the root of the joined AVL tree.
+
+    Runtime: O(log(n))    n = # nodes in both trees
+*/
+static struct bstNode *joinTwo(struct bstNode *left, struct bstNode *right);
+
+/*
+    Shared implementation of avlUnion(), avlIntersection(), and avlDifference(). 
+
+    Parameters: 
+        op (int) : SET_UNION, SET_INTERSECTION, or SET_DIFFERENCE
+        a, b, comp : see avlUnion()
+        forks (int) : number of levels the recursion may still fork onto new threads (if BST_THREADS is defined)
+
+    Output: 
+        See avlUnion().
+
+    Runtime: O(m log(n / m + 1))    m, n = # nodes in the smaller and larger tree
+*/
+static struct bstNode *setOperation(int op, struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *), int forks);
+
+#ifdef BST_THREADS
+/*
+    Thread entry point that runs setOperation() on a struct setTask. 
+
+    Parameters: 
+        task (void *) : pointer to the struct setTask
+
+    Output: 
+        NULL, the result is stored in the task.
+*/
+static void *runSetTask(void *task);
+#endif
+
+/*
+    Shared implementation of bstInsertHint() and avlInsertHint(). 
+
+    Parameters: 
+        hint, root, key, copy, size, comp, node : see bstInsertHint() 
+        balanced (int) : 1 to rebalance the path to the inserted node as avlInsert() does, 0 to leave it 
+
+    Output: 
+        See bstInsertHint(). 
+
+    Runtime: see bstInsertHint()
+*/
+static struct bstNode *hintInsert(struct bstHint *hint, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), int balanced, struct bstNode **node);
 
 // ***************************** HEADER FUNCTIONS DEFINITIONS *******************************************
 
@@ -126,16 +604,19 @@ struct bstNode *bstSearch(struct bstNode *root, const void *key, int (*comp)(con
 {
     // tracks last previously visited node
     struct bstNode *prev = NULL;
+    // result of comparing key with the visited node, computed once per node
+    int c;
     while (root != NULL)
     {
         prev = root;
+        c = (*comp)(key, root->key);
         // key less than node being visited, compare it with left child
-        if ((*comp)(key, root->key) < 0)
+        if (c < 0)
         {
             root = root->left;
         }
         // key greater than node being visited, compare it with right child
-        else if ((*comp)(key, root->key) > 0)
+        else if (c > 0)
         {
             root = root->right;
         }
@@ -189,15 +670,15 @@ struct bstNode *bstPredecessor(struct bstNode *root, const void *key, int (*comp
 
     // lowest smaller parent
     struct bstNode *lsp = NULL;
-    // tracks last previously visited node
-    struct bstNode *prev = NULL;
+
+    // result of comparing the visited node with key, computed once per node
+    int c;
 
     // loop until key found or determined not in tree
-    while (root != NULL && (*comp)(root->key, key) != 0)
+    while (root != NULL && (c = (*comp)(root->key, key)) != 0)
     {
-        prev = root;
         // if visited node less than key, track it as a smaller parent and go right
-        if ((*comp)(root->key, key) < 0)
+        if (c < 0)
         {
             lsp = root;
             root = root->right;
@@ -209,10 +690,11 @@ struct bstNode *bstPredecessor(struct bstNode *root, const void *key, int (*comp
         }
     }
 
-    // if key not found, then find predecessor of last previously visited
+    // if key not found, the search fell off the tree right between key's predecessor and successor, so the
+    // lowest smaller parent is the answer (the subtrees of the last visited node are on the wrong side of key)
     if (root == NULL)
     {
-        root = prev;
+        return lsp;
     }
 
     // if key exists in tree, then it may have a left subtree. its predecessor will be the max of that subtree
@@ -221,7 +703,7 @@ struct bstNode *bstPredecessor(struct bstNode *root, const void *key, int (*comp
     {
         return bstMaximum(root->left);
     }
-    // otherwise, if key exists or not, return lowest smallest parent
+    // otherwise, return lowest smallest parent
     else
     {
         return lsp;
@@ -235,17 +717,17 @@ struct bstNode *bstSuccessor(struct bstNode *root, const void *key, int (*comp)(
         return NULL;
     }
 
-    // last previously visited node
-    struct bstNode *prev = NULL;
     // lowest greater parent
     struct bstNode *lgp = NULL;
 
+    // result of comparing the visited node with key, computed once per node
+    int c;
+
     // loop until key found or determined not in tree
-    while (root != NULL && (*comp)(root->key, key) != 0)
+    while (root != NULL && (c = (*comp)(root->key, key)) != 0)
     {
-        prev = root;
         // if visited node greater than key, track it as greater parent and go left
-        if ((*comp)(root->key, key) > 0)
+        if (c > 0)
         {
             lgp = root;
             root = root->left;
@@ -257,10 +739,11 @@ struct bstNode *bstSuccessor(struct bstNode *root, const void *key, int (*comp)(
         }
     }
 
-    // if key not found, then find successor of last previously visited
+    // if key not found, the search fell off the tree right between key's predecessor and successor, so the
+    // lowest greater parent is the answer (the subtrees of the last visited node are on the wrong side of key)
     if (root == NULL)
     {
-        root = prev;
+        return lgp;
     }
 
     // if key exists in tree, then it may have a right subtree. its successor will be the min of that subtree
@@ -269,7 +752,7 @@ struct bstNode *bstSuccessor(struct bstNode *root, const void *key, int (*comp)(
     {
         return bstMinimum(root->right);
     }
-    // otherwise, if key exists or not, return lowest greatest parent
+    // otherwise, return lowest greatest parent
     else
     {
         return lgp;
@@ -278,165 +761,858 @@ struct bstNode *bstSuccessor(struct bstNode *root, const void *key, int (*comp)(
 
 struct bstNode *bstInsert(struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
 {
-    // search for insertion point into tree
-    struct bstNode *res = bstSearch(root, key, comp);
-
-    // if search led to key, return root unchanged
-    if (root != NULL && (*comp)(res->key, key) == 0)
-    {
-        return root;
-    }
+    // same as bstInsertOrFind, the caller just doesn't need the node
+    return bstInsertOrFind(root, key, copy, size, comp, NULL);
+}
 
-    // key not in BST, create node with a copy using helper
-    struct bstNode *newNode = createNewNode(key, copy, size);
+struct bstNode *bstInsertOrFind(struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), struct bstNode **node)
+{
+    return insertOrFind(NULL, root, key, copy, size, comp, 0, node);
+}
 
-    // if BST empty, return created node
-    if (root == NULL)
-    {
-        return newNode;
-    }
-    // if key less than insertion point, insert it as left child
-    else if ((*comp)(key, res->key) < 0)
+struct bstNode *bstUpsert(struct bstNode *root, const void *key, const void *value, size_t valueSize, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), void (*merge)(void *, const void *))
+{
+    // the root's subtree size only grows if the key was inserted, which tells a new node from an existing one
+    struct bstNode *node = NULL;
+    size_t before = subtreeSize(root);
+    root = insertOrFind(NULL, root, key, copy, size, comp, valueSize, &node);
+    if (root->size > before)
     {
-        res->left = newNode;
+        // a set (valueSize 0) has no value to copy, and node->value and value may both be NULL then
+        if (valueSize > 0)
+        {
+            memcpy(node->value, value, valueSize);
+        }
     }
-    // else, key greater, insert it as right child
     else
     {
-        res->right = newNode;
+        (*merge)(node->value, value);
     }
-
-    // return new root
     return root;
 }
 
 struct bstNode *bstDelete(struct bstNode *root, const void *key, int (*comp)(const void *, const void *))
 {
-    // if tree empty
-    if (root == NULL)
-    {
-        return NULL;
-    }
+    return deleteKey(NULL, root, key, comp);
+}
 
-    // similar logic to bstSearch, but both prev and curr needed for deletion, hence it is rewritten
-    struct bstNode *prev = NULL;
-    struct bstNode *curr = root;
-    while (curr != NULL && (*comp)(curr->key, key) != 0)
+void bstFree(struct bstNode *root)
+{
+    // rotate left children up until the root has no left child, then the root can be freed and its right
+    // subtree processed the same way. No recursion or stack is needed, so degenerate trees are fine too.
+    struct bstNode *next = NULL;
+    while (root != NULL)
     {
-        prev = curr;
-        if ((*comp)(key, curr->key) < 0)
+        if (root->left != NULL)
         {
-            curr = curr->left;
+            // right rotation at root, root's left child becomes the new root
+            next = root->left;
+            root->left = next->right;
+            next->right = root;
         }
         else
         {
-            curr = curr->right;
+            // no smaller keys left, free root and continue with its right subtree
+            next = root->right;
+            freeBstNode(NULL, root);
         }
+        root = next;
     }
+}
 
-    // key not found, return untouched root
-    if (curr == NULL)
-    {
+void bstPrint(struct bstNode *root, const char *(*toString)(const void *))
+{
+    // Morris traversal: the right pointer of a node's predecessor temporarily points back at the node (a
+    // thread), which replaces the recursion/stack needed to return to the node after its left subtree
+    struct bstNode *pred = NULL;
+    while (root != NULL)
+    {
+        // no left subtree, print this node and move on to the right (which may be a thread)
+        if (root->left == NULL)
+        {
+            printf("%s\n", (*toString)(root->key));
+            root = root->right;
+            continue;
+        }
+
+        // find the predecessor of root, the maximum of its left subtree
+        pred = root->left;
+        while (pred->right != NULL && pred->right != root)
+        {
+            pred = pred->right;
+        }
+
+        // first visit, thread the predecessor back to root and print the left subtree first
+        if (pred->right == NULL)
+        {
+            pred->right = root;
+            root = root->left;
+        }
+        // second visit (came back through the thread), left subtree is done: remove the thread, print root
+        else
+        {
+            pred->right = NULL;
+            printf("%s\n", (*toString)(root->key));
+            root = root->right;
+        }
+    }
+}
+
+struct bstNode *avlInsert(struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    // rebalancing happens on the way back up from the insertion point, hence the recursive helper
+    return avlInsertNode(NULL, root, key, copy, size, comp);
+}
+
+struct bstNode *avlDelete(struct bstNode *root, const void *key, int (*comp)(const void *, const void *))
+{
+    // rebalancing happens on the way back up from the deleted node, hence the recursive helper
+    return avlDeleteNode(NULL, root, key, comp);
+}
+
+struct bstArena *bstArenaCreate(void)
+{
+    struct bstArena *arena = (struct bstArena *)malloc(sizeof(struct bstArena));
+    // first block is allocated by the first insertion
+    arena->blocks = NULL;
+    return arena;
+}
+
+struct bstNode *bstArenaInsert(struct bstArena *arena, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    return insertOrFind(arena, root, key, copy, size, comp, 0, NULL);
+}
+
+struct bstNode *bstArenaDelete(struct bstArena *arena, struct bstNode *root, const void *key, int (*comp)(const void *, const void *))
+{
+    return deleteKey(arena, root, key, comp);
+}
+
+struct bstNode *avlArenaInsert(struct bstArena *arena, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    return avlInsertNode(arena, root, key, copy, size, comp);
+}
+
+struct bstNode *avlArenaDelete(struct bstArena *arena, struct bstNode *root, const void *key, int (*comp)(const void *, const void *))
+{
+    return avlDeleteNode(arena, root, key, comp);
+}
+
+void bstArenaFree(struct bstArena *arena)
+{
+    // every node lives in a block, so freeing the blocks frees every node of every tree at once
+    struct bstArenaBlock *tmp = NULL;
+    while (arena->blocks != NULL)
+    {
+        tmp = arena->blocks->next;
+        free((void *)arena->blocks);
+        arena->blocks = tmp;
+    }
+    free((void *)arena);
+}
+
+struct bstNode *bstBuildFromSorted(const void *const *keys, size_t n, void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    return buildBalanced(keys, 0, n, copy, size);
+}
+
+struct bstNode *bstBuildFromUnsorted(const void *const *keys, size_t n, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    if (n == 0)
+    {
+        return NULL;
+    }
+
+    // sort a copy of the pointers, the keys themselves are only copied into the nodes
+    const void **sorted = (const void **)malloc(n * sizeof(const void *));
+    for (size_t i = 0; i < n; i++)
+    {
+        sorted[i] = keys[i];
+    }
+    sortKeys(sorted, n, comp);
+
+    // drop duplicates, keeping the first of each run of equal keys
+    size_t distinct = 1;
+    for (size_t i = 1; i < n; i++)
+    {
+        if ((*comp)(sorted[distinct - 1], sorted[i]) != 0)
+        {
+            sorted[distinct++] = sorted[i];
+        }
+    }
+
+    struct bstNode *root = buildBalanced(sorted, 0, distinct, copy, size);
+    free((void *)sorted);
+    return root;
+}
+
+struct bstNode *bstRebalance(struct bstNode *root)
+{
+    // Day-Stout-Warren: right rotations turn the tree into a vine (a linked list through right pointers)
+    struct bstNode pseudoRoot;
+    pseudoRoot.left = NULL;
+    pseudoRoot.right = root;
+    struct bstNode *tail = &pseudoRoot;
+    struct bstNode *rest = root;
+    size_t n = 0;
+    while (rest != NULL)
+    {
+        if (rest->left != NULL)
+        {
+            // right rotation at rest, its left child moves up
+            struct bstNode *l = rest->left;
+            rest->left = l->right;
+            l->right = rest;
+            rest = l;
+            tail->right = l;
+        }
+        else
+        {
+            n++;
+            tail = rest;
+            rest = rest->right;
+        }
+    }
+
+    // left rotations fold the vine into a complete tree, first placing the nodes of an incomplete bottom level
+    size_t full = 1;
+    while (full <= n + 1)
+    {
+        full *= 2;
+    }
+    full = full / 2 - 1;
+    compressVine(&pseudoRoot, n - full);
+    while (full > 1)
+    {
+        full /= 2;
+        compressVine(&pseudoRoot, full);
+    }
+
+    // the result is balanced, so it is also a valid AVL tree once heights (and sizes) are recomputed
+    updateTree(pseudoRoot.right);
+    return pseudoRoot.right;
+}
+
+size_t bstRank(struct bstNode *root, const void *key, int (*comp)(const void *, const void *))
+{
+    return countBelow(root, key, comp, 0);
+}
+
+struct bstNode *bstSelect(struct bstNode *root, size_t k)
+{
+    // the left subtree holds the smallest keys, so its size tells which side the k-th key is on
+    size_t leftSize;
+    while (root != NULL)
+    {
+        leftSize = subtreeSize(root->left);
+        if (k == leftSize)
+        {
+            return root;
+        }
+        if (k < leftSize)
+        {
+            root = root->left;
+        }
+        else
+        {
+            k -= leftSize + 1;
+            root = root->right;
+        }
+    }
+    return NULL;
+}
+
+struct bstNode *bstSplay(struct bstNode *root, const void *key, int (*comp)(const void *, const void *), size_t *depth)
+{
+    if (root == NULL)
+    {
+        if (depth != NULL)
+        {
+            *depth = 0;
+        }
+        return NULL;
+    }
+
+    // search as bstSearch() does, but keep the path since nodes have no parent pointers
+    struct bstPath path;
+    pathInit(&path);
+    struct bstNode *node = root;
+    int c;
+    while (1)
+    {
+        pathPush(&path, node);
+        c = (*comp)(key, node->key);
+        if (c == 0 || (c < 0 ? node->left : node->right) == NULL)
+        {
+            break;
+        }
+        node = c < 0 ? node->left : node->right;
+    }
+    size_t i = path.length - 1;
+    if (depth != NULL)
+    {
+        *depth = i;
+    }
+
+    // node is at path.nodes[i], move it up 2 levels at a time. The rotation helpers update the sizes.
+    struct bstNode *parent = NULL;
+    struct bstNode *grandparent = NULL;
+    while (i >= 2)
+    {
+        parent = path.nodes[i - 1];
+        grandparent = path.nodes[i - 2];
+        if ((grandparent->left == parent) == (parent->left == node))
+        {
+            // zig-zig: rotate the parent up first, then node
+            if (parent->left == node)
+            {
+                rotateRight(grandparent);
+                rotateRight(parent);
+            }
+            else
+            {
+                rotateLeft(grandparent);
+                rotateLeft(parent);
+            }
+        }
+        else if (grandparent->left == parent)
+        {
+            // zig-zag: node goes up twice, once in each direction
+            grandparent->left = rotateLeft(parent);
+            rotateRight(grandparent);
+        }
+        else
+        {
+            grandparent->right = rotateRight(parent);
+            rotateLeft(grandparent);
+        }
+        // node has taken the grandparent's place
+        i -= 2;
+        if (i > 0)
+        {
+            if (path.nodes[i - 1]->left == grandparent)
+            {
+                path.nodes[i - 1]->left = node;
+            }
+            else
+            {
+                path.nodes[i - 1]->right = node;
+            }
+        }
+    }
+    if (i == 1)
+    {
+        // zig: the last rotation when node started at an odd depth
+        parent = path.nodes[0];
+        node = parent->left == node ? rotateRight(parent) : rotateLeft(parent);
+    }
+    pathFree(&path);
+    return node;
+}
+
+struct bstCursor *bstRangeOpen(struct bstNode *root, const void *low, const void *high, int (*comp)(const void *, const void *))
+{
+    struct bstCursor *cursor = (struct bstCursor *)malloc(sizeof(struct bstCursor));
+    pathInit(&cursor->stack);
+    cursor->high = high;
+    cursor->comp = comp;
+
+    // no low bound, the minimum is first
+    if (low == NULL)
+    {
+        pushLeftSpine(&cursor->stack, root);
+        return cursor;
+    }
+
+    // seek: keep the nodes >= low on the search path for low, the last one pushed is the first in the range
+    int c;
+    while (root != NULL)
+    {
+        c = (*comp)(low, root->key);
+        if (c <= 0)
+        {
+            pathPush(&cursor->stack, root);
+            if (c == 0)
+            {
+                break;
+            }
+            root = root->left;
+        }
+        else
+        {
+            root = root->right;
+        }
+    }
+    return cursor;
+}
+
+struct bstNode *bstRangeNext(struct bstCursor *cursor)
+{
+    if (cursor->stack.length == 0)
+    {
+        return NULL;
+    }
+    struct bstNode *next = cursor->stack.nodes[--cursor->stack.length];
+
+    // past the high bound, the rest of the range is empty too
+    if (cursor->high != NULL && (*cursor->comp)(next->key, cursor->high) > 0)
+    {
+        cursor->stack.length = 0;
+        return NULL;
+    }
+
+    // keys between next and the node below it on the stack are in next's right subtree
+    pushLeftSpine(&cursor->stack, next->right);
+    return next;
+}
+
+void bstRangeClose(struct bstCursor *cursor)
+{
+    pathFree(&cursor->stack);
+    free((void *)cursor);
+}
+
+size_t bstRangeCount(struct bstNode *root, const void *low, const void *high, int (*comp)(const void *, const void *))
+{
+    // keys <= high minus keys < low, found with the subtree sizes instead of a walk over the range
+    size_t upTo = high == NULL ? subtreeSize(root) : countBelow(root, high, comp, 1);
+    size_t below = low == NULL ? 0 : countBelow(root, low, comp, 0);
+    return upTo > below ? upTo - below : 0;
+}
+
+struct bstSnapshot *bstFreeze(struct bstNode *root, void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    struct bstSnapshot *snapshot = (struct bstSnapshot *)malloc(sizeof(struct bstSnapshot));
+    snapshot->n = subtreeSize(root);
+    snapshot->keys = (const void **)malloc((snapshot->n + 1) * sizeof(const void *));
+    snapshot->keys[0] = NULL;
+
+    // no bounds, so the cursor never calls a comparison function
+    struct bstCursor *cursor = bstRangeOpen(root, NULL, NULL, NULL);
+    fillEytzinger(snapshot->keys, 1, snapshot->n, cursor);
+    bstRangeClose(cursor);
+
+    // copy the keys into one buffer in the same order, so the keys near the top of the tree (read by every
+    // search) share cache lines. Each copy is aligned like a node's key.
+    size_t bytes = 0;
+    for (size_t k = 1; k <= snapshot->n; k++)
+    {
+        bytes += ((*size)(((const struct bstNode *)snapshot->keys[k])->key) + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT;
+    }
+    snapshot->data = (char *)malloc(bytes > 0 ? bytes : 1);
+    char *dest = snapshot->data;
+    for (size_t k = 1; k <= snapshot->n; k++)
+    {
+        const void *key = ((const struct bstNode *)snapshot->keys[k])->key;
+        (*copy)(dest, key);
+        snapshot->keys[k] = dest;
+        dest += ((*size)(key) + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT;
+    }
+    return snapshot;
+}
+
+const void *bstFrozenSearch(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *))
+{
+    // first key >= key is where the search last went left
+    size_t k = frozenDescend(snapshot, key, comp, 0);
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+    k >>= 1;
+    return k != 0 && (*comp)(snapshot->keys[k], key) == 0 ? snapshot->keys[k] : NULL;
+}
+
+const void *bstFrozenPredecessor(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *))
+{
+    // last key < key is where the search last went right
+    size_t k = frozenDescend(snapshot, key, comp, 0);
+    while (k != 0 && !(k & 1))
+    {
+        k >>= 1;
+    }
+    k >>= 1;
+    return k != 0 ? snapshot->keys[k] : NULL;
+}
+
+const void *bstFrozenSuccessor(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *))
+{
+    // first key > key is where the search (going right on equal keys) last went left
+    size_t k = frozenDescend(snapshot, key, comp, 1);
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+    k >>= 1;
+    return k != 0 ? snapshot->keys[k] : NULL;
+}
+
+void bstFrozenFree(struct bstSnapshot *snapshot)
+{
+    free((void *)snapshot->keys);
+    snapshot->keys = NULL;
+    free((void *)snapshot->data);
+    snapshot->data = NULL;
+    free((void *)snapshot);
+}
+
+struct bstStatistics bstStats(struct bstNode *root)
+{
+    struct bstStatistics stats = {0, 0, 0, 0.0};
+    size_t totalDepth = 0;
+
+    // Morris traversal as in bstPrint(), keeping track of the depth. Going down a left or right child adds 1.
+    // Following a thread from a predecessor back up to a node gives a depth too large by the length of the
+    // path between them (steps) plus 1, which is taken off on the node's second visit.
+    struct bstNode *pred = NULL;
+    size_t depth = 0;
+    size_t steps = 0;
+    while (root != NULL)
+    {
+        if (root->left == NULL)
+        {
+            stats.nodes++;
+            totalDepth += depth;
+            stats.height = depth + 1 > stats.height ? depth + 1 : stats.height;
+            root = root->right;
+            depth++;
+            continue;
+        }
+
+        pred = root->left;
+        steps = 1;
+        while (pred->right != NULL && pred->right != root)
+        {
+            pred = pred->right;
+            steps++;
+        }
+
+        if (pred->right == NULL)
+        {
+            pred->right = root;
+            root = root->left;
+            depth++;
+        }
+        else
+        {
+            pred->right = NULL;
+            depth -= steps + 1;
+            stats.nodes++;
+            totalDepth += depth;
+            root = root->right;
+            depth++;
+        }
+    }
+
+    for (size_t n = stats.nodes; n > 0; n /= 2)
+    {
+        stats.minHeight++;
+    }
+    if (stats.nodes > 0)
+    {
+        stats.averageDepth = (double)totalDepth / (double)stats.nodes;
+    }
+    return stats;
+}
+
+struct bstNode *avlSplit(struct bstNode *root, const void *key, int (*comp)(const void *, const void *), struct bstNode **left, struct bstNode **right)
+{
+    if (root == NULL)
+    {
+        *left = NULL;
+        *right = NULL;
+        return NULL;
+    }
+
+    int c = (*comp)(key, root->key);
+    struct bstNode *found = NULL;
+    if (c == 0)
+    {
+        // the subtrees are the 2 halves already
+        *left = root->left;
+        *right = root->right;
+        root->left = NULL;
+        root->right = NULL;
+        updateNode(root);
+        return root;
+    }
+    if (c < 0)
+    {
+        // root and its right subtree are all larger than key, the right half of the left subtree joins them
+        struct bstNode *middle = NULL;
+        found = avlSplit(root->left, key, comp, left, &middle);
+        *right = avlJoin(middle, root, root->right);
+    }
+    else
+    {
+        struct bstNode *middle = NULL;
+        found = avlSplit(root->right, key, comp, &middle, right);
+        *left = avlJoin(root->left, root, middle);
+    }
+    return found;
+}
+
+struct bstNode *avlJoin(struct bstNode *left, struct bstNode *mid, struct bstNode *right)
+{
+    // descend the spine of the taller tree facing the other one, then rebalance back up as avlInsert() does
+    if (height(left) > height(right) + 1)
+    {
+        left->right = avlJoin(left->right, mid, right);
+        return rebalance(left);
+    }
+    if (height(right) > height(left) + 1)
+    {
+        right->left = avlJoin(left, mid, right->left);
+        return rebalance(right);
+    }
+    mid->left = left;
+    mid->right = right;
+    updateNode(mid);
+    return mid;
+}
+
+struct bstNode *avlUnion(struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *))
+{
+    return setOperation(SET_UNION, a, b, comp, BST_FORK_DEPTH);
+}
+
+struct bstNode *avlIntersection(struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *))
+{
+    return setOperation(SET_INTERSECTION, a, b, comp, BST_FORK_DEPTH);
+}
+
+struct bstNode *avlDifference(struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *))
+{
+    return setOperation(SET_DIFFERENCE, a, b, comp, BST_FORK_DEPTH);
+}
+
+struct bstHint *bstHintCreate(void)
+{
+    struct bstHint *hint = (struct bstHint *)malloc(sizeof(struct bstHint));
+    pathInit(&hint->path);
+    return hint;
+}
+
+struct bstNode *bstInsertHint(struct bstHint *hint, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), struct bstNode **node)
+{
+    return hintInsert(hint, root, key, copy, size, comp, 0, node);
+}
+
+struct bstNode *avlInsertHint(struct bstHint *hint, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), struct bstNode **node)
+{
+    return hintInsert(hint, root, key, copy, size, comp, 1, node);
+}
+
+void bstHintReset(struct bstHint *hint)
+{
+    hint->path.length = 0;
+}
+
+void bstHintFree(struct bstHint *hint)
+{
+    pathFree(&hint->path);
+    free((void *)hint);
+}
+
+// ***************************** PRIVATE HELPER FUNCTIONS DECLARATIONS ***************************************
+
+static struct bstNode *createNewNode(struct bstArena *arena, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), size_t valueSize)
+{
+    // allocate space for the struct and the copy of the key in one go, from the arena if there is one
+    // (note malloc() returns void * hence the cast)
+    size_t bytes = KEY_OFFSET + ALIGN_UP(valueSize) + (*size)(key);
+    struct bstNode *n = (struct bstNode *)(arena != NULL ? arenaAlloc(arena, bytes) : malloc(bytes));
+
+    // key is stored right after the node, or after its value
+    n->value = valueSize > 0 ? (char *)n + KEY_OFFSET : NULL;
+    n->key = (char *)n + KEY_OFFSET + ALIGN_UP(valueSize);
+
+    // copy the key into the structure's field
+    (*copy)(n->key, key);
+
+    // set children to NULL before returning created node, these are default initialized to garbage
+    n->left = NULL;
+    n->right = NULL;
+    // a new node is always a leaf
+    n->height = 1;
+    n->size = 1;
+    return n;
+}
+
+static void freeBstNode(struct bstArena *arena, struct bstNode *node)
+{
+    // mark children as NULL (note this could lead to orphaned data if children were not freed)
+    node->left = NULL;
+    node->right = NULL;
+    // key data (and value) are part of the node's allocation, mark them NULL as well
+    node->key = NULL;
+    node->value = NULL;
+    // free storage allocated to pointer parameter, arena storage is freed with the arena
+    if (arena == NULL)
+    {
+        free((void *)node);
+    }
+}
+
+static void *arenaAlloc(struct bstArena *arena, size_t bytes)
+{
+    // keep every allocation aligned by rounding its size up
+    bytes = (bytes + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT;
+
+    // start a new block if the request doesn't fit in the current one
+    if (arena->blocks == NULL || arena->blocks->used + bytes > arena->blocks->capacity)
+    {
+        size_t capacity = bytes > ARENA_BLOCK_SIZE ? bytes : ARENA_BLOCK_SIZE;
+        struct bstArenaBlock *b = (struct bstArenaBlock *)malloc(BLOCK_HEADER_SIZE + capacity);
+        b->used = 0;
+        b->capacity = capacity;
+        b->next = arena->blocks;
+        arena->blocks = b;
+    }
+
+    void *mem = (char *)arena->blocks + BLOCK_HEADER_SIZE + arena->blocks->used;
+    arena->blocks->used += bytes;
+    return mem;
+}
+
+static struct bstNode *insertOrFind(struct bstArena *arena, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), size_t valueSize, struct bstNode **node)
+{
+    // if BST empty, created node is the new root
+    if (root == NULL)
+    {
+        root = createNewNode(arena, key, copy, size, valueSize);
+        if (node != NULL)
+        {
+            *node = root;
+        }
         return root;
     }
 
+    // search for insertion point, remembering the side to attach on so no comparison is repeated, and the
+    // visited nodes as each of them gains a node if the key is inserted
+    struct bstNode *curr = root;
+    struct bstNode **link = NULL;
+    struct bstPath path;
+    pathInit(&path);
+    int c;
+    while (1)
+    {
+        c = (*comp)(key, curr->key);
+        // key already in tree, return root unchanged
+        if (c == 0)
+        {
+            if (node != NULL)
+            {
+                *node = curr;
+            }
+            pathFree(&path);
+            return root;
+        }
+        pathPush(&path, curr);
+        // key less than visited node, insertion point is in left subtree (or is the empty left child)
+        link = c < 0 ? &curr->left : &curr->right;
+        if (*link == NULL)
+        {
+            break;
+        }
+        curr = *link;
+    }
+
+    // key not in BST, create node with a copy using helper and attach it at the empty child found
+    *link = createNewNode(arena, key, copy, size, valueSize);
+    if (node != NULL)
+    {
+        *node = *link;
+    }
+    for (size_t i = 0; i < path.length; i++)
+    {
+        path.nodes[i]->size++;
+    }
+    pathFree(&path);
+    return root;
+}
+
+static struct bstNode *deleteKey(struct bstArena *arena, struct bstNode *root, const void *key, int (*comp)(const void *, const void *))
+{
+    // if tree empty
+    if (root == NULL)
+    {
+        return NULL;
+    }
+
+    // similar logic to bstSearch, but both prev and curr needed for deletion, hence it is rewritten. The
+    // ancestors of curr are kept as each of them loses a node if the key is found
+    struct bstNode *prev = NULL;
+    struct bstNode *curr = root;
+    struct bstPath path;
+    pathInit(&path);
+    int c;
+    while (curr != NULL && (c = (*comp)(key, curr->key)) != 0)
+    {
+        pathPush(&path, curr);
+        prev = curr;
+        if (c < 0)
+        {
+            curr = curr->left;
+        }
+        else
+        {
+            curr = curr->right;
+        }
+    }
+
+    // key not found, return untouched root
+    if (curr == NULL)
+    {
+        pathFree(&path);
+        return root;
+    }
+    for (size_t i = 0; i < path.length; i++)
+    {
+        path.nodes[i]->size--;
+    }
+    pathFree(&path);
+
     // will hold new root
     struct bstNode *out = NULL;
 
     // key has 2 children, delete using helper
     if (curr->left != NULL && curr->right != NULL)
     {
-        out = deleteNodeWith2Children(root, curr, prev, comp);
+        out = deleteNodeWith2Children(root, curr, prev);
     }
     // key has 1 child, delete using helper
     else if (curr->left != NULL || curr->right != NULL)
     {
-        out = deleteNodeWith1Child(root, curr, prev, comp);
+        out = deleteNodeWith1Child(root, curr, prev);
     }
     // key is a leaf, delete using helper
     else
     {
-        out = deleteLeaf(root, curr, prev, comp);
+        out = deleteLeaf(root, curr, prev);
     }
 
     // free the deleted node and return new root
-    freeBstNode(curr);
+    freeBstNode(arena, curr);
     return out;
 }
 
-void bstFree(struct bstNode *root)
-{
-    // nothing to deallocate in this case
-    if (root == NULL)
-    {
-        return;
-    }
-    // use postorder traversal to perform memory deallocation, free subtrees first then root
-    bstFree(root->left);
-    bstFree(root->right);
-    freeBstNode(root);
-}
-
-void bstPrint(struct bstNode *root, const char *(*toString)(const void *))
-{
-    // nothing to print in this case
-    if (root == NULL)
-    {
-        return;
-    }
-    // print left subtree first
-    bstPrint(root->left, toString);
-    // print this node using toString function
-    printf("%s\n", (*toString)(root->key));
-    // print right subtree after
-    bstPrint(root->right, toString);
-}
-
-// ***************************** PRIVATE HELPER FUNCTIONS DECLARATIONS ***************************************
-
-static struct bstNode *createNewNode(const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *))
-{
-    // allocate space for the struct (note malloc() returns void * hence the cast)
-    // sizeof() is used on the type bstNode
-    struct bstNode *n = (struct bstNode *)malloc(sizeof(struct bstNode));
-
-    // allocate space for a copy of the key using the size
-    n->key = malloc((*size)(key));
-
-    // copy the key into the structure's field
-    (*copy)(n->key, key);
-
-    // set children to NULL before returning created node, these are default initialized to garbage
-    n->left = NULL;
-    n->right = NULL;
-    return n;
-}
-
-static void freeBstNode(struct bstNode *node)
-{
-    // mark children as NULL (note this could lead to orphaned data if children were not freed)
-    node->left = NULL;
-    node->right = NULL;
-    // free data referenced by key pointer and mark it NULL as well
-    free(node->key);
-    node->key = NULL;
-    // free storage allocated to pointer parameter
-    free((void *)node);
-}
-
-static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstNode *curr, struct bstNode *prev, int (*comp)(const void *, const void *))
+static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstNode *curr, struct bstNode *prev)
 {
     // track last node visited prior to the successor
     struct bstNode *sPrev = NULL;
     // track the successor, which will be the minimum of the right subtree (as curr is known to have 2 children)
     struct bstNode *successor = curr->right;
 
-    // find successor as minimum
+    // find successor as minimum, every node passed on the way loses the successor from its subtree
     while (successor->left != NULL)
     {
+        successor->size--;
         sPrev = successor;
         successor = successor->left;
     }
+    // successor takes curr's place, so its subtree is curr's without curr
+    successor->size = curr->size - 1;
 
     // successor must be switched with curr, this checks if successor has a parent that needs to be updated
     if (sPrev != NULL)
@@ -461,7 +1637,7 @@ static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstN
     else
     {
         // if deleted node is a left child, update its parent's left child to be the successor
-        if ((*comp)(curr->key, prev->key) < 0)
+        if (prev->left == curr)
         {
             prev->left = successor;
         }
@@ -476,7 +1652,7 @@ static struct bstNode *deleteNodeWith2Children(struct bstNode *root, struct bstN
     }
 }
 
-static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode *curr, struct bstNode *prev, int (*comp)(const void *, const void *))
+static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode *curr, struct bstNode *prev)
 {
     // determine whether curr has a left or right child
     struct bstNode *child = NULL;
@@ -497,7 +1673,7 @@ static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode
     else
     {
         // if deleted node is a left child, update its parent's left child to be curr's child
-        if ((*comp)(curr->key, prev->key) < 0)
+        if (prev->left == curr)
         {
             prev->left = child;
         }
@@ -512,7 +1688,7 @@ static struct bstNode *deleteNodeWith1Child(struct bstNode *root, struct bstNode
     }
 }
 
-static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, struct bstNode *prev, int (*comp)(const void *, const void *))
+static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, struct bstNode *prev)
 {
     // this means root is being deleted, and if root is a leaf, that means this was a 1 node tree that is now empty
     if (prev == NULL)
@@ -522,7 +1698,7 @@ static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, st
     else
     {
         // if deleted node is a left child, update its parent's left child to be NULL
-        if ((*comp)(curr->key, prev->key) < 0)
+        if (prev->left == curr)
         {
             prev->left = NULL;
         }
@@ -536,3 +1712,545 @@ static struct bstNode *deleteLeaf(struct bstNode *root, struct bstNode *curr, st
         return root;
     }
 }
+
+static int height(struct bstNode *node)
+{
+    return node == NULL ? 0 : node->height;
+}
+
+static size_t subtreeSize(struct bstNode *node)
+{
+    return node == NULL ? 0 : node->size;
+}
+
+static void updateNode(struct bstNode *node)
+{
+    int lh = height(node->left);
+    int rh = height(node->right);
+    node->height = (lh > rh ? lh : rh) + 1;
+    node->size = subtreeSize(node->left) + subtreeSize(node->right) + 1;
+}
+
+static void pathInit(struct bstPath *path)
+{
+    path->nodes = path->local;
+    path->length = 0;
+    path->capacity = PATH_STACK_SIZE;
+}
+
+static void pathPush(struct bstPath *path, struct bstNode *node)
+{
+    // only degenerate (deep) trees get here, the path doubles in size each time it is full
+    if (path->length == path->capacity)
+    {
+        struct bstNode **nodes = (struct bstNode **)malloc(2 * path->capacity * sizeof(struct bstNode *));
+        for (size_t i = 0; i < path->length; i++)
+        {
+            nodes[i] = path->nodes[i];
+        }
+        if (path->nodes != path->local)
+        {
+            free((void *)path->nodes);
+        }
+        path->nodes = nodes;
+        path->capacity *= 2;
+    }
+    path->nodes[path->length++] = node;
+}
+
+static void pathFree(struct bstPath *path)
+{
+    if (path->nodes != path->local)
+    {
+        free((void *)path->nodes);
+    }
+    path->nodes = NULL;
+    path->length = 0;
+}
+
+static struct bstNode *rotateLeft(struct bstNode *node)
+{
+    // right child moves up, its left subtree (keys between node and it) moves under node
+    struct bstNode *r = node->right;
+    node->right = r->left;
+    r->left = node;
+    // node is now below r, so its height has to be fixed first
+    updateNode(node);
+    updateNode(r);
+    return r;
+}
+
+static struct bstNode *rotateRight(struct bstNode *node)
+{
+    // left child moves up, its right subtree (keys between it and node) moves under node
+    struct bstNode *l = node->left;
+    node->left = l->right;
+    l->right = node;
+    updateNode(node);
+    updateNode(l);
+    return l;
+}
+
+static struct bstNode *rebalance(struct bstNode *node)
+{
+    updateNode(node);
+    int balance = height(node->left) - height(node->right);
+
+    // left heavy
+    if (balance > 1)
+    {
+        // left child is right heavy (left-right case), turn it into the left-left case first
+        if (height(node->left->left) < height(node->left->right))
+        {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+    // right heavy
+    if (balance < -1)
+    {
+        // right child is left heavy (right-left case), turn it into the right-right case first
+        if (height(node->right->right) < height(node->right->left))
+        {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+    // already balanced
+    return node;
+}
+
+static struct bstNode *avlInsertNode(struct bstArena *arena, struct bstNode *node, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    // empty spot found, key goes here
+    if (node == NULL)
+    {
+        return createNewNode(arena, key, copy, size, 0);
+    }
+
+    int c = (*comp)(key, node->key);
+    if (c < 0)
+    {
+        node->left = avlInsertNode(arena, node->left, key, copy, size, comp);
+    }
+    else if (c > 0)
+    {
+        node->right = avlInsertNode(arena, node->right, key, copy, size, comp);
+    }
+    // key already in tree, nothing changes
+    else
+    {
+        return node;
+    }
+    return rebalance(node);
+}
+
+static struct bstNode *avlDeleteNode(struct bstArena *arena, struct bstNode *node, const void *key, int (*comp)(const void *, const void *))
+{
+    // key not in tree
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    int c = (*comp)(key, node->key);
+    if (c < 0)
+    {
+        node->left = avlDeleteNode(arena, node->left, key, comp);
+    }
+    else if (c > 0)
+    {
+        node->right = avlDeleteNode(arena, node->right, key, comp);
+    }
+    else
+    {
+        // node has at most 1 child, that child (or NULL) takes its place
+        struct bstNode *replacement = NULL;
+        if (node->left == NULL || node->right == NULL)
+        {
+            replacement = node->left != NULL ? node->left : node->right;
+        }
+        // node has 2 children, its successor (minimum of right subtree) takes its place
+        else
+        {
+            struct bstNode *rest = avlRemoveMinimum(node->right, &replacement);
+            replacement->left = node->left;
+            replacement->right = rest;
+            replacement = rebalance(replacement);
+        }
+        freeBstNode(arena, node);
+        return replacement;
+    }
+    return rebalance(node);
+}
+
+static struct bstNode *avlRemoveMinimum(struct bstNode *node, struct bstNode **min)
+{
+    // no left child, this is the minimum and its right subtree takes its place
+    if (node->left == NULL)
+    {
+        *min = node;
+        return node->right;
+    }
+    node->left = avlRemoveMinimum(node->left, min);
+    return rebalance(node);
+}
+
+static struct bstNode *buildBalanced(const void *const *keys, size_t lo, size_t hi, void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    if (lo >= hi)
+    {
+        return NULL;
+    }
+    // middle key is the root, so the two halves differ in size by at most 1
+    size_t mid = lo + (hi - lo) / 2;
+    struct bstNode *node = createNewNode(NULL, keys[mid], copy, size, 0);
+    node->left = buildBalanced(keys, lo, mid, copy, size);
+    node->right = buildBalanced(keys, mid + 1, hi, copy, size);
+    updateNode(node);
+    return node;
+}
+
+static void sortKeys(const void **keys, size_t n, int (*comp)(const void *, const void *))
+{
+    const void **buf = (const void **)malloc(n * sizeof(const void *));
+    const void **src = keys;
+    const void **dest = buf;
+
+    // merge runs of width 1, 2, 4, ... alternating between the two arrays
+    for (size_t width = 1; width < n; width *= 2)
+    {
+        for (size_t lo = 0; lo < n; lo += 2 * width)
+        {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            size_t i = lo;
+            size_t j = mid;
+            size_t k = lo;
+            while (i < mid && j < hi)
+            {
+                // <= keeps equal keys in their original order
+                dest[k++] = (*comp)(src[i], src[j]) <= 0 ? src[i++] : src[j++];
+            }
+            while (i < mid)
+            {
+                dest[k++] = src[i++];
+            }
+            while (j < hi)
+            {
+                dest[k++] = src[j++];
+            }
+        }
+        const void **tmp = src;
+        src = dest;
+        dest = tmp;
+    }
+
+    // sorted result ends up in src, which may be the buffer
+    if (src != keys)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            keys[i] = src[i];
+        }
+    }
+    free((void *)buf);
+}
+
+static void compressVine(struct bstNode *pseudoRoot, size_t count)
+{
+    struct bstNode *scanner = pseudoRoot;
+    for (size_t i = 0; i < count; i++)
+    {
+        // left rotation at scanner's right child, which becomes the left child of its own right child
+        struct bstNode *child = scanner->right;
+        scanner->right = child->right;
+        scanner = scanner->right;
+        child->right = scanner->left;
+        scanner->left = child;
+    }
+}
+
+static void updateTree(struct bstNode *node)
+{
+    if (node != NULL)
+    {
+        updateTree(node->left);
+        updateTree(node->right);
+        updateNode(node);
+    }
+}
+
+static void pushLeftSpine(struct bstPath *path, struct bstNode *node)
+{
+    while (node != NULL)
+    {
+        pathPush(path, node);
+        node = node->left;
+    }
+}
+
+static size_t countBelow(struct bstNode *root, const void *key, int (*comp)(const void *, const void *), int orEqual)
+{
+    // every time the search goes right, the node and its left subtree are smaller than key
+    size_t rank = 0;
+    int c;
+    while (root != NULL)
+    {
+        c = (*comp)(key, root->key);
+        if (c <= 0)
+        {
+            if (c == 0)
+            {
+                return rank + subtreeSize(root->left) + (orEqual ? 1 : 0);
+            }
+            root = root->left;
+        }
+        else
+        {
+            rank += subtreeSize(root->left) + 1;
+            root = root->right;
+        }
+    }
+    return rank;
+}
+
+static void fillEytzinger(const void **order, size_t k, size_t n, struct bstCursor *cursor)
+{
+    if (k <= n)
+    {
+        // left subtree of position k holds the keys before it, right subtree the keys after it
+        fillEytzinger(order, 2 * k, n, cursor);
+        order[k] = bstRangeNext(cursor);
+        fillEytzinger(order, 2 * k + 1, n, cursor);
+    }
+}
+
+static size_t frozenDescend(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *), int orEqual)
+{
+    size_t k = 1;
+    while (k <= snapshot->n)
+    {
+        // the positions 3 levels down are adjacent, so one prefetch covers all 8 of them
+        if (PREFETCH_AHEAD * k <= snapshot->n)
+        {
+            PREFETCH(&snapshot->keys[PREFETCH_AHEAD * k]);
+        }
+        // the comparison result picks the child arithmetically instead of with a branch
+        k = 2 * k + ((*comp)(snapshot->keys[k], key) < orEqual);
+    }
+    return k;
+}
+
+static struct bstNode *joinTwo(struct bstNode *left, struct bstNode *right)
+{
+    if (right == NULL)
+    {
+        return left;
+    }
+    struct bstNode *mid = NULL;
+    right = avlRemoveMinimum(right, &mid);
+    return avlJoin(left, mid, right);
+}
+
+static struct bstNode *setOperation(int op, struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *), int forks)
+{
+    // an empty side decides the result, the other tree is kept whole or freed
+    if (a == NULL || b == NULL)
+    {
+        if (op == SET_UNION)
+        {
+            return a != NULL ? a : b;
+        }
+        bstFree(b);
+        if (op == SET_INTERSECTION)
+        {
+            bstFree(a);
+            return NULL;
+        }
+        return a;
+    }
+
+    // split a at b's root key, the halves only overlap b's subtrees on the same side
+    struct bstNode *aLeft = NULL;
+    struct bstNode *aRight = NULL;
+    struct bstNode *found = avlSplit(a, b->key, comp, &aLeft, &aRight);
+    struct bstNode *bLeft = b->left;
+    struct bstNode *bRight = b->right;
+    struct bstNode *left = NULL;
+    struct bstNode *right = NULL;
+
+#ifdef BST_THREADS
+    // the 2 halves share no nodes, so one may run on a new thread while this one does the other
+    pthread_t thread;
+    struct setTask task = {op, aLeft, bLeft, comp, forks - 1, NULL};
+    if (forks > 0 && subtreeSize(aLeft) + subtreeSize(bLeft) >= PARALLEL_GRAIN && subtreeSize(aRight) + subtreeSize(bRight) >= PARALLEL_GRAIN && pthread_create(&thread, NULL, runSetTask, &task) == 0)
+    {
+        right = setOperation(op, aRight, bRight, comp, forks - 1);
+        pthread_join(thread, NULL);
+        left = task.result;
+    }
+    else
+#endif
+    {
+        left = setOperation(op, aLeft, bLeft, comp, forks - 1);
+        right = setOperation(op, aRight, bRight, comp, forks - 1);
+    }
+
+    // b's root is kept for a union, a's copy of the key for an intersection, and neither for a difference
+    if (op == SET_UNION)
+    {
+        if (found != NULL)
+        {
+            freeBstNode(NULL, found);
+        }
+        return avlJoin(left, b, right);
+    }
+    freeBstNode(NULL, b);
+    if (op == SET_INTERSECTION && found != NULL)
+    {
+        return avlJoin(left, found, right);
+    }
+    if (found != NULL)
+    {
+        freeBstNode(NULL, found);
+    }
+    return joinTwo(left, right);
+}
+
+#ifdef BST_THREADS
+static void *runSetTask(void *task)
+{
+    struct setTask *t = (struct setTask *)task;
+    t->result = setOperation(t->op, t->a, t->b, t->comp, t->forks);
+    return NULL;
+}
+#endif
+
+static struct bstNode *hintInsert(struct bstHint *hint, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), int balanced, struct bstNode **node)
+{
+    struct bstPath *path = &hint->path;
+    struct bstNode *found = NULL;
+    if (root == NULL)
+    {
+        found = createNewNode(NULL, key, copy, size, 0);
+        path->length = 0;
+        pathPush(path, found);
+        if (node != NULL)
+        {
+            *node = found;
+        }
+        return found;
+    }
+    // a path from another tree (or an older root) can't be used
+    if (path->length == 0 || path->nodes[0] != root)
+    {
+        path->length = 0;
+        pathPush(path, root);
+    }
+
+    // the last node is in every subtree on the path, so the key is on the same side of all their bounds on 
+    // one side as it is of the last node. Only the bounds on the other side, the ancestors the path turned 
+    // towards the key from, need checking: walk up them until one is beyond the key. The subtree that has 
+    // it as its nearest such bound, starting from the ancestor checked before it, holds the key.
+    size_t from = path->length - 1;
+    int c = (*comp)(key, path->nodes[from]->key);
+    for (size_t i = from; c != 0 && i > 0; i--)
+    {
+        struct bstNode *parent = path->nodes[i - 1];
+        if ((parent->left == path->nodes[i]) != (c > 0))
+        {
+            continue;
+        }
+        int pc = (*comp)(key, parent->key);
+        if (pc == 0)
+        {
+            path->length = i;
+            c = 0;
+            break;
+        }
+        // key within the bound
+        if ((pc < 0) != (c < 0))
+        {
+            break;
+        }
+        from = i - 1;
+    }
+    if (c == 0)
+    {
+        if (node != NULL)
+        {
+            *node = path->nodes[path->length - 1];
+        }
+        return root;
+    }
+
+    // descend from there as insertOrFind() does, c is the side of the key at path->nodes[from]
+    path->length = from + 1;
+    struct bstNode *curr = path->nodes[from];
+    struct bstNode **link = c < 0 ? &curr->left : &curr->right;
+    while (*link != NULL)
+    {
+        curr = *link;
+        pathPush(path, curr);
+        c = (*comp)(key, curr->key);
+        if (c == 0)
+        {
+            if (node != NULL)
+            {
+                *node = curr;
+            }
+            return root;
+        }
+        link = c < 0 ? &curr->left : &curr->right;
+    }
+    found = createNewNode(NULL, key, copy, size, 0);
+    *link = found;
+    pathPush(path, found);
+    if (node != NULL)
+    {
+        *node = found;
+    }
+
+    // every node above gains a node. An AVL tree is rebalanced bottom up until a height stays the same (after
+    // a rotation it always does), then only the sizes change.
+    int growing = balanced;
+    for (size_t i = path->length - 1; i-- > 0;)
+    {
+        struct bstNode *n = path->nodes[i];
+        if (!growing)
+        {
+            n->size++;
+            continue;
+        }
+        int before = n->height;
+        struct bstNode *top = rebalance(n);
+        if (top == n)
+        {
+            growing = n->height != before;
+            continue;
+        }
+        growing = 0;
+        if (i == 0)
+        {
+            root = top;
+        }
+        else if (path->nodes[i - 1]->left == n)
+        {
+            path->nodes[i - 1]->left = top;
+        }
+        else
+        {
+            path->nodes[i - 1]->right = top;
+        }
+        // the rotation moved the nodes below i, find the path to the new node again (as the rotation is at the
+        // top of the nodes whose height changed, this is amortized O(1) comparisons too)
+        path->length = i;
+        for (curr = top; curr != found; curr = (*comp)(key, curr->key) < 0 ? curr->left : curr->right)
+        {
+            pathPush(path, curr);
+        }
+        pathPush(path, found);
+    }
+    return root;
+}
@@ -0,0 +1,299 @@
+/*
+    Benchmark of the BST of trees.h. For each key order (random, sorted, reverse sorted, Zipfian) and each
+    number of keys (1K, 10K, ... up to a maximum), it builds an unbalanced BST (bstInsert()) and an AVL tree
+    (avlInsert()) and reports:
+
+        -   the time per insertion, search, successor query (bstSuccessor()), and deletion in nanoseconds
+        -   the time per insertion through an insertion hint (bstInsertHint(), avlInsertHint()), which is
+            much faster for the (nearly) sorted orders
+        -   the height, smallest possible height, and average node depth (bstStats())
+        -   the number of comparison function calls per search
+
+    Searches are for the inserted keys, in random order except for the Zipfian order, where they are drawn from
+    the same distribution (a few keys are searched for most of the time, and keys never drawn for insertion
+    are missed). Deletions remove every key, in random order. A row ends in "(error)" if a search, successor
+    query, or deletion gave a wrong result.
+
+    Usage: bst_bench [maxKeys]    (default 1000000, at most 10000000, link with -lm)
+
+    Sorted and reverse sorted insertions make the unbalanced BST a path, so their cost grows quadratically, and
+    they are skipped above QUADRATIC_LIMIT keys (the trend is clear well before that).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#include "trees.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MIN_KEYS 1000            // smallest number of keys benchmarked
+#define MAX_KEYS 10000000        // largest number of keys that may be requested
+#define DEFAULT_MAX_KEYS 1000000 // largest number of keys benchmarked by default
+#define QUADRATIC_LIMIT 20000    // largest number of sorted keys inserted into the unbalanced BST
+#define ZIPF_EXPONENT 0.99       // skew of the Zipfian order (1 is the classic word frequency law)
+
+enum order
+{
+    RANDOM,
+    SORTED,
+    REVERSE,
+    ZIPF
+};
+
+const char *orderNames[] = {"random", "sorted", "reverse", "zipf"};
+
+unsigned long comparisons = 0;
+uint64_t rngState = 45;
+
+int countingCmp(const void *a, const void *b);
+void intCopy(void *dst, const void *src);
+size_t intSize(const void *key);
+uint64_t nextRandom(void);
+void shuffle(int *a, size_t n);
+double *zipfTable(size_t n);
+size_t zipfSample(const double *cdf, size_t n);
+void makeKeys(enum order order, size_t n, int *inserts, int *searches, size_t *distinct, size_t *hits);
+double nsPerOp(clock_t start, size_t ops);
+void run(enum order order, size_t n, int avl, const int *inserts, const int *searches, size_t distinct, size_t hits);
+
+int main(int argc, char *argv[])
+{
+    size_t maxKeys = DEFAULT_MAX_KEYS;
+    if (argc > 1)
+    {
+        maxKeys = (size_t)strtoul(argv[1], NULL, 10);
+        maxKeys = maxKeys < MIN_KEYS ? MIN_KEYS : (maxKeys > MAX_KEYS ? MAX_KEYS : maxKeys);
+    }
+
+    int *inserts = (int *)malloc(maxKeys * sizeof(int));
+    int *searches = (int *)malloc(maxKeys * sizeof(int));
+    printf("%-8s %-4s %9s %9s %7s %6s %9s %9s %9s %9s %9s %9s %9s\n", "order", "tree", "keys", "distinct", "height",
+           "min", "avgDepth", "insert", "hinted", "search", "cmp/srch", "succ", "delete");
+    for (int order = RANDOM; order <= ZIPF; order++)
+    {
+        for (size_t n = MIN_KEYS; n <= maxKeys; n *= 10)
+        {
+            size_t distinct = 0;
+            size_t hits = 0;
+            makeKeys((enum order)order, n, inserts, searches, &distinct, &hits);
+            run((enum order)order, n, 0, inserts, searches, distinct, hits);
+            run((enum order)order, n, 1, inserts, searches, distinct, hits);
+        }
+    }
+    free(inserts);
+    free(searches);
+    return 0;
+}
+
+void run(enum order order, size_t n, int avl, const int *inserts, const int *searches, size_t distinct, size_t hits)
+{
+    const char *tree = avl ? "avl" : "bst";
+    if (!avl && (order == SORTED || order == REVERSE) && n > QUADRATIC_LIMIT)
+    {
+        printf("%-8s %-4s %9u  skipped (a path, quadratic)\n", orderNames[order], tree, (unsigned)n);
+        return;
+    }
+
+    struct bstNode *root = NULL;
+    clock_t start = clock();
+    for (size_t i = 0; i < n; i++)
+    {
+        root = avl ? avlInsert(root, &inserts[i], intCopy, intSize, countingCmp) : bstInsert(root, &inserts[i], intCopy, intSize, countingCmp);
+    }
+    double insertNs = nsPerOp(start, n);
+    struct bstStatistics stats = bstStats(root);
+
+    // the same insertions into a second tree, each starting from the previous key's node
+    struct bstHint *hint = bstHintCreate();
+    struct bstNode *hinted = NULL;
+    start = clock();
+    for (size_t i = 0; i < n; i++)
+    {
+        hinted = avl ? avlInsertHint(hint, hinted, &inserts[i], intCopy, intSize, countingCmp, NULL) : bstInsertHint(hint, hinted, &inserts[i], intCopy, intSize, countingCmp, NULL);
+    }
+    double hintedNs = nsPerOp(start, n);
+    bstHintFree(hint);
+    bstFree(hinted);
+
+    comparisons = 0;
+    // a miss returns the last node visited rather than NULL, so hits are told apart by key
+    size_t found = 0;
+    start = clock();
+    for (size_t i = 0; i < n; i++)
+    {
+        found += *(const int *)bstSearch(root, &searches[i], countingCmp)->key == searches[i];
+    }
+    double searchNs = nsPerOp(start, n);
+    double cmpPerSearch = (double)comparisons / (double)n;
+
+    // a successor must be larger than the searched key (NULL only for the maximum)
+    size_t wrongSuccessors = 0;
+    start = clock();
+    for (size_t i = 0; i < n; i++)
+    {
+        struct bstNode *s = bstSuccessor(root, &searches[i], countingCmp);
+        wrongSuccessors += s != NULL && *(const int *)s->key <= searches[i];
+    }
+    double succNs = nsPerOp(start, n);
+
+    // delete every distinct key in a random order, then the tree must be empty
+    int *deletes = (int *)malloc(n * sizeof(int));
+    size_t count = 0;
+    for (struct bstNode *k = bstMinimum(root); k != NULL; k = bstSuccessor(root, k->key, countingCmp))
+    {
+        deletes[count++] = *(const int *)k->key;
+    }
+    shuffle(deletes, count);
+    start = clock();
+    for (size_t i = 0; i < count; i++)
+    {
+        root = avl ? avlDelete(root, &deletes[i], countingCmp) : bstDelete(root, &deletes[i], countingCmp);
+    }
+    double deleteNs = nsPerOp(start, count);
+    free(deletes);
+
+    printf("%-8s %-4s %9u %9u %7u %6u %9.2f %9.1f %9.1f %9.1f %9.2f %9.1f %9.1f%s\n", orderNames[order], tree,
+           (unsigned)n, (unsigned)distinct, (unsigned)stats.height, (unsigned)stats.minHeight, stats.averageDepth,
+           insertNs, hintedNs, searchNs, cmpPerSearch, succNs, deleteNs, root == NULL && found == hits && wrongSuccessors == 0 ? "" : " (error)");
+    bstFree(root);
+}
+
+void makeKeys(enum order order, size_t n, int *inserts, int *searches, size_t *distinct, size_t *hits)
+{
+    // keys are even so that the odd numbers are missing keys
+    for (size_t i = 0; i < n; i++)
+    {
+        inserts[i] = (int)(2 * i);
+    }
+    *distinct = n;
+    *hits = n;
+    if (order == REVERSE)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            inserts[i] = (int)(2 * (n - 1 - i));
+        }
+    }
+    else if (order == RANDOM || order == ZIPF)
+    {
+        shuffle(inserts, n);
+    }
+    memcpy(searches, inserts, n * sizeof(int));
+    shuffle(searches, n);
+
+    if (order == ZIPF)
+    {
+        // rank r is the key inserts[r] (a random key, so frequent keys are not next to each other). Both the
+        // insertions and the searches are drawn from the distribution, so frequent keys also go in first.
+        double *cdf = zipfTable(n);
+        int *byRank = (int *)malloc(n * sizeof(int));
+        char *seen = (char *)calloc(n, 1);
+        memcpy(byRank, inserts, n * sizeof(int));
+        *distinct = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t r = zipfSample(cdf, n);
+            inserts[i] = byRank[r];
+            *distinct += !seen[r];
+            seen[r] = 1;
+            searches[i] = (int)zipfSample(cdf, n);
+        }
+        // a searched key may never have been drawn for insertion, which is only known once all of them are
+        *hits = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            *hits += seen[searches[i]];
+            searches[i] = byRank[searches[i]];
+        }
+        free(cdf);
+        free(byRank);
+        free(seen);
+    }
+}
+
+double *zipfTable(size_t n)
+{
+    // cumulative probabilities of the ranks, rank r has weight 1 / (r + 1)^s
+    double *cdf = (double *)malloc(n * sizeof(double));
+    double total = 0.0;
+    for (size_t r = 0; r < n; r++)
+    {
+        total += 1.0 / pow((double)(r + 1), ZIPF_EXPONENT);
+        cdf[r] = total;
+    }
+    for (size_t r = 0; r < n; r++)
+    {
+        cdf[r] /= total;
+    }
+    return cdf;
+}
+
+size_t zipfSample(const double *cdf, size_t n)
+{
+    // first rank whose cumulative probability reaches a uniform random number
+    double u = (double)(nextRandom() >> 11) / 9007199254740992.0;
+    size_t lo = 0;
+    size_t hi = n - 1;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cdf[mid] < u)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+double nsPerOp(clock_t start, size_t ops)
+{
+    return ops == 0 ? 0.0 : (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (double)ops;
+}
+
+uint64_t nextRandom(void)
+{
+    // xorshift64*, the same sequence on every platform unlike rand()
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return rngState * 2685821657736338717ULL;
+}
+
+void shuffle(int *a, size_t n)
+{
+    for (size_t i = n; i > 1; i--)
+    {
+        size_t j = (size_t)(nextRandom() % i);
+        int tmp = a[i - 1];
+        a[i - 1] = a[j];
+        a[j] = tmp;
+    }
+}
+
+int countingCmp(const void *a, const void *b)
+{
+    comparisons++;
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void intCopy(void *dst, const void *src)
+{
+    memcpy(dst, src, sizeof(int));
+}
+
+size_t intSize(const void *key)
+{
+    (void)key;
+    return sizeof(int);
+}
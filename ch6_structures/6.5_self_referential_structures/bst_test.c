@@ -2,8 +2,10 @@
 #include <string.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 struct bstNode *root;
+int comparisons;
 
 const char *toString(const void *key);
 size_t stralloc(const void *key);
@@ -19,6 +21,29 @@ void deleteTest();
 struct bstNode *predecessor(const char *key);
 struct bstNode *successor(const char *key);
 void delete (const char *key);
+void comparisonCountTest();
+void insertOrFindTest();
+int countingStrcmp(const void *a, const void *b);
+void deepFreeTest();
+void avlInsertTest();
+void avlDeleteTest();
+void avlIns(const char *key);
+void avlDel(const char *key);
+int checkAvl(struct bstNode *node);
+void arenaTest();
+void buildTest();
+void rankSelectTest();
+long checkSizes(struct bstNode *node);
+void rangeTest();
+void printRange(const char *low, const char *high);
+void freezeTest();
+void splayTest();
+void upsertTest();
+void statsTest();
+void setOperationsTest();
+void hintTest();
+struct bstNode *avlRange(int from, int to, int step);
+void addCount(void *count, const void *one);
 
 int main()
 {
@@ -27,6 +52,21 @@ int main()
     predecessorTest();
     successorTest();
     deleteTest();
+    comparisonCountTest();
+    insertOrFindTest();
+    deepFreeTest();
+    avlInsertTest();
+    avlDeleteTest();
+    arenaTest();
+    buildTest();
+    rankSelectTest();
+    rangeTest();
+    freezeTest();
+    splayTest();
+    upsertTest();
+    statsTest();
+    setOperationsTest();
+    hintTest();
     printf("Tests done.\n");
     return 0;
 }
@@ -141,6 +181,10 @@ void predecessorTest()
     printNode(predecessor("d")); // c
     printNode(predecessor("c")); // b
     printNode(predecessor("a")); // NULL
+    // key missing, last visited node is smaller than key but has a left subtree
+    insert("v");
+    insert("u");
+    printNode(predecessor("w")); // v
     bstFree(root);
     root = NULL;
 }
@@ -173,6 +217,10 @@ void successorTest()
     printNode(successor("d")); // e
     printNode(successor("a")); // b
     printNode(successor("A")); // a
+    // key missing, last visited node is greater than key but has a right subtree
+    insert("0");
+    insert("5");
+    printNode(successor("/")); // 0
     bstFree(root);
     root = NULL;
 }
@@ -255,6 +303,755 @@ void deleteTest() {
     root = NULL;
 }
 
+void comparisonCountTest()
+{
+    printf("Comparison Count Test\n");
+    const char *keys[] = {"k", "e", "q", "b", "g", "n", "s", "a", "c", "f", "h", "m", "o", "r", "t"};
+    for (int i = 0; i < 15; i++)
+    {
+        root = bstInsert(root, keys[i], (void (*)(void *, const void *))strcpy, stralloc, countingStrcmp);
+    }
+
+    // a leaf is on the 4th level, so each operation below compares once per level
+    comparisons = 0;
+    bstSearch(root, "h", countingStrcmp);
+    printf("%d\n", comparisons); // 4
+    comparisons = 0;
+    bstSearch(root, "p", countingStrcmp);
+    printf("%d\n", comparisons); // 4
+    comparisons = 0;
+    root = bstInsert(root, "p", (void (*)(void *, const void *))strcpy, stralloc, countingStrcmp);
+    printf("%d\n", comparisons); // 4
+    comparisons = 0;
+    root = bstInsert(root, "p", (void (*)(void *, const void *))strcpy, stralloc, countingStrcmp);
+    printf("%d\n", comparisons); // 5
+    comparisons = 0;
+    root = bstDelete(root, "p", countingStrcmp);
+    printf("%d\n", comparisons); // 5
+    comparisons = 0;
+    bstPredecessor(root, "h", countingStrcmp);
+    printf("%d\n", comparisons); // 4
+    comparisons = 0;
+    bstSuccessor(root, "h", countingStrcmp);
+    printf("%d\n", comparisons); // 4
+
+    bstFree(root);
+    root = NULL;
+}
+
+void insertOrFindTest()
+{
+    printf("Insert Or Find Test\n");
+    struct bstNode *node = NULL;
+    root = bstInsertOrFind(root, "k", (void (*)(void *, const void *))strcpy, stralloc, (int (*)(const void *, const void *))strcmp, &node);
+    printf("%d\n", node == root); // 1
+    root = bstInsertOrFind(root, "e", (void (*)(void *, const void *))strcpy, stralloc, (int (*)(const void *, const void *))strcmp, &node);
+    printNode(node);                   // e
+    printf("%d\n", node == root->left); // 1
+
+    // existing key is found, not copied again
+    struct bstNode *existing = node;
+    root = bstInsertOrFind(root, "e", (void (*)(void *, const void *))strcpy, stralloc, (int (*)(const void *, const void *))strcmp, &node);
+    printf("%d\n", node == existing); // 1
+    print();                          // e k
+
+    bstFree(root);
+    root = NULL;
+}
+
+void deepFreeTest()
+{
+    printf("Deep Free Test\n");
+    // a 1,000,000 node linked list (what sorted input produces), built directly since bstInsert would take
+    // O(n^2) time. Recursive freeing or printing would overflow the stack on this tree.
+    struct bstNode *chain = NULL;
+    for (int i = 0; i < 1000000; i++)
+    {
+        // each node is allocated by the library (its key lives in the same allocation) as a one node tree
+        struct bstNode *n = bstInsert(NULL, "x", (void (*)(void *, const void *))strcpy, stralloc, (int (*)(const void *, const void *))strcmp);
+        n->left = chain;
+        chain = n;
+    }
+    bstFree(chain);
+    chain = NULL;
+    printf("freed\n"); // freed
+}
+
+void avlInsertTest()
+{
+    printf("AVL Insert Test\n");
+    // sorted input would make a linked list with bstInsert
+    avlIns("a");
+    avlIns("b");
+    avlIns("c"); // left rotation at a
+    printNode(root); // b
+    avlIns("d");
+    avlIns("e"); // left rotation at c
+    avlIns("f"); // left rotation at b
+    avlIns("g");
+    printNode(root);          // d
+    printf("%d\n", checkAvl(root)); // 3
+    print();                  // a b c d e f g
+
+    bstFree(root);
+    root = NULL;
+
+    // reverse sorted input
+    avlIns("g");
+    avlIns("f");
+    avlIns("e");
+    avlIns("d");
+    avlIns("c");
+    avlIns("b");
+    avlIns("a");
+    printNode(root);          // d
+    printf("%d\n", checkAvl(root)); // 3
+
+    // duplicates are ignored
+    avlIns("d");
+    printf("%d\n", checkAvl(root)); // 3
+
+    bstFree(root);
+    root = NULL;
+
+    // left-right and right-left double rotations
+    avlIns("c");
+    avlIns("a");
+    avlIns("b");
+    printNode(root); // b
+    avlIns("e");
+    avlIns("d");
+    printNode(root->right); // d
+    printf("%d\n", checkAvl(root)); // 3
+
+    bstFree(root);
+    root = NULL;
+
+    // 26 sorted keys stay within the AVL height bound
+    char key[2] = "a";
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        key[0] = c;
+        avlIns(key);
+    }
+    printf("%d\n", checkAvl(root)); // 5
+    printNode(search("m"));   // m
+    printNode(predecessor("m")); // l
+    printNode(successor("m"));   // n
+
+    bstFree(root);
+    root = NULL;
+}
+
+void avlDeleteTest()
+{
+    printf("AVL Delete Test\n");
+    avlDel("a");
+    printNode(root); // NULL
+
+    char key[2] = "a";
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        key[0] = c;
+        avlIns(key);
+    }
+
+    // delete every other key, checking balance along the way
+    int balanced = 1;
+    for (char c = 'a'; c <= 'z'; c += 2)
+    {
+        key[0] = c;
+        avlDel(key);
+        balanced = balanced && checkAvl(root) > 0;
+    }
+    printf("%d\n", balanced); // 1
+    print();                  // b d f h j l n p r t v x z
+
+    // missing key leaves the tree unchanged
+    avlDel("a");
+    printf("%d\n", checkAvl(root)); // 4
+
+    // delete the root until the tree is empty
+    while (root != NULL)
+    {
+        avlDel((const char *)root->key);
+        balanced = balanced && (root == NULL || checkAvl(root) > 0);
+    }
+    printf("%d\n", balanced); // 1
+    printNode(root);          // NULL
+}
+
+void arenaTest()
+{
+    printf("Arena Test\n");
+    struct bstArena *arena = bstArenaCreate();
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    void (*cpy)(void *, const void *) = (void (*)(void *, const void *))strcpy;
+
+    // unbalanced tree in an arena
+    const char *keys[] = {"k", "e", "q", "b", "g", "n", "s"};
+    for (int i = 0; i < 7; i++)
+    {
+        root = bstArenaInsert(arena, root, keys[i], cpy, stralloc, cmp);
+    }
+    root = bstArenaDelete(arena, root, "e", cmp);
+    root = bstArenaDelete(arena, root, "k", cmp);
+    print(); // b g n q s
+
+    // AVL tree sharing the same arena, enough keys to fill several blocks
+    struct bstNode *avl = NULL;
+    char key[8];
+    for (int i = 0; i < 10000; i++)
+    {
+        sprintf(key, "%05d", i);
+        avl = avlArenaInsert(arena, avl, key, cpy, stralloc, cmp);
+    }
+    for (int i = 0; i < 10000; i += 2)
+    {
+        sprintf(key, "%05d", i);
+        avl = avlArenaDelete(arena, avl, key, cmp);
+    }
+    printf("%d\n", checkAvl(avl)); // 13
+
+    // nodes inserted one after another are next to each other in memory
+    char *a = (char *)bstSearch(avl, "00001", cmp);
+    char *b = (char *)bstSearch(avl, "00003", cmp);
+    printf("%d\n", b - a > 0 && b - a <= 128); // 1
+
+    // one call frees both trees
+    bstArenaFree(arena);
+    arena = NULL;
+    root = NULL;
+    avl = NULL;
+}
+
+void buildTest()
+{
+    printf("Build Test\n");
+    void (*cpy)(void *, const void *) = (void (*)(void *, const void *))strcpy;
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    char letters[26][2];
+    const void *keys[26];
+    for (int i = 0; i < 26; i++)
+    {
+        letters[i][0] = (char)('a' + i);
+        letters[i][1] = '\0';
+        keys[i] = letters[i];
+    }
+
+    root = bstBuildFromSorted(NULL, 0, cpy, stralloc);
+    printNode(root); // NULL
+
+    // sorted keys give a balanced tree that AVL operations keep balanced
+    root = bstBuildFromSorted(keys, 26, cpy, stralloc);
+    printNode(root);                // n
+    printf("%d\n", checkAvl(root)); // 5
+    avlIns("zz");
+    avlDel("a");
+    printf("%d\n", checkAvl(root)); // 5
+    bstFree(root);
+    root = NULL;
+
+    // unsorted keys with duplicates
+    const void *mixed[] = {"q", "c", "x", "c", "a", "m", "q", "f"};
+    root = bstBuildFromUnsorted(mixed, 8, cpy, stralloc, cmp);
+    print();                        // a c f m q x
+    printf("%d\n", checkAvl(root)); // 3
+    bstFree(root);
+    root = NULL;
+
+    // rebalance the linked list made by sorted insertion
+    char key[8];
+    for (int i = 0; i < 1000; i++)
+    {
+        sprintf(key, "%04d", i);
+        insert(key);
+    }
+    root = bstRebalance(root);
+    printf("%d\n", checkAvl(root)); // 10
+    printNode(bstMinimum(root));    // 0000
+    printNode(bstMaximum(root));    // 0999
+    bstFree(root);
+    root = NULL;
+
+    printNode(bstRebalance(NULL)); // NULL
+}
+
+void rankSelectTest()
+{
+    printf("Rank Select Test\n");
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    const char *keys[] = {"k", "e", "q", "b", "g", "n", "s", "a", "c", "f", "h", "m", "o", "r", "t"};
+    for (int i = 0; i < 15; i++)
+    {
+        insert(keys[i]);
+    }
+    insert("k"); // duplicate doesn't change sizes
+    printf("%ld\n", checkSizes(root));      // 15
+    printf("%u\n", (unsigned)bstRank(root, "a", cmp)); // 0
+    printf("%u\n", (unsigned)bstRank(root, "k", cmp)); // 7
+    printf("%u\n", (unsigned)bstRank(root, "d", cmp)); // 3
+    printf("%u\n", (unsigned)bstRank(root, "z", cmp)); // 15
+    printNode(bstSelect(root, 0));  // a
+    printNode(bstSelect(root, 7));  // k
+    printNode(bstSelect(root, 14)); // t
+    printNode(bstSelect(root, 15)); // NULL
+
+    // deletions of a leaf, a node with 1 child, a node with 2 children, the root, and a missing key
+    delete ("a");
+    delete ("b");
+    delete ("q");
+    delete ("k");
+    delete ("z");
+    printf("%ld\n", checkSizes(root));      // 11
+    printNode(bstSelect(root, 0));          // c
+    printf("%u\n", (unsigned)bstRank(root, "m", cmp)); // 5
+    bstFree(root);
+    root = NULL;
+
+    // AVL rotations keep sizes up to date, and select inverts rank
+    char key[8];
+    for (int i = 0; i < 500; i++)
+    {
+        sprintf(key, "%03d", (i * 7) % 500);
+        avlIns(key);
+    }
+    for (int i = 0; i < 500; i += 3)
+    {
+        sprintf(key, "%03d", i);
+        avlDel(key);
+    }
+    printf("%ld\n", checkSizes(root)); // 333
+    int inverse = 1;
+    for (size_t k = 0; k < 333; k++)
+    {
+        inverse = inverse && bstRank(root, bstSelect(root, k)->key, cmp) == k;
+    }
+    printf("%d\n", inverse); // 1
+    bstFree(root);
+    root = NULL;
+
+    // rebalancing a list sets sizes too
+    for (int i = 0; i < 100; i++)
+    {
+        sprintf(key, "%03d", i);
+        insert(key);
+    }
+    root = bstRebalance(root);
+    printf("%ld\n", checkSizes(root)); // 100
+    printNode(bstSelect(root, 50));    // 050
+    bstFree(root);
+    root = NULL;
+}
+
+void rangeTest()
+{
+    printf("Range Test\n");
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    const char *keys[] = {"k", "e", "q", "b", "g", "n", "s", "a", "c", "f", "h", "m", "o", "r", "t"};
+    for (int i = 0; i < 15; i++)
+    {
+        insert(keys[i]);
+    }
+
+    printRange("c", "h");   // c e f g h
+    printRange("d", "j");   // e f g h
+    printRange("p", NULL);  // q r s t
+    printRange(NULL, "b");  // a b
+    printRange("u", "z");   //
+    printRange("h", "c");   //
+    printf("%u\n", (unsigned)bstRangeCount(root, "c", "h", cmp));   // 5
+    printf("%u\n", (unsigned)bstRangeCount(root, "d", "j", cmp));   // 4
+    printf("%u\n", (unsigned)bstRangeCount(root, NULL, NULL, cmp)); // 15
+    printf("%u\n", (unsigned)bstRangeCount(root, "h", "c", cmp));   // 0
+
+    // a full scan compares once per node for the high bound, not once per level
+    comparisons = 0;
+    struct bstCursor *cursor = bstRangeOpen(root, NULL, "z", countingStrcmp);
+    int visited = 0;
+    while (bstRangeNext(cursor) != NULL)
+    {
+        visited++;
+    }
+    bstRangeClose(cursor);
+    cursor = NULL;
+    printf("%d %d\n", visited, comparisons); // 15 15
+
+    bstFree(root);
+    root = NULL;
+    printRange(NULL, NULL); //
+}
+
+void freezeTest()
+{
+    printf("Freeze Test\n");
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    void (*cpy)(void *, const void *) = (void (*)(void *, const void *))strcpy;
+
+    struct bstSnapshot *snapshot = bstFreeze(NULL, cpy, stralloc);
+    printf("%p\n", bstFrozenSearch(snapshot, "a", cmp)); // (nil)
+    bstFrozenFree(snapshot);
+
+    const char *keys[] = {"k", "e", "q", "b", "g", "n", "s", "a", "c", "f", "h", "m", "o", "r", "t"};
+    for (int i = 0; i < 15; i++)
+    {
+        insert(keys[i]);
+    }
+    snapshot = bstFreeze(root, cpy, stralloc);
+    // the snapshot is independent of the tree
+    bstFree(root);
+    root = NULL;
+
+    printf("%s\n", (const char *)bstFrozenSearch(snapshot, "g", cmp));      // g
+    printf("%p\n", bstFrozenSearch(snapshot, "d", cmp));                    // (nil)
+    printf("%s\n", (const char *)bstFrozenPredecessor(snapshot, "g", cmp)); // f
+    printf("%s\n", (const char *)bstFrozenPredecessor(snapshot, "d", cmp)); // c
+    printf("%s\n", (const char *)bstFrozenSuccessor(snapshot, "g", cmp));   // h
+    printf("%s\n", (const char *)bstFrozenSuccessor(snapshot, "i", cmp));   // k
+    printf("%p\n", bstFrozenPredecessor(snapshot, "a", cmp));               // (nil)
+    printf("%p\n", bstFrozenSuccessor(snapshot, "t", cmp));                 // (nil)
+    bstFrozenFree(snapshot);
+    snapshot = NULL;
+
+    // an incomplete last level, checked against the tree for every key and every gap between keys
+    char key[8];
+    for (int i = 0; i < 1000; i += 2)
+    {
+        sprintf(key, "%04d", i);
+        avlIns(key);
+    }
+    snapshot = bstFreeze(root, cpy, stralloc);
+    int same = 1;
+    for (int i = -1; i <= 1000; i++)
+    {
+        sprintf(key, "%04d", i);
+        struct bstNode *p = bstPredecessor(root, key, cmp);
+        struct bstNode *s = bstSuccessor(root, key, cmp);
+        const char *fp = bstFrozenPredecessor(snapshot, key, cmp);
+        const char *fs = bstFrozenSuccessor(snapshot, key, cmp);
+        same = same && (p == NULL ? fp == NULL : fp != NULL && strcmp(p->key, fp) == 0);
+        same = same && (s == NULL ? fs == NULL : fs != NULL && strcmp(s->key, fs) == 0);
+        same = same && (bstFrozenSearch(snapshot, key, cmp) != NULL) == (i >= 0 && i < 1000 && i % 2 == 0);
+    }
+    printf("%d\n", same); // 1
+    bstFrozenFree(snapshot);
+    snapshot = NULL;
+    bstFree(root);
+    root = NULL;
+}
+
+void splayTest()
+{
+    printf("Splay Test\n");
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    size_t depth = 0;
+    printf("%p\n", (void *)bstSplay(NULL, "a", cmp, &depth)); // (nil)
+    printf("%u\n", (unsigned)depth);                          // 0
+
+    // keys inserted in order make a path, the last key is at depth 499
+    char key[8];
+    for (int i = 0; i < 500; i++)
+    {
+        sprintf(key, "%03d", i);
+        insert(key);
+    }
+    root = bstSplay(root, "499", cmp, &depth);
+    printNode(root);                   // 499
+    printf("%u\n", (unsigned)depth);   // 499
+    root = bstSplay(root, "499", cmp, &depth);
+    printf("%u\n", (unsigned)depth);   // 0
+
+    // a missing key brings up the last node searched
+    root = bstSplay(root, "250x", cmp, &depth);
+    printNode(root); // 251
+    root = bstSplay(root, "000", cmp, NULL);
+    printNode(root); // 000
+
+    // 9 of every 10 searches go to 5 hot keys, which end up near the root
+    size_t hotDepth = 0;
+    for (int i = 0; i < 10000; i++)
+    {
+        sprintf(key, "%03d", i % 10 == 9 ? (i * 37) % 500 : 100 * (i % 5));
+        root = bstSplay(root, key, cmp, &depth);
+        if (i >= 9000 && i % 10 != 9)
+        {
+            hotDepth += depth;
+        }
+    }
+    printf("%d\n", hotDepth < 900 * 5); // 1 (average depth of a hot key under 5)
+
+    // the rotations keep the sizes, and the order, intact
+    printf("%ld\n", checkSizes(root)); // 500
+    int inOrder = 1;
+    for (int i = 0; i < 500; i++)
+    {
+        sprintf(key, "%03d", i);
+        inOrder = inOrder && strcmp(bstSelect(root, i)->key, key) == 0;
+    }
+    printf("%d\n", inOrder); // 1
+    bstFree(root);
+    root = NULL;
+}
+
+void upsertTest()
+{
+    printf("Upsert Test\n");
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    void (*cpy)(void *, const void *) = (void (*)(void *, const void *))strcpy;
+
+    // word frequencies, one descent per word
+    const char *text[] = {"the", "cat", "and", "the", "hat", "and", "the", "bat", "the", "end"};
+    for (int i = 0; i < 10; i++)
+    {
+        root = bstUpsert(root, text[i], &(int){1}, sizeof(int), cpy, stralloc, cmp, addCount);
+    }
+    printf("%u\n", (unsigned)root->size); // 6
+    for (struct bstNode *n = bstMinimum(root); n != NULL; n = bstSuccessor(root, n->key, cmp))
+    {
+        printf("%s %d\n", (const char *)n->key, *(int *)n->value);
+    }
+    // and 2, bat 1, cat 1, end 1, hat 1, the 4
+
+    // values stay with their keys when nodes move in a deletion
+    delete ("the");
+    delete ("cat");
+    printf("%d\n", *(int *)search("and")->value); // 2
+    printf("%d\n", *(int *)search("hat")->value); // 1
+    bstFree(root);
+    root = NULL;
+
+    // set nodes have no value, also when inserted by an upsert without one
+    insert("x");
+    printf("%p\n", root->value); // (nil)
+    root = bstUpsert(root, "y", NULL, 0, cpy, stralloc, cmp, addCount);
+    printf("%p\n", search("y")->value); // (nil)
+    bstFree(root);
+    root = NULL;
+}
+
+void statsTest()
+{
+    printf("Stats Test\n");
+    struct bstStatistics stats = bstStats(NULL);
+    printf("%u %u %u %.2f\n", (unsigned)stats.nodes, (unsigned)stats.height, (unsigned)stats.minHeight, stats.averageDepth); // 0 0 0 0.00
+
+    // perfect tree of 15 keys: depths 0, 1 (x2), 2 (x4), 3 (x8)
+    const char *keys[] = {"k", "e", "q", "b", "g", "n", "s", "a", "c", "f", "h", "m", "o", "r", "t"};
+    for (int i = 0; i < 15; i++)
+    {
+        insert(keys[i]);
+    }
+    stats = bstStats(root);
+    printf("%u %u %u %.2f\n", (unsigned)stats.nodes, (unsigned)stats.height, (unsigned)stats.minHeight, stats.averageDepth); // 15 4 4 2.27
+    print(); // unchanged by the traversal
+    bstFree(root);
+    root = NULL;
+
+    // sorted insertions make a path
+    char key[8];
+    for (int i = 0; i < 100; i++)
+    {
+        sprintf(key, "%03d", i);
+        insert(key);
+    }
+    stats = bstStats(root);
+    printf("%u %u %u %.2f\n", (unsigned)stats.nodes, (unsigned)stats.height, (unsigned)stats.minHeight, stats.averageDepth); // 100 100 7 49.50
+    bstFree(root);
+    root = NULL;
+}
+
+void setOperationsTest()
+{
+    printf("Set Operations Test\n");
+    int (*cmp)(const void *, const void *) = (int (*)(const void *, const void *))strcmp;
+    char key[8];
+
+    // split at a key in the tree, and at a key that is not
+    root = avlRange(0, 100, 1);
+    struct bstNode *left = NULL;
+    struct bstNode *right = NULL;
+    struct bstNode *found = avlSplit(root, "050", cmp, &left, &right);
+    printNode(found); // 050
+    printf("%ld %ld %d %d\n", checkSizes(left), checkSizes(right), checkAvl(left) > 0, checkAvl(right) > 0); // 50 49 1 1
+    root = avlJoin(left, found, right);
+    printf("%ld %d\n", checkSizes(root), checkAvl(root) > 0); // 100 1
+    found = avlSplit(root, "050x", cmp, &left, &right);
+    printf("%p %ld %ld\n", (void *)found, checkSizes(left), checkSizes(right)); // (nil) 51 49
+    bstFree(left);
+    bstFree(right);
+
+    // multiples of 2 and of 3 below 600, and trees of very different sizes
+    struct bstNode *u = avlUnion(avlRange(0, 600, 2), avlRange(0, 600, 3), cmp);
+    struct bstNode *in = avlIntersection(avlRange(0, 600, 2), avlRange(0, 600, 3), cmp);
+    struct bstNode *d = avlDifference(avlRange(0, 600, 2), avlRange(0, 600, 3), cmp);
+    struct bstNode *small = avlUnion(avlRange(0, 600, 1), avlRange(595, 605, 1), cmp);
+    printf("%ld %ld %ld %ld\n", checkSizes(u), checkSizes(in), checkSizes(d), checkSizes(small)); // 400 100 200 605
+    printf("%d %d %d %d\n", checkAvl(u) > 0, checkAvl(in) > 0, checkAvl(d) > 0, checkAvl(small) > 0); // 1 1 1 1
+    int ok = 1;
+    for (int i = 0; i < 600; i++)
+    {
+        sprintf(key, "%03d", i);
+        ok = ok && (bstSearch(u, key, cmp) != NULL && strcmp(bstSearch(u, key, cmp)->key, key) == 0) == (i % 2 == 0 || i % 3 == 0);
+        ok = ok && (strcmp(bstSelect(in, i / 6)->key, key) == 0) == (i % 6 == 0);
+        ok = ok && (bstSearch(d, key, cmp) != NULL && strcmp(bstSearch(d, key, cmp)->key, key) == 0) == (i % 2 == 0 && i % 3 != 0);
+    }
+    printf("%d\n", ok); // 1
+    bstFree(u);
+    bstFree(in);
+    bstFree(d);
+    bstFree(small);
+
+    // empty trees
+    printf("%p\n", (void *)avlIntersection(avlRange(0, 10, 1), NULL, cmp)); // (nil)
+    d = avlDifference(avlRange(0, 10, 1), NULL, cmp);
+    printf("%ld\n", checkSizes(d)); // 10
+    bstFree(d);
+    root = NULL;
+}
+
+void hintTest()
+{
+    printf("Hint Test\n");
+    void (*cpy)(void *, const void *) = (void (*)(void *, const void *))strcpy;
+    char key[12];
+
+    // sorted keys: each goes right after the last one, without a descent from the root
+    struct bstHint *hint = bstHintCreate();
+    comparisons = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        sprintf(key, "%04d", i);
+        root = avlInsertHint(hint, root, key, cpy, stralloc, countingStrcmp, NULL);
+    }
+    printf("%ld %d %d\n", checkSizes(root), checkAvl(root) > 0, comparisons < 3 * 1000); // 1000 1 1
+    int hinted = comparisons;
+    struct bstNode *plain = NULL;
+    comparisons = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        sprintf(key, "%04d", i);
+        plain = avlInsert(plain, key, cpy, stralloc, countingStrcmp);
+    }
+    printf("%d\n", hinted * 3 < comparisons); // 1
+    bstFree(plain);
+
+    // a key already there is found, wherever it is
+    struct bstNode *node = NULL;
+    root = avlInsertHint(hint, root, "0500", cpy, stralloc, countingStrcmp, &node);
+    printf("%s %ld\n", (const char *)node->key, checkSizes(root)); // 0500 1000
+    root = avlInsertHint(hint, root, "0999", cpy, stralloc, countingStrcmp, &node);
+    printf("%s %ld\n", (const char *)node->key, checkSizes(root)); // 0999 1000
+
+    // nearly sorted: runs in both directions, jumps back, and keys between existing ones
+    int ok = 1;
+    for (int i = 0; i < 3000; i++)
+    {
+        int k = i % 7 == 0 ? (i * 37) % 1000 : (i % 2 == 0 ? i : 3000 - i);
+        sprintf(key, "%04d%c", k, i % 3 == 0 ? 'x' : '\0');
+        root = avlInsertHint(hint, root, key, cpy, stralloc, countingStrcmp, &node);
+        ok = ok && strcmp(node->key, key) == 0;
+    }
+    int n = 0;
+    for (struct bstNode *k = bstMinimum(root); k != NULL; k = successor(k->key))
+    {
+        n++;
+    }
+    printf("%d %d %d %d\n", ok, checkAvl(root) > 0, checkSizes(root) == n, n > 1000); // 1 1 1 1
+
+    // after a deletion the hint starts over, the same works on an unbalanced BST
+    avlDel("0998");
+    bstHintReset(hint);
+    root = avlInsertHint(hint, root, "0998", cpy, stralloc, countingStrcmp, &node);
+    printf("%s %d %d\n", (const char *)node->key, checkAvl(root) > 0, checkSizes(root) == n); // 0998 1 1
+    bstFree(root);
+    root = NULL;
+    const char *words[] = {"b", "d", "f", "e", "a", "c", "g"};
+    for (int i = 0; i < 7; i++)
+    {
+        root = bstInsertHint(hint, root, words[i], cpy, stralloc, countingStrcmp, NULL);
+    }
+    print(); // a b c d e f g
+    printf("%s %s %ld\n", (const char *)root->key, (const char *)root->right->right->left->key, checkSizes(root)); // b e 7
+    bstHintFree(hint);
+    bstFree(root);
+    root = NULL;
+}
+
+struct bstNode *avlRange(int from, int to, int step)
+{
+    // AVL tree of the numbers from, from + step, ... below to as 3 digit strings
+    struct bstNode *saved = root;
+    char key[12];
+    root = NULL;
+    for (int i = from; i < to; i += step)
+    {
+        sprintf(key, "%03d", i);
+        avlIns(key);
+    }
+    struct bstNode *t = root;
+    root = saved;
+    return t;
+}
+
+void printRange(const char *low, const char *high)
+{
+    struct bstCursor *cursor = bstRangeOpen(root, low, high, (int (*)(const void *, const void *))strcmp);
+    struct bstNode *n = NULL;
+    while ((n = bstRangeNext(cursor)) != NULL)
+    {
+        printf("%s ", (const char *)n->key);
+    }
+    printf("\n");
+    bstRangeClose(cursor);
+}
+
+// returns the number of nodes in a tree, or -1 if a size field is wrong
+long checkSizes(struct bstNode *node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    long l = checkSizes(node->left);
+    long r = checkSizes(node->right);
+    if (l < 0 || r < 0 || (size_t)(l + r + 1) != node->size)
+    {
+        return -1;
+    }
+    return l + r + 1;
+}
+
+void avlIns(const char *key)
+{
+    root = avlInsert(root, (const void *)key, (void (*)(void *, const void *))strcpy, stralloc, (int (*)(const void *, const void *))strcmp);
+}
+
+void avlDel(const char *key)
+{
+    root = avlDelete(root, (const void *)key, (int (*)(const void *, const void *))strcmp);
+}
+
+// returns the height of an AVL tree, or -1 if a height is wrong, a node is unbalanced, or the order is wrong
+int checkAvl(struct bstNode *node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    int lh = checkAvl(node->left);
+    int rh = checkAvl(node->right);
+    if (lh < 0 || rh < 0 || lh - rh > 1 || rh - lh > 1)
+    {
+        return -1;
+    }
+    if ((node->left != NULL && strcmp(node->left->key, node->key) >= 0) || (node->right != NULL && strcmp(node->right->key, node->key) <= 0))
+    {
+        return -1;
+    }
+    int h = (lh > rh ? lh : rh) + 1;
+    return h == node->height ? h : -1;
+}
+
 void insert(const char *key)
 {
     root = bstInsert(root, (const void *)key, (void (*)(void *, const void *))strcpy, stralloc, (int (*)(const void *, const void *))strcmp);
@@ -298,6 +1095,12 @@ void printNode(struct bstNode *n)
     }
 }
 
+int countingStrcmp(const void *a, const void *b)
+{
+    comparisons++;
+    return strcmp((const char *)a, (const char *)b);
+}
+
 const char *toString(const void *key)
 {
     return (const char *)key;
@@ -306,4 +1109,9 @@ const char *toString(const void *key)
 size_t stralloc(const void *key)
 {
     return strlen((const char *)key) + 1;
-}
\ No newline at end of file
+}
+
+void addCount(void *count, const void *one)
+{
+    *(int *)count += *(const int *)one;
+}
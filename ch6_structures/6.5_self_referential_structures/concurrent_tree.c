@@ -0,0 +1,964 @@
+/*
+    Contains implementation of the concurrent ordered set declared in concurrent_tree.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    The nodes are laid out as in bplus_tree.c, except that a full node is split on the way down by an insertion
+    (before descending into it), so a split only ever changes the node and its parent, and the parent is never
+    full.
+
+    Version protocol (optimistic lock coupling): a node's version is even while it is unlocked and odd while a
+    writer holds it. A reader records the version before reading a node and validates it is unchanged after,
+    and keeps the parent's version valid until it has the child's version, so that a split between reading the
+    child pointer and reading the child is noticed. Any failed validation restarts the operation from the root.
+    Writers lock a node by moving its version from a validated even value to the next odd value, so the lock
+    also checks that nothing changed since the node was read.
+
+    Since readers read nodes while writers change them, everything in a node that a writer changes (the count,
+    the children, and the key bytes) is an atomic uintptr_t word accessed with relaxed loads and stores, and
+    the version's fences order them. A key takes a whole number of words, and is copied out of its words into
+    a scratch buffer before it is compared.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "concurrent_tree.h" // needed for concurrent tree operations
+#include <stdatomic.h>       // needed for atomic operations and fences
+#include <stdint.h>          // needed for uint64_t, uintptr_t
+#include <stdlib.h>          // needed for malloc(), free()
+#include <stddef.h>          // needed for size_t
+#include <string.h>          // needed for memcpy()
+
+// ***************************** CONSTANTS ***********************************************
+
+#define MIN_NODE_BYTES 256  // smallest allowed node size (4 cache lines)
+#define MAX_NODE_BYTES 4096 // largest allowed node size (a page), unless keys are too big to fit 4 per node
+#define MIN_NODE_KEYS 4     // fewest keys a node must be able to hold
+#define LOCAL_KEY_WORDS 8   // keys of up to this many words are compared through a buffer on the stack
+
+// kinds of leaf search done by seek()
+#define SEEK_EQ 0 // key equal to the probe
+#define SEEK_GE 1 // first key >= the probe (the minimum if the probe is NULL)
+#define SEEK_GT 2 // first key > the probe
+#define SEEK_LT 3 // last key < the probe (the maximum if the probe is NULL)
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a node of the tree.
+
+    Fields:
+        version (_Atomic uint64_t) : version number, odd while a writer holds the node
+        isLeaf (int) : 1 for a leaf, 0 for an internal node (set before the node is shared, never changed)
+        count (_Atomic int) : number of keys in the node
+        data (_Atomic uintptr_t []) : a leaf's keys, or an internal node's children followed by its keys, each
+            key taking keyWords words (flexible array member, see getChild() and keySlot())
+*/
+struct CTreeNode
+{
+    _Atomic uint64_t version;
+    int isLeaf;
+    _Atomic int count;
+    _Atomic uintptr_t data[];
+};
+
+/*
+    Structure that represents a concurrent tree.
+
+    Fields:
+        root (_Atomic(struct CTreeNode *)) : root node, replaced when the root is split
+        comp (int (*) (const void *, const void *)) : key comparison function
+        keySize (size_t) : size of every key
+        keyWords (size_t) : number of words every key is stored in
+        nodeBytes (size_t) : size of every node
+        leafCap (int) : maximum number of keys in a leaf
+        innerCap (int) : maximum number of keys in an internal node
+        count (atomic_size_t) : number of keys
+*/
+struct ConcurrentTree
+{
+    _Atomic(struct CTreeNode *) root;
+    int (*comp)(const void *, const void *);
+    size_t keySize;
+    size_t keyWords;
+    size_t nodeBytes;
+    int leafCap;
+    int innerCap;
+    atomic_size_t count;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Version operations.
+
+        readLock() : returns the version of an unlocked node, sets *restart if the node is locked
+        validate() : sets *restart if the version of a node is no longer v (everything read from the node
+            since readLock() returned v is then unusable)
+        upgradeLock() : locks a node if its version is still v, sets *restart otherwise
+        writeUnlock() : unlocks a node locked by upgradeLock(), moving it to a new even version
+
+    Parameters:
+        n (struct CTreeNode *) : pointer to the node
+        v (uint64_t) : version returned by readLock()
+        restart (int *) : pointer to the restart flag
+
+    Runtime: O(1)
+*/
+static uint64_t readLock(struct CTreeNode *n, int *restart);
+static void validate(struct CTreeNode *n, uint64_t v, int *restart);
+static void upgradeLock(struct CTreeNode *n, uint64_t v, int *restart);
+static void writeUnlock(struct CTreeNode *n);
+
+/*
+    Allocates an empty, unlocked node.
+
+    Parameters:
+        t (const ConcurrentTree *) : pointer to the tree the node is for
+        isLeaf (int) : 1 for a leaf, 0 for an internal node
+
+    Runtime: O(1)
+*/
+static struct CTreeNode *createNode(const ConcurrentTree *t, int isLeaf);
+
+/*
+    Node access helpers. Each word is read or written with one relaxed atomic access, so a reader racing a
+    writer sees some mix of old and new words, which the version check then throws away.
+
+        getChild(), setChild() : read or write the i-th child of an internal node
+        nodeCount(), setCount() : read or write the number of keys of a node
+        keySlot() : returns the first word of the i-th key of a node
+        loadKey() : copies the keySize bytes of the i-th key of a node into out
+        storeKey() : copies keySize bytes from key into the i-th key of a node (the padding is zeroed)
+        moveKeys(), moveChildren() : copy count keys (children) from index from of src to index to of dst,
+            which may be the same node (the ranges may overlap, as with memmove())
+
+    Parameters:
+        t (const ConcurrentTree *) : pointer to the tree the nodes are in
+        n, dst, src (struct CTreeNode *) : pointers to the nodes
+        i, to, from (int) : indices of keys or children
+        c (struct CTreeNode *) : child to write
+        count (int) : number of keys (children) to write or copy
+        out (void *) : where a key is copied
+        key (const void *) : key to copy
+
+    Runtime: O(1) except loadKey() and storeKey() (O(keySize)), and moveKeys() and moveChildren() (O(count))
+*/
+static struct CTreeNode *getChild(const struct CTreeNode *n, int i);
+static void setChild(struct CTreeNode *n, int i, struct CTreeNode *c);
+static int nodeCount(const struct CTreeNode *n);
+static void setCount(struct CTreeNode *n, int count);
+static _Atomic uintptr_t *keySlot(const ConcurrentTree *t, const struct CTreeNode *n, int i);
+static void loadKey(const ConcurrentTree *t, const struct CTreeNode *n, int i, void *out);
+static void storeKey(const ConcurrentTree *t, struct CTreeNode *n, int i, const void *key);
+static void moveKeys(const ConcurrentTree *t, struct CTreeNode *dst, int to, const struct CTreeNode *src, int from, int count);
+static void moveChildren(struct CTreeNode *dst, int to, const struct CTreeNode *src, int from, int count);
+
+/*
+    Returns a buffer for one key: local (which holds LOCAL_KEY_WORDS words) if the key fits, otherwise an
+    allocated buffer that freeScratch() frees.
+
+    Parameters:
+        t (const ConcurrentTree *) : pointer to the tree
+        local (uintptr_t *) : buffer of LOCAL_KEY_WORDS words on the caller's stack
+        scratch (void *) : buffer returned by scratchBuffer()
+
+    Runtime: O(1)
+*/
+static void *scratchBuffer(const ConcurrentTree *t, uintptr_t *local);
+static void freeScratch(void *scratch, uintptr_t *local);
+
+/*
+    Binary search the first count keys of a node.
+
+    Parameters:
+        t (const ConcurrentTree *) : pointer to the tree the node is in
+        n (const struct CTreeNode *) : pointer to the node
+        count (int) : number of keys to search
+        key (const void *) : the key being searched for
+        scratch (void *) : buffer the node's keys are copied into to be compared (see scratchBuffer())
+
+    Output:
+        lowerBound() : index of the first key >= key (count if there is none)
+        upperBound() : index of the first key > key (count if there is none), which is also the index of the
+            child of an internal node to search for key
+
+    Runtime: O(log(B))
+*/
+static int lowerBound(const ConcurrentTree *t, const struct CTreeNode *n, int count, const void *key, void *scratch);
+static int upperBound(const ConcurrentTree *t, const struct CTreeNode *n, int count, const void *key, void *scratch);
+
+/*
+    Descends to a leaf and searches it, restarting until a consistent result is read.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        probe (const void *) : key to search for (NULL means below every key for SEEK_GE, and above every key
+            for SEEK_LT)
+        mode (int) : one of the SEEK_ constants
+        out (void *) : where the key found is copied (may be NULL)
+        fence (void *) : where the separator bounding the leaf on the side of the search is copied (the
+            separator after the leaf, or before it for SEEK_LT)
+        hasFence (int *) : set to whether there is such a separator
+
+    Output:
+        1 if the leaf has a key matching the search, 0 otherwise. When it doesn't, the search continues past the
+        fence: every key beyond the leaf in the direction of the search is on the far side of the fence.
+
+    Runtime: O(log(n))
+*/
+static int seek(ConcurrentTree *t, const void *probe, int mode, void *out, void *fence, int *hasFence);
+
+/*
+    Runs seek() from leaf to leaf, past empty leaves, until a key is found or the fences run out.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        key (const void *) : probe for the first seek() (may be NULL)
+        mode (int) : SEEK_GE, SEEK_GT, or SEEK_LT
+        out (void *) : where the key found is copied
+
+    Output:
+        1 if a key was found, 0 otherwise.
+
+    Runtime: O(log(n)) per leaf visited
+*/
+static int seekAcross(ConcurrentTree *t, const void *key, int mode, void *out);
+
+/*
+    Splits a full locked node in two, moving its upper half to a new node.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        n (struct CTreeNode *) : the node
+        sep (void *) : where the separator for the new node is copied
+
+    Output:
+        A pointer to the new right sibling of n.
+
+    Runtime: O(B)
+*/
+static struct CTreeNode *splitNode(ConcurrentTree *t, struct CTreeNode *n, void *sep);
+
+/*
+    Adds a separator and the child to its right to a locked internal node that is not full.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        p (struct CTreeNode *) : the internal node
+        sep (const void *) : the separator
+        right (struct CTreeNode *) : the child
+        scratch (void *) : buffer for comparing keys (see scratchBuffer())
+
+    Runtime: O(B)
+*/
+static void insertChild(ConcurrentTree *t, struct CTreeNode *p, const void *sep, struct CTreeNode *right, void *scratch);
+
+/*
+    Frees a node and every node below it.
+
+    Parameters:
+        n (struct CTreeNode *) : the node
+
+    Runtime: O(# nodes in the subtree)
+*/
+static void freeNode(struct CTreeNode *n);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+ConcurrentTree *ctreeCreate(size_t keySize, int (*comp)(const void *, const void *), size_t nodeBytes)
+{
+    if (keySize == 0)
+    {
+        return NULL;
+    }
+    if (nodeBytes < MIN_NODE_BYTES)
+    {
+        nodeBytes = MIN_NODE_BYTES;
+    }
+    if (nodeBytes > MAX_NODE_BYTES)
+    {
+        nodeBytes = MAX_NODE_BYTES;
+    }
+    // keys and children are stored in words
+    size_t ptr = sizeof(uintptr_t);
+    size_t keyWords = (keySize + ptr - 1) / ptr;
+    size_t keyBytes = keyWords * ptr;
+    while ((nodeBytes - sizeof(struct CTreeNode) - ptr) / (keyBytes + ptr) < MIN_NODE_KEYS)
+    {
+        nodeBytes *= 2;
+    }
+    size_t avail = nodeBytes - sizeof(struct CTreeNode);
+
+    ConcurrentTree *t = (ConcurrentTree *)malloc(sizeof(ConcurrentTree));
+    t->comp = comp;
+    t->keySize = keySize;
+    t->keyWords = keyWords;
+    t->nodeBytes = nodeBytes;
+    t->leafCap = (int)(avail / keyBytes);
+    t->innerCap = (int)((avail - ptr) / (keyBytes + ptr));
+    atomic_init(&t->count, 0);
+    atomic_init(&t->root, createNode(t, 1));
+    return t;
+}
+
+int ctreeSearch(ConcurrentTree *t, const void *key)
+{
+    int hasFence;
+    return seek(t, key, SEEK_EQ, NULL, NULL, &hasFence);
+}
+
+int ctreeMinimum(ConcurrentTree *t, void *out)
+{
+    return seekAcross(t, NULL, SEEK_GE, out);
+}
+
+int ctreeMaximum(ConcurrentTree *t, void *out)
+{
+    return seekAcross(t, NULL, SEEK_LT, out);
+}
+
+int ctreePredecessor(ConcurrentTree *t, const void *key, void *out)
+{
+    return seekAcross(t, key, SEEK_LT, out);
+}
+
+int ctreeSuccessor(ConcurrentTree *t, const void *key, void *out)
+{
+    return seekAcross(t, key, SEEK_GT, out);
+}
+
+int ctreeInsert(ConcurrentTree *t, const void *key)
+{
+    char *sep = (char *)malloc(t->keySize);
+    uintptr_t local[LOCAL_KEY_WORDS];
+    void *scratch = scratchBuffer(t, local);
+    int restart;
+    struct CTreeNode *node = NULL;
+    struct CTreeNode *parent = NULL;
+    uint64_t v = 0;
+    uint64_t pv = 0;
+
+    while (1)
+    {
+        restart = 0;
+        parent = NULL;
+        node = atomic_load_explicit(&t->root, memory_order_acquire);
+        v = readLock(node, &restart);
+        if (restart || node != atomic_load_explicit(&t->root, memory_order_acquire))
+        {
+            continue;
+        }
+
+        while (1)
+        {
+            // split a full node before going into it, so its parent always has room for a separator
+            if (nodeCount(node) == (node->isLeaf ? t->leafCap : t->innerCap))
+            {
+                if (parent != NULL)
+                {
+                    upgradeLock(parent, pv, &restart);
+                    if (restart)
+                    {
+                        break;
+                    }
+                }
+                upgradeLock(node, v, &restart);
+                if (restart)
+                {
+                    if (parent != NULL)
+                    {
+                        writeUnlock(parent);
+                    }
+                    break;
+                }
+                // a node without a parent must still be the root, or another split has given it a parent
+                if (parent == NULL && node != atomic_load_explicit(&t->root, memory_order_acquire))
+                {
+                    writeUnlock(node);
+                    restart = 1;
+                    break;
+                }
+
+                struct CTreeNode *right = splitNode(t, node, sep);
+                if (parent != NULL)
+                {
+                    insertChild(t, parent, sep, right, scratch);
+                }
+                else
+                {
+                    // the tree grows a level, the new root is complete before other threads can see it
+                    struct CTreeNode *newRoot = createNode(t, 0);
+                    setChild(newRoot, 0, node);
+                    setChild(newRoot, 1, right);
+                    storeKey(t, newRoot, 0, sep);
+                    setCount(newRoot, 1);
+                    atomic_store_explicit(&t->root, newRoot, memory_order_release);
+                }
+                writeUnlock(node);
+                if (parent != NULL)
+                {
+                    writeUnlock(parent);
+                }
+                // start over in the tree with the split done
+                restart = 1;
+                break;
+            }
+
+            if (node->isLeaf)
+            {
+                break;
+            }
+
+            // lock coupling: the parent stays valid until the child's version has been read
+            if (parent != NULL)
+            {
+                validate(parent, pv, &restart);
+                if (restart)
+                {
+                    break;
+                }
+            }
+            parent = node;
+            pv = v;
+            node = getChild(parent, upperBound(t, parent, nodeCount(parent), key, scratch));
+            validate(parent, pv, &restart);
+            if (restart)
+            {
+                break;
+            }
+            v = readLock(node, &restart);
+            if (restart)
+            {
+                break;
+            }
+        }
+        if (restart)
+        {
+            continue;
+        }
+
+        // node is a leaf with room for the key
+        upgradeLock(node, v, &restart);
+        if (restart)
+        {
+            continue;
+        }
+        if (parent != NULL)
+        {
+            validate(parent, pv, &restart);
+            if (restart)
+            {
+                writeUnlock(node);
+                continue;
+            }
+        }
+        break;
+    }
+
+    int count = nodeCount(node);
+    int pos = lowerBound(t, node, count, key, scratch);
+    int inserted = 1;
+    if (pos < count)
+    {
+        loadKey(t, node, pos, scratch);
+        inserted = (*t->comp)(scratch, key) != 0;
+    }
+    if (inserted)
+    {
+        moveKeys(t, node, pos + 1, node, pos, count - pos);
+        storeKey(t, node, pos, key);
+        setCount(node, count + 1);
+        atomic_fetch_add_explicit(&t->count, 1, memory_order_relaxed);
+    }
+    writeUnlock(node);
+    freeScratch(scratch, local);
+    free((void *)sep);
+    return inserted;
+}
+
+int ctreeDelete(ConcurrentTree *t, const void *key)
+{
+    uintptr_t local[LOCAL_KEY_WORDS];
+    void *scratch = scratchBuffer(t, local);
+    int restart;
+    struct CTreeNode *node = NULL;
+    struct CTreeNode *parent = NULL;
+    uint64_t v = 0;
+    uint64_t pv = 0;
+
+    while (1)
+    {
+        restart = 0;
+        parent = NULL;
+        node = atomic_load_explicit(&t->root, memory_order_acquire);
+        v = readLock(node, &restart);
+        if (restart || node != atomic_load_explicit(&t->root, memory_order_acquire))
+        {
+            continue;
+        }
+        while (!node->isLeaf)
+        {
+            if (parent != NULL)
+            {
+                validate(parent, pv, &restart);
+                if (restart)
+                {
+                    break;
+                }
+            }
+            parent = node;
+            pv = v;
+            node = getChild(parent, upperBound(t, parent, nodeCount(parent), key, scratch));
+            validate(parent, pv, &restart);
+            if (restart)
+            {
+                break;
+            }
+            v = readLock(node, &restart);
+            if (restart)
+            {
+                break;
+            }
+        }
+        if (restart)
+        {
+            continue;
+        }
+
+        // only the leaf changes (nodes are never merged), the parent just has to still lead to it
+        upgradeLock(node, v, &restart);
+        if (restart)
+        {
+            continue;
+        }
+        if (parent != NULL)
+        {
+            validate(parent, pv, &restart);
+            if (restart)
+            {
+                writeUnlock(node);
+                continue;
+            }
+        }
+        break;
+    }
+
+    int count = nodeCount(node);
+    int pos = lowerBound(t, node, count, key, scratch);
+    int deleted = 0;
+    if (pos < count)
+    {
+        loadKey(t, node, pos, scratch);
+        deleted = (*t->comp)(scratch, key) == 0;
+    }
+    if (deleted)
+    {
+        setCount(node, count - 1);
+        moveKeys(t, node, pos, node, pos + 1, count - 1 - pos);
+        atomic_fetch_sub_explicit(&t->count, 1, memory_order_relaxed);
+    }
+    writeUnlock(node);
+    freeScratch(scratch, local);
+    return deleted;
+}
+
+size_t ctreeSize(ConcurrentTree *t)
+{
+    return atomic_load_explicit(&t->count, memory_order_relaxed);
+}
+
+void ctreeFree(ConcurrentTree *t)
+{
+    freeNode(atomic_load(&t->root));
+    free((void *)t);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static uint64_t readLock(struct CTreeNode *n, int *restart)
+{
+    uint64_t v = atomic_load_explicit(&n->version, memory_order_acquire);
+    if (v & 1)
+    {
+        *restart = 1;
+    }
+    return v;
+}
+
+static void validate(struct CTreeNode *n, uint64_t v, int *restart)
+{
+    // reads of the node's contents must not move past the version check
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&n->version, memory_order_relaxed) != v)
+    {
+        *restart = 1;
+    }
+}
+
+static void upgradeLock(struct CTreeNode *n, uint64_t v, int *restart)
+{
+    if (!atomic_compare_exchange_strong_explicit(&n->version, &v, v + 1, memory_order_acquire, memory_order_relaxed))
+    {
+        *restart = 1;
+        return;
+    }
+    // changes to the node must not become visible before the odd version
+    atomic_thread_fence(memory_order_release);
+}
+
+static void writeUnlock(struct CTreeNode *n)
+{
+    atomic_fetch_add_explicit(&n->version, 1, memory_order_release);
+}
+
+static struct CTreeNode *createNode(const ConcurrentTree *t, int isLeaf)
+{
+    struct CTreeNode *n = (struct CTreeNode *)malloc(t->nodeBytes);
+    atomic_init(&n->version, 0);
+    n->isLeaf = isLeaf;
+    atomic_init(&n->count, 0);
+    return n;
+}
+
+static struct CTreeNode *getChild(const struct CTreeNode *n, int i)
+{
+    return (struct CTreeNode *)atomic_load_explicit(&n->data[i], memory_order_relaxed);
+}
+
+static void setChild(struct CTreeNode *n, int i, struct CTreeNode *c)
+{
+    atomic_store_explicit(&n->data[i], (uintptr_t)c, memory_order_relaxed);
+}
+
+static int nodeCount(const struct CTreeNode *n)
+{
+    return atomic_load_explicit(&n->count, memory_order_relaxed);
+}
+
+static void setCount(struct CTreeNode *n, int count)
+{
+    atomic_store_explicit(&n->count, count, memory_order_relaxed);
+}
+
+static _Atomic uintptr_t *keySlot(const ConcurrentTree *t, const struct CTreeNode *n, int i)
+{
+    // internal node keys come after the innerCap + 1 children
+    size_t offset = n->isLeaf ? 0 : (size_t)t->innerCap + 1;
+    return (_Atomic uintptr_t *)n->data + offset + (size_t)i * t->keyWords;
+}
+
+static void loadKey(const ConcurrentTree *t, const struct CTreeNode *n, int i, void *out)
+{
+    _Atomic uintptr_t *slot = keySlot(t, n, i);
+    char *dest = (char *)out;
+    size_t left = t->keySize;
+    for (size_t w = 0; w < t->keyWords; w++)
+    {
+        uintptr_t word = atomic_load_explicit(&slot[w], memory_order_relaxed);
+        size_t bytes = left < sizeof(uintptr_t) ? left : sizeof(uintptr_t);
+        memcpy(dest, &word, bytes);
+        dest += bytes;
+        left -= bytes;
+    }
+}
+
+static void storeKey(const ConcurrentTree *t, struct CTreeNode *n, int i, const void *key)
+{
+    _Atomic uintptr_t *slot = keySlot(t, n, i);
+    const char *src = (const char *)key;
+    size_t left = t->keySize;
+    for (size_t w = 0; w < t->keyWords; w++)
+    {
+        uintptr_t word = 0;
+        size_t bytes = left < sizeof(uintptr_t) ? left : sizeof(uintptr_t);
+        memcpy(&word, src, bytes);
+        atomic_store_explicit(&slot[w], word, memory_order_relaxed);
+        src += bytes;
+        left -= bytes;
+    }
+}
+
+static void moveKeys(const ConcurrentTree *t, struct CTreeNode *dst, int to, const struct CTreeNode *src, int from, int count)
+{
+    _Atomic uintptr_t *d = keySlot(t, dst, to);
+    _Atomic uintptr_t *s = keySlot(t, src, from);
+    size_t words = count > 0 ? (size_t)count * t->keyWords : 0;
+    // moving keys up within a node goes from the end, so no word is overwritten before it is copied
+    if (dst == src && to > from)
+    {
+        for (size_t w = words; w > 0; w--)
+        {
+            atomic_store_explicit(&d[w - 1], atomic_load_explicit(&s[w - 1], memory_order_relaxed), memory_order_relaxed);
+        }
+    }
+    else
+    {
+        for (size_t w = 0; w < words; w++)
+        {
+            atomic_store_explicit(&d[w], atomic_load_explicit(&s[w], memory_order_relaxed), memory_order_relaxed);
+        }
+    }
+}
+
+static void moveChildren(struct CTreeNode *dst, int to, const struct CTreeNode *src, int from, int count)
+{
+    if (dst == src && to > from)
+    {
+        for (int i = count - 1; i >= 0; i--)
+        {
+            setChild(dst, to + i, getChild(src, from + i));
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+        {
+            setChild(dst, to + i, getChild(src, from + i));
+        }
+    }
+}
+
+static void *scratchBuffer(const ConcurrentTree *t, uintptr_t *local)
+{
+    return t->keyWords <= LOCAL_KEY_WORDS ? (void *)local : malloc(t->keyWords * sizeof(uintptr_t));
+}
+
+static void freeScratch(void *scratch, uintptr_t *local)
+{
+    if (scratch != (void *)local)
+    {
+        free(scratch);
+    }
+}
+
+static int lowerBound(const ConcurrentTree *t, const struct CTreeNode *n, int count, const void *key, void *scratch)
+{
+    int lo = 0;
+    int hi = count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        loadKey(t, n, mid, scratch);
+        if ((*t->comp)(scratch, key) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int upperBound(const ConcurrentTree *t, const struct CTreeNode *n, int count, const void *key, void *scratch)
+{
+    int lo = 0;
+    int hi = count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        loadKey(t, n, mid, scratch);
+        if ((*t->comp)(scratch, key) <= 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int seek(ConcurrentTree *t, const void *probe, int mode, void *out, void *fence, int *hasFence)
+{
+    uintptr_t local[LOCAL_KEY_WORDS];
+    void *scratch = scratchBuffer(t, local);
+    int restart;
+    while (1)
+    {
+        restart = 0;
+        *hasFence = 0;
+        struct CTreeNode *parent = NULL;
+        uint64_t pv = 0;
+        struct CTreeNode *node = atomic_load_explicit(&t->root, memory_order_acquire);
+        uint64_t v = readLock(node, &restart);
+        if (restart || node != atomic_load_explicit(&t->root, memory_order_acquire))
+        {
+            continue;
+        }
+
+        while (!node->isLeaf)
+        {
+            if (parent != NULL)
+            {
+                validate(parent, pv, &restart);
+                if (restart)
+                {
+                    break;
+                }
+            }
+            int count = nodeCount(node);
+            int i = 0;
+            if (probe == NULL)
+            {
+                i = mode == SEEK_LT ? count : 0;
+            }
+            else
+            {
+                // keys equal to a separator are to its right, so a search for smaller keys goes left of it
+                i = mode == SEEK_LT ? lowerBound(t, node, count, probe, scratch) : upperBound(t, node, count, probe, scratch);
+            }
+            // the deepest separator next to the path is the tightest bound on the leaf
+            if (fence != NULL && (mode == SEEK_LT ? i > 0 : i < count))
+            {
+                loadKey(t, node, mode == SEEK_LT ? i - 1 : i, fence);
+                *hasFence = 1;
+            }
+            parent = node;
+            pv = v;
+            node = getChild(parent, i);
+            validate(parent, pv, &restart);
+            if (restart)
+            {
+                break;
+            }
+            v = readLock(node, &restart);
+            if (restart)
+            {
+                break;
+            }
+        }
+        if (restart)
+        {
+            continue;
+        }
+
+        int count = nodeCount(node);
+        int pos = 0;
+        int found = 0;
+        if (mode == SEEK_LT)
+        {
+            pos = (probe == NULL ? count : lowerBound(t, node, count, probe, scratch)) - 1;
+            found = pos >= 0;
+        }
+        else
+        {
+            pos = probe == NULL ? 0 : (mode == SEEK_GT ? upperBound(t, node, count, probe, scratch) : lowerBound(t, node, count, probe, scratch));
+            found = pos < count;
+            if (found && mode == SEEK_EQ)
+            {
+                loadKey(t, node, pos, scratch);
+                found = (*t->comp)(scratch, probe) == 0;
+            }
+        }
+        if (found && out != NULL)
+        {
+            loadKey(t, node, pos, out);
+        }
+
+        if (parent != NULL)
+        {
+            validate(parent, pv, &restart);
+        }
+        validate(node, v, &restart);
+        if (!restart)
+        {
+            freeScratch(scratch, local);
+            return found;
+        }
+    }
+}
+
+static int seekAcross(ConcurrentTree *t, const void *key, int mode, void *out)
+{
+    // the probe is kept in its own buffer, since out may be the same as key
+    char *probe = key != NULL ? (char *)malloc(t->keySize) : NULL;
+    char *fence = (char *)malloc(t->keySize);
+    if (probe != NULL)
+    {
+        memcpy(probe, key, t->keySize);
+    }
+
+    int hasFence = 0;
+    int found = seek(t, probe, mode, out, fence, &hasFence);
+    while (!found && hasFence)
+    {
+        // every key past the leaf is on the far side of the fence. For larger keys the fence itself may be
+        // a key, for smaller keys it is a strict bound.
+        if (probe == NULL)
+        {
+            probe = (char *)malloc(t->keySize);
+        }
+        memcpy(probe, fence, t->keySize);
+        if (mode == SEEK_GT)
+        {
+            mode = SEEK_GE;
+        }
+        found = seek(t, probe, mode, out, fence, &hasFence);
+    }
+    free((void *)probe);
+    free((void *)fence);
+    return found;
+}
+
+static struct CTreeNode *splitNode(ConcurrentTree *t, struct CTreeNode *n, void *sep)
+{
+    struct CTreeNode *r = createNode(t, n->isLeaf);
+    int count = nodeCount(n);
+    if (n->isLeaf)
+    {
+        // upper half of the keys moves, its first key is copied up as the separator
+        int rightCount = count / 2;
+        moveKeys(t, r, 0, n, count - rightCount, rightCount);
+        setCount(r, rightCount);
+        setCount(n, count - rightCount);
+        loadKey(t, r, 0, sep);
+    }
+    else
+    {
+        // middle key moves up, the keys and children after it move to r
+        int mid = count / 2;
+        int rightCount = count - mid - 1;
+        moveKeys(t, r, 0, n, mid + 1, rightCount);
+        moveChildren(r, 0, n, mid + 1, rightCount + 1);
+        setCount(r, rightCount);
+        loadKey(t, n, mid, sep);
+        setCount(n, mid);
+    }
+    return r;
+}
+
+static void insertChild(ConcurrentTree *t, struct CTreeNode *p, const void *sep, struct CTreeNode *right, void *scratch)
+{
+    int count = nodeCount(p);
+    int i = upperBound(t, p, count, sep, scratch);
+    moveKeys(t, p, i + 1, p, i, count - i);
+    storeKey(t, p, i, sep);
+    moveChildren(p, i + 2, p, i + 1, count - i);
+    setChild(p, i + 1, right);
+    setCount(p, count + 1);
+}
+
+static void freeNode(struct CTreeNode *n)
+{
+    if (!n->isLeaf)
+    {
+        for (int i = 0; i <= nodeCount(n); i++)
+        {
+            freeNode(getChild(n, i));
+        }
+    }
+    free((void *)n);
+}
@@ -0,0 +1,163 @@
+/*
+    Contains declarations of a concurrent ordered set for fixed size generic keys, which may be used by many
+    threads at once without an outside lock. It supports the ordered set operations of trees.h (search, minimum,
+    maximum, predecessor, successor, insertion, deletion).
+
+    It is a B+-tree (see bplus_tree.h) synchronized with optimistic lock coupling. Every node has a version
+    number that doubles as a lock. Readers take no locks: they read a node, then check that its version did not
+    change, and start over if it did. Writers lock only the one or two nodes they change. Reads therefore never
+    write shared memory and scale with the number of cores, while writers to different parts of the tree
+    proceed in parallel.
+
+    Requirements:
+        1.  C11 atomics (<stdatomic.h>).
+        2.  A reader may see a key while a writer is changing it, in which case the result is thrown away.
+            Therefore the comparison function must be safe to call on any keySize bytes (e.g. comparing
+            integers, or memcmp()), and must not follow pointers inside keys.
+
+    Nodes are never merged or freed while the tree is in use, so deletion can leave leaves empty. The memory is
+    returned by ctreeFree().
+
+    For runtime calculations of the declared operations, they are done with respect to the number of keys (n)
+    in the tree and the number of keys that fit in a node (B), without contention (each restart repeats the
+    operation).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef CONCURRENT_TREE_H
+#define CONCURRENT_TREE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the ConcurrentTree. It is implemented via a structure that holds an atomic root pointer
+    and the parameters supplied to ctreeCreate().
+*/
+typedef struct ConcurrentTree ConcurrentTree;
+
+/*
+    Creates an empty ConcurrentTree.
+
+    Parameters:
+        keySize (size_t) : size in bytes of every key (keys are copied with memcpy())
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on keys (see
+            the requirements above)
+        nodeBytes (size_t) : size in bytes of a node, clamped to [256, 4096] and grown if needed so that a node
+            holds at least 4 keys
+
+    Output:
+        A pointer to the created ConcurrentTree, or NULL if keySize is 0. Unlike the other operations, creation
+        is not thread-safe (the tree must be created before it is shared).
+
+    Runtime: O(1)
+*/
+ConcurrentTree *ctreeCreate(size_t keySize, int (*comp)(const void *, const void *), size_t nodeBytes);
+
+/*
+    Searches a provided tree for a provided key.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree to search
+        key (const void *) : pointer to the key (not modified)
+
+    Output:
+        1 if key is in the tree, 0 otherwise.
+
+    Runtime: O(log(n))
+*/
+int ctreeSearch(ConcurrentTree *t, const void *key);
+
+/*
+    Retrieve the minimum and maximum keys of a provided tree. Pointers into the tree would be unsafe once
+    returned, so the key found is copied out.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        out (void *) : pointer to keySize bytes where the key found is copied
+
+    Output:
+        1 if the tree has a key (copied into out), 0 if it is empty.
+
+    Runtime: O(log(n)) plus O(1) per empty leaf skipped
+*/
+int ctreeMinimum(ConcurrentTree *t, void *out);
+int ctreeMaximum(ConcurrentTree *t, void *out);
+
+/*
+    Retrieve the largest key smaller (smallest key larger) than a provided key. The key does not need to be in
+    the tree.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        key (const void *) : pointer to the key (not modified)
+        out (void *) : pointer to keySize bytes where the key found is copied (may be the same as key)
+
+    Output:
+        1 if there is a predecessor (successor) and it was copied into out, 0 otherwise.
+
+    Runtime: O(log(n)) plus O(log(n)) per empty leaf skipped
+*/
+int ctreePredecessor(ConcurrentTree *t, const void *key, void *out);
+int ctreeSuccessor(ConcurrentTree *t, const void *key, void *out);
+
+/*
+    Inserts a copy of a provided key into a provided tree.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        key (const void *) : pointer to the key to insert (keySize bytes are copied)
+
+    Output:
+        1 if key was inserted, 0 if it was already in the tree.
+
+    Runtime: O(B * log_B(n))
+
+        NOTE: memory allocation is assumed to be independent
+*/
+int ctreeInsert(ConcurrentTree *t, const void *key);
+
+/*
+    Deletes a provided key from a provided tree.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+        key (const void *) : pointer to the key to delete (not modified)
+
+    Output:
+        1 if key was deleted, 0 if it was not in the tree.
+
+    Runtime: O(B + log(n))
+*/
+int ctreeDelete(ConcurrentTree *t, const void *key);
+
+/*
+    Retrieves the number of keys in a provided tree. While other threads are inserting or deleting, the result
+    is only a snapshot.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree
+
+    Output:
+        The number of keys in the tree.
+
+    Runtime: O(1)
+*/
+size_t ctreeSize(ConcurrentTree *t);
+
+/*
+    De-allocates the memory allocated to a provided tree. No other thread may be using the tree.
+
+    Parameters:
+        t (ConcurrentTree *) : pointer to the tree to free
+
+    Output:
+        The tree and all of its nodes are freed. The calling function should set t to NULL afterwards to avoid
+        undefined behavior.
+
+    Runtime: O(n / B)
+*/
+void ctreeFree(ConcurrentTree *t);
+
+#endif
@@ -0,0 +1,171 @@
+#include "concurrent_tree.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#define THREADS 4        // number of writer threads, and of reader threads
+#define PER_THREAD 50000 // keys inserted by each writer
+
+ConcurrentTree *t = NULL;
+
+int intCmp(const void *a, const void *b);
+void *writer(void *arg);
+void *reader(void *arg);
+void smallTest(void);
+void threadTest(void);
+
+int main()
+{
+    smallTest();
+    threadTest();
+    return 0;
+}
+
+void smallTest(void)
+{
+    printf("%p\n", (void *)ctreeCreate(0, intCmp, 256)); // (nil)
+
+    // enough keys for a few levels, then delete all but both ends: leaves are never merged, so the ordered
+    // operations have to step over a run of empty leaves
+    t = ctreeCreate(sizeof(int), intCmp, 256);
+    for (int i = 0; i < 10000; i++)
+    {
+        ctreeInsert(t, &i);
+    }
+    printf("%d\n", ctreeInsert(t, &(int){5000})); // 0
+    for (int i = 1; i < 9999; i++)
+    {
+        ctreeDelete(t, &i);
+    }
+    printf("%d\n", ctreeDelete(t, &(int){5000})); // 0
+    printf("%d\n", ctreeSearch(t, &(int){5000})); // 0
+    printf("%u\n", (unsigned)ctreeSize(t));       // 2
+
+    int out = 0;
+    ctreeSuccessor(t, &out, &out);
+    printf("%d\n", out); // 9999
+    ctreePredecessor(t, &out, &out);
+    printf("%d\n", out); // 0
+    ctreeSuccessor(t, &(int){5000}, &out);
+    printf("%d\n", out); // 9999
+
+    // with the first key gone too, the minimum is only found past every empty leaf
+    ctreeDelete(t, &(int){0});
+    ctreeMinimum(t, &out);
+    printf("%d\n", out); // 9999
+
+    // nothing is copied out past either end
+    out = -1;
+    printf("%d\n", ctreeSuccessor(t, &(int){9999}, &out));   // 0
+    printf("%d\n", ctreePredecessor(t, &(int){9999}, &out)); // 0
+    printf("%d\n", out);                                     // -1
+
+    ctreeFree(t);
+    t = NULL;
+    printf("SMALL TEST DONE.\n");
+}
+
+void threadTest(void)
+{
+    // small nodes so that the writers split often
+    t = ctreeCreate(sizeof(int), intCmp, 256);
+    pthread_t writers[THREADS];
+    pthread_t readers[THREADS];
+    int ids[THREADS];
+    int ok[THREADS];
+    for (int i = 0; i < THREADS; i++)
+    {
+        ids[i] = i;
+        ok[i] = i;
+        pthread_create(&writers[i], NULL, writer, &ids[i]);
+        pthread_create(&readers[i], NULL, reader, &ok[i]);
+    }
+    for (int i = 0; i < THREADS; i++)
+    {
+        pthread_join(writers[i], NULL);
+        pthread_join(readers[i], NULL);
+    }
+
+    // each writer inserted its keys (interleaved with the other writers') and deleted the odd ones
+    int found = ctreeSize(t) == (size_t)(THREADS * PER_THREAD / 2);
+    for (int k = 0; k < THREADS * PER_THREAD; k++)
+    {
+        found = found && ctreeSearch(t, &k) == (k % 2 == 0);
+    }
+    printf("%d\n", found); // 1
+
+    // in order traversal visits exactly the even keys
+    int sorted = 1;
+    int count = 0;
+    int k = 0;
+    int more = ctreeMinimum(t, &k);
+    while (more)
+    {
+        sorted = sorted && k == 2 * count;
+        count++;
+        more = ctreeSuccessor(t, &k, &k);
+    }
+    printf("%d\n", sorted && count == THREADS * PER_THREAD / 2); // 1
+
+    int readersOk = 1;
+    for (int i = 0; i < THREADS; i++)
+    {
+        readersOk = readersOk && ok[i];
+    }
+    printf("%d\n", readersOk); // 1
+
+    ctreeFree(t);
+    t = NULL;
+    printf("THREAD TEST DONE.\n");
+}
+
+void *writer(void *arg)
+{
+    int id = *(int *)arg;
+    for (int i = 0; i < PER_THREAD; i++)
+    {
+        int key = i * THREADS + id;
+        ctreeInsert(t, &key);
+    }
+    for (int i = 0; i < PER_THREAD; i++)
+    {
+        int key = i * THREADS + id;
+        if (key % 2 == 1)
+        {
+            ctreeDelete(t, &key);
+        }
+    }
+    return NULL;
+}
+
+void *reader(void *arg)
+{
+    // the keys seen in order must always be increasing, whatever the writers are doing
+    int *ok = (int *)arg;
+    int seed = *ok;
+    *ok = 1;
+    for (int i = 0; i < 2000; i++)
+    {
+        int key = (i * 7919 + seed * 104729) % (THREADS * PER_THREAD);
+        int next = 0;
+        int prev = 0;
+        if (ctreeSuccessor(t, &key, &next))
+        {
+            *ok = *ok && next > key;
+        }
+        if (ctreePredecessor(t, &key, &prev))
+        {
+            *ok = *ok && prev < key;
+        }
+        ctreeSearch(t, &key);
+    }
+    return NULL;
+}
+
+int intCmp(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
@@ -0,0 +1,369 @@
+/*
+    Contains implementation of the interval tree declared in interval_tree.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Private (static) helper function declarations
+        4.  Public header function definitions
+        5.  Private (static) helper function definitions
+
+    The tree is balanced as avlInsert() and avlDelete() of trees.h balance a BST. A node's max depends only on
+    its own high endpoint and its children's max, so it is recomputed together with the height wherever the
+    height is: on the path of an insertion or deletion, and for the 2 nodes that move in a rotation (the lower
+    one first).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "interval_tree.h" // needed for interval tree operations
+#include <stdlib.h>        // needed for malloc(), free()
+#include <stddef.h>        // needed for size_t
+
+// ***************************** CONSTANTS ***********************************************
+
+#define NODE_ALIGNMENT 16 // alignment of the endpoints stored after their node, enough for any standard type
+
+// rounds a number of bytes up to a multiple of NODE_ALIGNMENT
+#define ALIGN_UP(bytes) (((bytes) + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT)
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Allocates a leaf with copies of provided endpoints, the low one at offset ALIGN_UP(sizeof(struct
+    itreeNode)) and the high one after it.
+
+    Parameters:
+        low, high, value, copy, size : see itreeInsert()
+
+    Runtime: O(1)
+*/
+static struct itreeNode *createNode(const void *low, const void *high, void *value, void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Compares 2 intervals by low endpoint, then by high endpoint.
+
+    Parameters:
+        low, high (const void *) : pointers to the endpoints of the first interval
+        n (const struct itreeNode *) : pointer to the node of the second interval
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the endpoints
+
+    Output:
+        < 0, 0, or > 0 as [low, high] comes before, is the same as, or comes after n's interval.
+
+    Runtime: O(1)
+*/
+static int compareInterval(const void *low, const void *high, const struct itreeNode *n, int (*comp)(const void *, const void *));
+
+/*
+    Recomputes the height and max of a node from its children, which must be up to date.
+
+    Parameters:
+        node (struct itreeNode *) : pointer to the node
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the endpoints
+
+    Runtime: O(1)
+*/
+static void updateNode(struct itreeNode *node, int (*comp)(const void *, const void *));
+
+/*
+    Rotations and rebalancing as in bst.c, which also keep max up to date.
+
+    Parameters:
+        node (struct itreeNode *) : pointer to the node to rotate at (or rebalance)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the endpoints
+
+    Output:
+        A pointer to the node that takes node's place.
+
+    Runtime: O(1)
+*/
+static struct itreeNode *rotateLeft(struct itreeNode *node, int (*comp)(const void *, const void *));
+static struct itreeNode *rotateRight(struct itreeNode *node, int (*comp)(const void *, const void *));
+static struct itreeNode *rebalance(struct itreeNode *node, int (*comp)(const void *, const void *));
+
+/*
+    Removes the node with the smallest interval from a subtree, rebalancing on the way back up.
+
+    Parameters:
+        node (struct itreeNode *) : pointer to the root of the subtree (not NULL)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the endpoints
+        min (struct itreeNode **) : where the removed node is stored
+
+    Output:
+        A pointer to the root of the subtree without the node.
+
+    Runtime: O(log(n))
+*/
+static struct itreeNode *removeMinimum(struct itreeNode *node, int (*comp)(const void *, const void *), struct itreeNode **min);
+
+/*
+    Recursive helpers of itreeInsert(), itreeDelete(), and itreeOverlaps(), on the subtree rooted at node.
+
+    Runtime: see the corresponding public function
+*/
+static struct itreeNode *insertAt(struct itreeNode *node, const void *low, const void *high, void *value, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+static struct itreeNode *deleteAt(struct itreeNode *node, const void *low, const void *high, int (*comp)(const void *, const void *));
+static void overlapsAt(struct itreeNode *node, const void *low, const void *high, int (*comp)(const void *, const void *), void (*visit)(struct itreeNode *, void *), void *arg, size_t *count);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+struct itreeNode *itreeInsert(struct itreeNode *root, const void *low, const void *high, void *value, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    return insertAt(root, low, high, value, copy, size, comp);
+}
+
+struct itreeNode *itreeDelete(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *))
+{
+    return deleteAt(root, low, high, comp);
+}
+
+struct itreeNode *itreeSearch(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *))
+{
+    while (root != NULL)
+    {
+        int c = compareInterval(low, high, root, comp);
+        if (c == 0)
+        {
+            return root;
+        }
+        root = c < 0 ? root->left : root->right;
+    }
+    return NULL;
+}
+
+struct itreeNode *itreeAnyOverlap(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *))
+{
+    while (root != NULL && ((*comp)(root->low, high) > 0 || (*comp)(root->high, low) < 0))
+    {
+        // if an interval on the left reaches low but none of them overlaps, they all start after high, and so
+        // do the intervals on the right. Otherwise nothing on the left reaches low.
+        if (root->left != NULL && (*comp)(root->left->max, low) >= 0)
+        {
+            root = root->left;
+        }
+        else
+        {
+            root = root->right;
+        }
+    }
+    return root;
+}
+
+size_t itreeOverlaps(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *), void (*visit)(struct itreeNode *, void *), void *arg)
+{
+    size_t count = 0;
+    overlapsAt(root, low, high, comp, visit, arg, &count);
+    return count;
+}
+
+size_t itreeStab(struct itreeNode *root, const void *point, int (*comp)(const void *, const void *), void (*visit)(struct itreeNode *, void *), void *arg)
+{
+    return itreeOverlaps(root, point, point, comp, visit, arg);
+}
+
+void itreeFree(struct itreeNode *root)
+{
+    // as bstFree(), rotate left children up until the root has none, then free it and go on to its right
+    struct itreeNode *next = NULL;
+    while (root != NULL)
+    {
+        if (root->left != NULL)
+        {
+            next = root->left;
+            root->left = next->right;
+            next->right = root;
+        }
+        else
+        {
+            next = root->right;
+            free((void *)root);
+        }
+        root = next;
+    }
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static struct itreeNode *createNode(const void *low, const void *high, void *value, void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    size_t lowOffset = ALIGN_UP(sizeof(struct itreeNode));
+    size_t highOffset = lowOffset + ALIGN_UP((*size)(low));
+    struct itreeNode *n = (struct itreeNode *)malloc(highOffset + (*size)(high));
+    n->low = (char *)n + lowOffset;
+    n->high = (char *)n + highOffset;
+    (*copy)(n->low, low);
+    (*copy)(n->high, high);
+    n->left = NULL;
+    n->right = NULL;
+    n->max = n->high;
+    n->height = 1;
+    n->value = value;
+    return n;
+}
+
+static int compareInterval(const void *low, const void *high, const struct itreeNode *n, int (*comp)(const void *, const void *))
+{
+    int c = (*comp)(low, n->low);
+    return c != 0 ? c : (*comp)(high, n->high);
+}
+
+static void updateNode(struct itreeNode *node, int (*comp)(const void *, const void *))
+{
+    int lh = node->left != NULL ? node->left->height : 0;
+    int rh = node->right != NULL ? node->right->height : 0;
+    node->height = (lh > rh ? lh : rh) + 1;
+    node->max = node->high;
+    if (node->left != NULL && (*comp)(node->left->max, node->max) > 0)
+    {
+        node->max = node->left->max;
+    }
+    if (node->right != NULL && (*comp)(node->right->max, node->max) > 0)
+    {
+        node->max = node->right->max;
+    }
+}
+
+static struct itreeNode *rotateLeft(struct itreeNode *node, int (*comp)(const void *, const void *))
+{
+    // right child moves up, its left subtree moves under node. node is now below r, so it's updated first
+    struct itreeNode *r = node->right;
+    node->right = r->left;
+    r->left = node;
+    updateNode(node, comp);
+    updateNode(r, comp);
+    return r;
+}
+
+static struct itreeNode *rotateRight(struct itreeNode *node, int (*comp)(const void *, const void *))
+{
+    struct itreeNode *l = node->left;
+    node->left = l->right;
+    l->right = node;
+    updateNode(node, comp);
+    updateNode(l, comp);
+    return l;
+}
+
+static struct itreeNode *rebalance(struct itreeNode *node, int (*comp)(const void *, const void *))
+{
+    updateNode(node, comp);
+    int lh = node->left != NULL ? node->left->height : 0;
+    int rh = node->right != NULL ? node->right->height : 0;
+
+    // left heavy, a left child that is right heavy is turned into the left-left case first
+    if (lh - rh > 1)
+    {
+        struct itreeNode *l = node->left;
+        if ((l->left != NULL ? l->left->height : 0) < (l->right != NULL ? l->right->height : 0))
+        {
+            node->left = rotateLeft(l, comp);
+        }
+        return rotateRight(node, comp);
+    }
+    // right heavy, symmetric
+    if (rh - lh > 1)
+    {
+        struct itreeNode *r = node->right;
+        if ((r->right != NULL ? r->right->height : 0) < (r->left != NULL ? r->left->height : 0))
+        {
+            node->right = rotateRight(r, comp);
+        }
+        return rotateLeft(node, comp);
+    }
+    return node;
+}
+
+static struct itreeNode *removeMinimum(struct itreeNode *node, int (*comp)(const void *, const void *), struct itreeNode **min)
+{
+    if (node->left == NULL)
+    {
+        *min = node;
+        return node->right;
+    }
+    node->left = removeMinimum(node->left, comp, min);
+    return rebalance(node, comp);
+}
+
+static struct itreeNode *insertAt(struct itreeNode *node, const void *low, const void *high, void *value, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *))
+{
+    if (node == NULL)
+    {
+        return createNode(low, high, value, copy, size);
+    }
+    int c = compareInterval(low, high, node, comp);
+    if (c < 0)
+    {
+        node->left = insertAt(node->left, low, high, value, copy, size, comp);
+    }
+    else if (c > 0)
+    {
+        node->right = insertAt(node->right, low, high, value, copy, size, comp);
+    }
+    // interval already in tree, nothing changes
+    else
+    {
+        return node;
+    }
+    return rebalance(node, comp);
+}
+
+static struct itreeNode *deleteAt(struct itreeNode *node, const void *low, const void *high, int (*comp)(const void *, const void *))
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    int c = compareInterval(low, high, node, comp);
+    if (c < 0)
+    {
+        node->left = deleteAt(node->left, low, high, comp);
+    }
+    else if (c > 0)
+    {
+        node->right = deleteAt(node->right, low, high, comp);
+    }
+    else
+    {
+        // at most 1 child takes node's place as is, otherwise its successor does
+        struct itreeNode *replacement = NULL;
+        if (node->left == NULL || node->right == NULL)
+        {
+            replacement = node->left != NULL ? node->left : node->right;
+        }
+        else
+        {
+            struct itreeNode *rest = removeMinimum(node->right, comp, &replacement);
+            replacement->left = node->left;
+            replacement->right = rest;
+            replacement = rebalance(replacement, comp);
+        }
+        free((void *)node);
+        return replacement;
+    }
+    return rebalance(node, comp);
+}
+
+static void overlapsAt(struct itreeNode *node, const void *low, const void *high, int (*comp)(const void *, const void *), void (*visit)(struct itreeNode *, void *), void *arg, size_t *count)
+{
+    // a subtree whose max is before low has nothing that reaches the query, the loop goes down the right
+    // spine instead of recursing into it
+    while (node != NULL && (*comp)(node->max, low) >= 0)
+    {
+        overlapsAt(node->left, low, high, comp, visit, arg, count);
+        // node and everything on its right start after high
+        if ((*comp)(node->low, high) > 0)
+        {
+            return;
+        }
+        if ((*comp)(node->high, low) >= 0)
+        {
+            (*visit)(node, arg);
+            (*count)++;
+        }
+        node = node->right;
+    }
+}
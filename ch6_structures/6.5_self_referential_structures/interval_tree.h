@@ -0,0 +1,148 @@
+/*
+    Contains declarations of an interval tree for generic endpoints: an AVL tree of closed intervals
+    [low, high] ordered by low endpoint (then high endpoint), where every node also holds the largest high
+    endpoint in its subtree. That one extra field is enough to skip every subtree whose intervals all end before
+    a query begins, so the intervals that overlap a point or an interval are found without scanning the tree.
+    The field is kept up to date by insertions, deletions, and the rotations that rebalance the tree.
+
+    Endpoints take the key callbacks of trees.h (a comparison, a copy, and a size function), and both endpoints
+    of an interval are copied into the node's allocation. Each interval may carry a value pointer for the
+    caller's own use (e.g. the event the time interval belongs to), which the tree stores but never follows.
+
+    For runtime calculations of the declared operations, they are done with respect to the number of intervals
+    (n) in the tree and the number of intervals reported by a query (k). Operations regarding endpoint data such
+    as comparison and copying are considered to be O(1).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Structure for a node of an interval tree. A pointer to a node is the root of a tree, NULL is the empty tree.
+    The fields may be read but should only be changed through the functions below.
+
+    Fields:
+        left (struct itreeNode *) : left child, whose intervals come before this one
+        right (struct itreeNode *) : right child, whose intervals come after this one
+        low (void *) : pointer to the low endpoint (stored in the node's allocation)
+        high (void *) : pointer to the high endpoint (stored in the node's allocation)
+        max (const void *) : pointer to the largest high endpoint in the subtree rooted at this node (the high
+            field of one of its nodes)
+        height (int) : number of nodes on the longest path from this node down to a leaf (1 for a leaf)
+        value (void *) : the caller's value for the interval
+*/
+struct itreeNode
+{
+    struct itreeNode *left;
+    struct itreeNode *right;
+    void *low;
+    void *high;
+    const void *max;
+    int height;
+    void *value;
+};
+
+/*
+    Inserts a copy of an interval into an interval tree.
+
+    Parameters:
+        root (struct itreeNode *) : pointer to the root of the tree
+        low (const void *) : pointer to the low endpoint (copied)
+        high (const void *) : pointer to the high endpoint (copied), which must not be smaller than low
+        value (void *) : the interval's value, stored as is
+        copy (void (*) (void *, const void *)) : pointer to the function that copies an endpoint (as in
+            bstInsert())
+        size (size_t (*) (const void *)) : pointer to the function that returns the size of an endpoint
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on endpoints
+
+    Output:
+        A pointer to the root of the tree with the interval inserted. If the tree already has an interval with
+        the same endpoints, the tree is unchanged (its value is kept).
+
+    Runtime: O(log(n))
+
+        NOTE: memory allocation is assumed to be independent
+*/
+struct itreeNode *itreeInsert(struct itreeNode *root, const void *low, const void *high, void *value, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+
+/*
+    Deletes an interval from an interval tree.
+
+    Parameters:
+        root (struct itreeNode *) : pointer to the root of the tree
+        low (const void *) : pointer to the low endpoint (not modified)
+        high (const void *) : pointer to the high endpoint (not modified)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on endpoints
+
+    Output:
+        A pointer to the root of the tree without the interval, the original root if it was not in the tree.
+
+    Runtime: O(log(n))
+*/
+struct itreeNode *itreeDelete(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *));
+
+/*
+    Searches an interval tree for an interval with provided endpoints.
+
+    Parameters:
+        root, low, high, comp : see itreeDelete() (the tree is not modified)
+
+    Output:
+        A pointer to the node of the interval, NULL if it is not in the tree.
+
+    Runtime: O(log(n))
+*/
+struct itreeNode *itreeSearch(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *));
+
+/*
+    Finds one interval of an interval tree that overlaps a provided interval, which is all that is needed to
+    answer "is anything scheduled between low and high".
+
+    Parameters:
+        root, comp : see itreeDelete() (the tree is not modified)
+        low (const void *) : pointer to the low endpoint of the query interval (not modified)
+        high (const void *) : pointer to the high endpoint of the query interval (not modified)
+
+    Output:
+        A pointer to the node of an interval [a, b] with a <= high and low <= b, NULL if there is none.
+
+    Runtime: O(log(n))
+*/
+struct itreeNode *itreeAnyOverlap(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *));
+
+/*
+    Visits every interval of an interval tree that overlaps a provided interval (itreeOverlaps()) or contains a
+    provided point (itreeStab(), the same as the interval [point, point]), in order.
+
+    Parameters:
+        root, low, high, comp : see itreeAnyOverlap()
+        point (const void *) : pointer to the point (not modified)
+        visit (void (*) (struct itreeNode *, void *)) : function called with the node of each interval found and
+            arg. It must not modify the tree.
+        arg (void *) : passed to every call of visit (may be NULL)
+
+    Output:
+        The number of intervals visited.
+
+    Runtime: O(min(n, (k + 1) log(n))). Subtrees that end before low or start after high are never entered,
+        so only the paths down to the intervals reported are walked, however many intervals there are.
+*/
+size_t itreeOverlaps(struct itreeNode *root, const void *low, const void *high, int (*comp)(const void *, const void *), void (*visit)(struct itreeNode *, void *), void *arg);
+size_t itreeStab(struct itreeNode *root, const void *point, int (*comp)(const void *, const void *), void (*visit)(struct itreeNode *, void *), void *arg);
+
+/*
+    Frees the nodes of an interval tree (not the values).
+
+    Parameters:
+        root (struct itreeNode *) : pointer to the root of the tree, which should be set to NULL afterwards
+
+    Runtime: O(n)
+*/
+void itreeFree(struct itreeNode *root);
+
+#endif
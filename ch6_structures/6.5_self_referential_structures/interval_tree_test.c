@@ -0,0 +1,182 @@
+#include "interval_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#define RANDOM_INTERVALS 2000 // number of interval slots used by the random test
+#define TIME_SPAN 10000       // endpoints of the random test are below this
+
+int intCmp(const void *a, const void *b);
+void intCopy(void *dst, const void *src);
+size_t intSize(const void *key);
+void printVisit(struct itreeNode *node, void *arg);
+void countVisit(struct itreeNode *node, void *arg);
+int checkTree(struct itreeNode *node);
+void smallTest(void);
+void randomTest(void);
+
+int main()
+{
+    smallTest();
+    randomTest();
+    return 0;
+}
+
+void smallTest(void)
+{
+    // meetings as [start, end] in minutes, with the meeting's name as the value
+    int times[][2] = {{540, 600}, {570, 630}, {600, 660}, {720, 780}, {900, 1020}, {480, 1080}, {615, 615}};
+    const char *names[] = {"standup", "review", "planning", "lunch", "workshop", "on call", "call"};
+    struct itreeNode *root = NULL;
+    for (int i = 0; i < 7; i++)
+    {
+        root = itreeInsert(root, &times[i][0], &times[i][1], (void *)names[i], intCopy, intSize, intCmp);
+    }
+    root = itreeInsert(root, &times[0][0], &times[0][1], "again", intCopy, intSize, intCmp); // no change
+    printf("%d\n", checkTree(root) > 0);                                                     // 1
+    printf("%d\n", *(const int *)root->max);                                                  // 1080
+
+    // what is on at 10:00 (600), and at 16:00 (960)
+    size_t count = itreeStab(root, &(int){600}, intCmp, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // on call standup review planning \n 4
+    count = itreeStab(root, &(int){960}, intCmp, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // on call workshop \n 2
+
+    // what overlaps 10:10 to 10:20, then without on call, is anything on from 11:01 to 11:59 (or 12:00)
+    count = itreeOverlaps(root, &(int){610}, &(int){620}, intCmp, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // on call review planning call \n 4
+    root = itreeDelete(root, &times[5][0], &times[5][1], intCmp);
+    printf("%p\n", (void *)itreeAnyOverlap(root, &(int){661}, &(int){719}, intCmp));         // (nil)
+    printf("%s\n", (const char *)itreeAnyOverlap(root, &(int){661}, &(int){720}, intCmp)->value); // lunch
+    printf("%d\n", *(const int *)root->max);                                                  // 1020
+    printf("%s\n", (const char *)itreeSearch(root, &times[0][0], &times[0][1], intCmp)->value); // standup
+    printf("%p\n", (void *)itreeSearch(root, &times[0][0], &times[1][1], intCmp));           // (nil)
+    root = itreeDelete(root, &times[5][0], &times[5][1], intCmp);                             // not there
+    printf("%d\n", checkTree(root) > 0);                                                      // 1
+    itreeFree(root);
+    printf("SMALL TEST DONE.\n");
+}
+
+void randomTest(void)
+{
+    // random insertions and deletions of random intervals, then queries checked against a scan of the
+    // intervals that should be in the tree
+    int (*intervals)[2] = (int (*)[2])malloc(RANDOM_INTERVALS * sizeof(*intervals));
+    char *present = (char *)calloc(RANDOM_INTERVALS, 1);
+    struct itreeNode *root = NULL;
+    srand(49);
+    for (int i = 0; i < RANDOM_INTERVALS; i++)
+    {
+        // mostly short intervals and a few long ones, all distinct (the slot is the last digits of low)
+        intervals[i][0] = rand() % (TIME_SPAN / RANDOM_INTERVALS) * RANDOM_INTERVALS + i;
+        intervals[i][1] = intervals[i][0] + (i % 50 == 0 ? rand() % (TIME_SPAN / 2) : rand() % 50);
+    }
+    for (int i = 0; i < 20000; i++)
+    {
+        int k = rand() % RANDOM_INTERVALS;
+        if (rand() % 3 == 0)
+        {
+            root = itreeDelete(root, &intervals[k][0], &intervals[k][1], intCmp);
+            present[k] = 0;
+        }
+        else
+        {
+            root = itreeInsert(root, &intervals[k][0], &intervals[k][1], &intervals[k], intCopy, intSize, intCmp);
+            present[k] = 1;
+        }
+    }
+
+    int ok = checkTree(root) > 0;
+    for (int q = 0; q < 1000 && ok; q++)
+    {
+        int low = rand() % (TIME_SPAN + TIME_SPAN / 2);
+        int high = low + (q % 2 == 0 ? 0 : rand() % 200);
+        size_t expected = 0;
+        for (int i = 0; i < RANDOM_INTERVALS; i++)
+        {
+            expected += present[i] && intervals[i][0] <= high && low <= intervals[i][1];
+        }
+        size_t visited = 0;
+        size_t count = itreeOverlaps(root, &low, &high, intCmp, countVisit, &visited);
+        struct itreeNode *any = itreeAnyOverlap(root, &low, &high, intCmp);
+        ok = count == expected && visited == expected && (any != NULL) == (expected > 0);
+        ok = ok && (any == NULL || (*(const int *)any->low <= high && low <= *(const int *)any->high));
+    }
+    printf("%d\n", ok); // 1
+
+    for (int i = 0; i < RANDOM_INTERVALS; i++)
+    {
+        root = itreeDelete(root, &intervals[i][0], &intervals[i][1], intCmp);
+    }
+    printf("%p\n", (void *)root); // (nil)
+    free(intervals);
+    free(present);
+    printf("RANDOM TEST DONE.\n");
+}
+
+// returns the height of a tree, or -1 if a height, a max, the balance, or the order is wrong
+int checkTree(struct itreeNode *node)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    int lh = checkTree(node->left);
+    int rh = checkTree(node->right);
+    if (lh < 0 || rh < 0 || lh - rh > 1 || rh - lh > 1)
+    {
+        return -1;
+    }
+    int max = *(const int *)node->high;
+    if (node->left != NULL)
+    {
+        int c = intCmp(node->left->low, node->low);
+        max = *(const int *)node->left->max > max ? *(const int *)node->left->max : max;
+        if (c > 0 || (c == 0 && intCmp(node->left->high, node->high) >= 0))
+        {
+            return -1;
+        }
+    }
+    if (node->right != NULL)
+    {
+        int c = intCmp(node->right->low, node->low);
+        max = *(const int *)node->right->max > max ? *(const int *)node->right->max : max;
+        if (c < 0 || (c == 0 && intCmp(node->right->high, node->high) <= 0))
+        {
+            return -1;
+        }
+    }
+    int h = (lh > rh ? lh : rh) + 1;
+    return h == node->height && max == *(const int *)node->max ? h : -1;
+}
+
+void printVisit(struct itreeNode *node, void *arg)
+{
+    (void)arg;
+    printf("%s ", (const char *)node->value);
+}
+
+void countVisit(struct itreeNode *node, void *arg)
+{
+    (void)node;
+    (*(size_t *)arg)++;
+}
+
+int intCmp(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void intCopy(void *dst, const void *src)
+{
+    memcpy(dst, src, sizeof(int));
+}
+
+size_t intSize(const void *key)
+{
+    (void)key;
+    return sizeof(int);
+}
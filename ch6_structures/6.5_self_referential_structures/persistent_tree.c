@@ -0,0 +1,232 @@
+/*
+    Contains implementation of the persistent BST declared in persistent_tree.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    A node's reference count is the number of nodes (in any version) that have it as a child, plus the number
+    of references to it held as a root. Copying a node onto a new path therefore adds a reference to each of
+    its children that the new node keeps, and a node is freed when its count drops to 0, which releases its
+    children in turn.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "persistent_tree.h" // needed for persistent BST operations
+#include <stdatomic.h>       // needed for atomic reference counts
+#include <stdlib.h>          // needed for malloc(), free()
+#include <stddef.h>          // needed for size_t
+
+// ***************************** CONSTANTS ***********************************************
+
+#define NODE_ALIGNMENT 16 // alignment of a key stored after its node, enough for any standard type
+
+// offset of a node's key from the start of the node
+#define KEY_OFFSET ((sizeof(struct pbstNode) + NODE_ALIGNMENT - 1) / NODE_ALIGNMENT * NODE_ALIGNMENT)
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a node of a persistent BST. The key is stored in the same allocation, right after the node
+    (at offset KEY_OFFSET). Only refs changes once a node is reachable from a version.
+
+    Fields:
+        left (struct pbstNode *) : left child
+        right (struct pbstNode *) : right child
+        key (void *) : pointer to the node's key
+        refs (atomic_size_t) : number of references to the node (see above)
+*/
+struct pbstNode
+{
+    struct pbstNode *left;
+    struct pbstNode *right;
+    void *key;
+    atomic_size_t refs;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Allocates a node with one reference, no children, and a copy of a provided key.
+
+    Parameters:
+        key (const void *) : pointer to the key
+        copy (void (*) (void *, const void *)) : pointer to the function that copies a key
+        size (size_t (*) (const void *)) : pointer to the function that returns the size of a key
+
+    Runtime: O(1)
+*/
+static struct pbstNode *createNode(const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Copies a node onto a new path. The copy has the node's key and children, and takes a reference to the
+    child that is not on the path (the caller replaces the other one with a copy).
+
+    Parameters:
+        n (const struct pbstNode *) : pointer to the node
+        goLeft (int) : 1 if the path continues to the left child, 0 if it continues right
+        copy (void (*) (void *, const void *)) : pointer to the function that copies a key
+        size (size_t (*) (const void *)) : pointer to the function that returns the size of a key
+
+    Runtime: O(1)
+*/
+static struct pbstNode *copyNode(const struct pbstNode *n, int goLeft, void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+const void *pbstSearch(const struct pbstNode *root, const void *key, int (*comp)(const void *, const void *))
+{
+    while (root != NULL)
+    {
+        int c = (*comp)(key, root->key);
+        if (c == 0)
+        {
+            return root->key;
+        }
+        root = c < 0 ? root->left : root->right;
+    }
+    return NULL;
+}
+
+struct pbstNode *pbstInsert(struct pbstNode *root, const void *key, int (*comp)(const void *, const void *), void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    // nothing changes for a duplicate, so don't copy a path only to throw it away
+    if (pbstSearch(root, key, comp) != NULL)
+    {
+        return pbstRetain(root);
+    }
+
+    // copy the search path top down, each copy is linked into the previous one, and the new leaf goes where
+    // the search fell off the tree
+    struct pbstNode *newRoot = NULL;
+    struct pbstNode **link = &newRoot;
+    while (root != NULL)
+    {
+        int goLeft = (*comp)(key, root->key) < 0;
+        struct pbstNode *n = copyNode(root, goLeft, copy, size);
+        *link = n;
+        link = goLeft ? &n->left : &n->right;
+        root = goLeft ? root->left : root->right;
+    }
+    *link = createNode(key, copy, size);
+    return newRoot;
+}
+
+struct pbstNode *pbstDelete(struct pbstNode *root, const void *key, int (*comp)(const void *, const void *), void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    if (pbstSearch(root, key, comp) == NULL)
+    {
+        return pbstRetain(root);
+    }
+
+    // copy the path down to (but not including) the node with key
+    struct pbstNode *newRoot = NULL;
+    struct pbstNode **link = &newRoot;
+    int c = (*comp)(key, root->key);
+    while (c != 0)
+    {
+        struct pbstNode *n = copyNode(root, c < 0, copy, size);
+        *link = n;
+        link = c < 0 ? &n->left : &n->right;
+        root = c < 0 ? root->left : root->right;
+        c = (*comp)(key, root->key);
+    }
+
+    if (root->left == NULL || root->right == NULL)
+    {
+        // the node's only subtree (or none) takes its place, shared with the old version
+        *link = pbstRetain(root->left != NULL ? root->left : root->right);
+        return newRoot;
+    }
+
+    // 2 children: the successor's key takes the node's place, and the path from the right child down to the
+    // successor is copied with the successor replaced by its right subtree
+    struct pbstNode *succ = root->right;
+    while (succ->left != NULL)
+    {
+        succ = succ->left;
+    }
+    struct pbstNode *n = createNode(succ->key, copy, size);
+    n->left = pbstRetain(root->left);
+    *link = n;
+    link = &n->right;
+    root = root->right;
+    while (root != succ)
+    {
+        n = copyNode(root, 1, copy, size);
+        *link = n;
+        link = &n->left;
+        root = root->left;
+    }
+    *link = pbstRetain(succ->right);
+    return newRoot;
+}
+
+struct pbstNode *pbstRetain(struct pbstNode *root)
+{
+    if (root != NULL)
+    {
+        atomic_fetch_add_explicit(&root->refs, 1, memory_order_relaxed);
+    }
+    return root;
+}
+
+void pbstRelease(struct pbstNode *root)
+{
+    // nodes whose count dropped to 0 are kept on a stack until their children are released. A node on the
+    // stack is unreachable, so its key pointer is free to link the stack (the key is at KEY_OFFSET anyway).
+    struct pbstNode *stack = NULL;
+    struct pbstNode *children[2] = {root, NULL};
+    while (1)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            struct pbstNode *c = children[i];
+            // acq_rel: the thread that frees a node must see every other thread's use of it as done
+            if (c != NULL && atomic_fetch_sub_explicit(&c->refs, 1, memory_order_acq_rel) == 1)
+            {
+                c->key = (void *)stack;
+                stack = c;
+            }
+        }
+        if (stack == NULL)
+        {
+            return;
+        }
+        struct pbstNode *n = stack;
+        stack = (struct pbstNode *)n->key;
+        children[0] = n->left;
+        children[1] = n->right;
+        free((void *)n);
+    }
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static struct pbstNode *createNode(const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    // node and key in one allocation (note malloc() returns void * hence the cast)
+    struct pbstNode *n = (struct pbstNode *)malloc(KEY_OFFSET + (*size)(key));
+    n->key = (char *)n + KEY_OFFSET;
+    (*copy)(n->key, key);
+    n->left = NULL;
+    n->right = NULL;
+    atomic_init(&n->refs, 1);
+    return n;
+}
+
+static struct pbstNode *copyNode(const struct pbstNode *n, int goLeft, void (*copy)(void *, const void *), size_t (*size)(const void *))
+{
+    struct pbstNode *c = createNode(n->key, copy, size);
+    c->left = goLeft ? n->left : pbstRetain(n->left);
+    c->right = goLeft ? pbstRetain(n->right) : n->right;
+    return c;
+}
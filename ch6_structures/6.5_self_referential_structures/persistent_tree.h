@@ -0,0 +1,119 @@
+/*
+    Contains declarations of a persistent BST for generic keys. Insertion and deletion never modify a tree:
+    they copy the nodes on the path from the root to the change (O(log(n)) nodes in a balanced tree) and return
+    the root of a new version that shares every other node with the old one. Every root therefore stays a
+    consistent, unchanging snapshot of the set at the time it was made, so readers of a version never block and
+    never see a partial update, however many versions are made after it.
+
+    Nodes are shared between versions and freed with reference counting. Every function that returns a root
+    returns a new reference that the caller owns, and the version is freed (except for the nodes later versions
+    share) once every reference to it has been passed to pbstRelease(). The counts are atomic, so different
+    threads may create, read and release versions at once, as long as a thread only takes a new reference
+    (pbstRetain()) to a version it already holds a reference to.
+
+    The search, insertion and deletion algorithms are the ones of bstSearch(), bstInsert() and bstDelete() in
+    trees.h (deletion swaps in the successor), and they take the same key callbacks.
+
+    For runtime calculations of the declared operations, they are done with respect to the number of nodes (n)
+    in the version. Operations regarding key data such as comparison and copying are considered to be O(1).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Opaque node of a persistent BST. A pointer to a node is the root of a version, NULL is the empty version.
+*/
+struct pbstNode;
+
+/*
+    Searches a provided version for a provided key.
+
+    Parameters:
+        root (const struct pbstNode *) : pointer to the root of the version (not modified)
+        key (const void *) : pointer to the key being searched for (not modified)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on keys
+
+    Output:
+        A pointer to the version's copy of key if it is in the version, NULL otherwise. The pointer stays valid
+        as long as a reference to the version is held.
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced
+*/
+const void *pbstSearch(const struct pbstNode *root, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Creates a new version with a provided key inserted into a provided version.
+
+    Parameters:
+        root (struct pbstNode *) : pointer to the root of the version to insert into (not modified, the caller's
+            reference is kept)
+        key (const void *) : pointer to the key to insert
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on keys
+        copy (void (*) (void *, const void *)) : pointer to the function that copies a key (as in bstInsert())
+        size (size_t (*) (const void *)) : pointer to the function that returns the size of a key
+
+    Output:
+        A new reference to the root of the new version. If key was already in the version, that is a reference
+        to root itself, and nothing is copied.
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced
+
+        NOTE: memory allocation is assumed to be independent
+*/
+struct pbstNode *pbstInsert(struct pbstNode *root, const void *key, int (*comp)(const void *, const void *), void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Creates a new version with a provided key deleted from a provided version.
+
+    Parameters:
+        root (struct pbstNode *) : pointer to the root of the version to delete from (not modified, the
+            caller's reference is kept)
+        key (const void *) : pointer to the key to delete (not modified)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on keys
+        copy (void (*) (void *, const void *)) : pointer to the function that copies a key (the copied path
+            includes keys that move)
+        size (size_t (*) (const void *)) : pointer to the function that returns the size of a key
+
+    Output:
+        A new reference to the root of the new version (NULL if it is empty). If key was not in the version,
+        that is a reference to root itself, and nothing is copied.
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced
+*/
+struct pbstNode *pbstDelete(struct pbstNode *root, const void *key, int (*comp)(const void *, const void *), void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Takes a new reference to a provided version, e.g. to hand a snapshot to a reader thread.
+
+    Parameters:
+        root (struct pbstNode *) : pointer to the root of the version, which the caller holds a reference to
+            (may be NULL)
+
+    Output:
+        root, as a new reference.
+
+    Runtime: O(1)
+*/
+struct pbstNode *pbstRetain(struct pbstNode *root);
+
+/*
+    Gives up a reference to a provided version. The nodes no other version or reference uses are freed.
+
+    Parameters:
+        root (struct pbstNode *) : pointer to the root of the version (may be NULL)
+
+    Output:
+        The caller's reference is released. The calling function should set root to NULL afterwards to avoid
+        undefined behavior.
+
+    Runtime: O(# nodes freed)
+*/
+void pbstRelease(struct pbstNode *root);
+
+#endif
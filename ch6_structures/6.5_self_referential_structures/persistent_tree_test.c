@@ -0,0 +1,144 @@
+#include "persistent_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#define VERSIONS 1000 // number of versions made by the version test
+
+int comp(const void *a, const void *b);
+void copy(void *dst, const void *src);
+size_t stralloc(const void *key);
+void snapshotTest(void);
+void versionTest(void);
+
+int main()
+{
+    snapshotTest();
+    versionTest();
+    return 0;
+}
+
+void snapshotTest(void)
+{
+    const char *words[] = {"m", "f", "t", "c", "h", "p", "w", "a", "e", "k"};
+    struct pbstNode *v = NULL;
+    for (int i = 0; i < 10; i++)
+    {
+        struct pbstNode *next = pbstInsert(v, words[i], comp, copy, stralloc);
+        pbstRelease(v);
+        v = next;
+    }
+
+    // a reader keeps this version while the writer goes on
+    struct pbstNode *snapshot = pbstRetain(v);
+
+    // "f" has 2 children, its successor "h" moves up. "w" is a leaf.
+    struct pbstNode *next = pbstDelete(v, "f", comp, copy, stralloc);
+    pbstRelease(v);
+    v = pbstDelete(next, "w", comp, copy, stralloc);
+    pbstRelease(next);
+    next = pbstInsert(v, "z", comp, copy, stralloc);
+    pbstRelease(v);
+    v = next;
+
+    printf("%d %d %d\n", pbstSearch(v, "f", comp) != NULL, pbstSearch(v, "w", comp) != NULL, pbstSearch(v, "z", comp) != NULL);                      // 0 0 1
+    printf("%d %d %d\n", pbstSearch(snapshot, "f", comp) != NULL, pbstSearch(snapshot, "w", comp) != NULL, pbstSearch(snapshot, "z", comp) != NULL); // 1 1 0
+    printf("%s\n", (const char *)pbstSearch(v, "h", comp)); // h
+
+    // nothing to change: the same version comes back
+    next = pbstDelete(v, "q", comp, copy, stralloc);
+    printf("%d\n", next == v); // 1
+    pbstRelease(next);
+    next = pbstInsert(v, "m", comp, copy, stralloc);
+    printf("%d\n", next == v); // 1
+    pbstRelease(next);
+
+    // releasing the newer version first leaves the snapshot intact
+    pbstRelease(v);
+    printf("%s\n", (const char *)pbstSearch(snapshot, "k", comp)); // k
+    pbstRelease(snapshot);
+    printf("SNAPSHOT TEST DONE.\n");
+}
+
+void versionTest(void)
+{
+    // version i holds the keys 0, ..., i - 1 (in a shuffled insertion order), except that every version after
+    // VERSIONS / 2 deletes one of the first keys again
+    struct pbstNode **versions = (struct pbstNode **)malloc((VERSIONS + 1) * sizeof(struct pbstNode *));
+    int *order = (int *)malloc(VERSIONS * sizeof(int));
+    char key[16];
+    for (int i = 0; i < VERSIONS; i++)
+    {
+        order[i] = i;
+    }
+    srand(41);
+    for (int i = VERSIONS - 1; i > 0; i--)
+    {
+        int j = rand() % (i + 1);
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    versions[0] = NULL;
+    for (int i = 0; i < VERSIONS; i++)
+    {
+        sprintf(key, "%06d", order[i]);
+        versions[i + 1] = pbstInsert(versions[i], key, comp, copy, stralloc);
+    }
+    struct pbstNode *v = pbstRetain(versions[VERSIONS]);
+    for (int i = 0; i < VERSIONS / 2; i++)
+    {
+        sprintf(key, "%06d", order[i]);
+        struct pbstNode *next = pbstDelete(v, key, comp, copy, stralloc);
+        pbstRelease(v);
+        v = next;
+    }
+
+    // every version still holds exactly the keys it was made with
+    int ok = 1;
+    for (int i = 0; i <= VERSIONS; i++)
+    {
+        for (int j = 0; j < VERSIONS; j++)
+        {
+            sprintf(key, "%06d", order[j]);
+            ok = ok && (pbstSearch(versions[i], key, comp) != NULL) == (j < i);
+        }
+    }
+    for (int j = 0; j < VERSIONS; j++)
+    {
+        sprintf(key, "%06d", order[j]);
+        ok = ok && (pbstSearch(v, key, comp) != NULL) == (j >= VERSIONS / 2);
+    }
+    printf("%d\n", ok); // 1
+
+    // release the versions in an arbitrary order, shared nodes are freed with the last version using them
+    for (int i = 0; i <= VERSIONS; i += 2)
+    {
+        pbstRelease(versions[i]);
+    }
+    pbstRelease(v);
+    for (int i = 1; i <= VERSIONS; i += 2)
+    {
+        pbstRelease(versions[i]);
+    }
+    free(versions);
+    free(order);
+    printf("VERSION TEST DONE.\n");
+}
+
+int comp(const void *a, const void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+void copy(void *dst, const void *src)
+{
+    strcpy((char *)dst, (const char *)src);
+}
+
+size_t stralloc(const void *key)
+{
+    return strlen((const char *)key) + 1;
+}
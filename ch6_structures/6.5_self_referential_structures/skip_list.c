@@ -0,0 +1,694 @@
+/*
+    Contains implementation of the lock-free skip list declared in skip_list.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    Links are atomic uintptr_t values holding a node pointer whose lowest bit is the mark (nodes are at least
+    pointer aligned, so the bit is otherwise 0). A marked link belongs to a node being deleted and is never
+    changed again, so a CAS on a predecessor's link fails once the predecessor is marked, and no node can be
+    linked after a node that is being deleted.
+
+    A deletion marks the node's links from the top level down, and the thread whose CAS marks the bottom link is
+    the one that deleted the key. find() unlinks every marked node it passes, so the deleting thread calls it
+    once more to unlink its node from every level. The inserting thread may still be linking the node into the
+    upper levels at that point, and a level linked after that unlinking pass would leave the freed node
+    reachable. So the inserting thread, once it is done and sees the node marked, also calls find(), and the
+    node is retired by whichever of the 2 threads finishes second (the INSERTED and UNLINKED bits of state).
+
+    Epoch based reclamation: there is a global epoch, and every thread that uses a list has a record in it with
+    the epoch it read when it started its current operation. An operation's reads of nodes happen between
+    setting its record active and clearing it. A retired node is stamped with the global epoch read after it
+    was unlinked, and the global epoch only advances when every active record has seen the current one. Any
+    thread that could still hold the node started its operation before the node was retired, so once the global
+    epoch is 2 past the stamp, that thread has finished its operation, and the node is freed.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "skip_list.h" // needed for skip list operations
+#include <stdatomic.h> // needed for atomic operations and fences
+#include <stdint.h>    // needed for uintptr_t, uint64_t
+#include <stdlib.h>    // needed for malloc(), free()
+#include <stddef.h>    // needed for size_t
+#include <string.h>    // needed for memcpy()
+
+// ***************************** CONSTANTS ***********************************************
+
+#define MAX_LEVEL 32      // number of levels, enough for 2^32 keys
+#define RECLAIM_BATCH 64  // retired nodes a thread collects before it tries to free them
+
+// bits of a node's state, see the comment at the top of the file
+#define INSERTED 1
+#define UNLINKED 2
+
+// kinds of search done by seek()
+#define SEEK_GE 0 // first key >= the probe (the minimum if the probe is NULL)
+#define SEEK_GT 1 // first key > the probe
+#define SEEK_LT 2 // last key < the probe (the maximum if the probe is NULL)
+
+// marked links
+#define IS_MARKED(link) ((link) & 1)
+#define MARKED(link) ((link) | 1)
+#define NODE_OF(link) ((struct skipNode *)((link) & ~(uintptr_t)1))
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a node of the list.
+
+    Fields:
+        key (char *) : pointer to the node's copy of its key, stored after next in the same allocation
+        height (int) : number of levels the node is in (MAX_LEVEL for the head)
+        state (atomic_int) : INSERTED and UNLINKED bits of a node being deleted
+        retired (struct skipNode *) : next node in the retire list of the thread that retired it
+        retiredAt (uint64_t) : global epoch read after the node was unlinked
+        next (_Atomic uintptr_t []) : the node's link in each of its levels, possibly marked (flexible array
+            member)
+*/
+struct skipNode
+{
+    char *key;
+    int height;
+    atomic_int state;
+    struct skipNode *retired;
+    uint64_t retiredAt;
+    _Atomic uintptr_t next[];
+};
+
+/*
+    Structure for a thread's epoch record in a list. Records are only added (at the front, with a CAS), and are
+    freed with the list.
+
+    Fields:
+        epoch (_Atomic uint64_t) : global epoch read when the thread started its current operation
+        active (atomic_int) : 1 while the thread is in an operation
+        owner (const void *) : address of the thread's threadMarker, which identifies the thread
+        next (struct epochRecord *) : next record of the list
+        retired (struct skipNode *) : nodes retired by the thread and not freed yet
+        pending (size_t) : number of nodes in retired
+        threshold (size_t) : value of pending at which the thread tries to free them
+        random (uint64_t) : state of the thread's random number generator for node heights
+*/
+struct epochRecord
+{
+    _Atomic uint64_t epoch;
+    atomic_int active;
+    const void *owner;
+    struct epochRecord *next;
+    struct skipNode *retired;
+    size_t pending;
+    size_t threshold;
+    uint64_t random;
+};
+
+/*
+    Structure that represents a skip list.
+
+    Fields:
+        head (struct skipNode *) : node before every key, in every level
+        comp (int (*) (const void *, const void *)) : key comparison function
+        keySize (size_t) : size of every key
+        count (atomic_size_t) : number of keys
+        epoch (_Atomic uint64_t) : global epoch
+        records (_Atomic(struct epochRecord *)) : epoch records of the threads that have used the list
+        id (uint64_t) : number that identifies the list in the threads' record caches
+*/
+struct SkipList
+{
+    struct skipNode *head;
+    int (*comp)(const void *, const void *);
+    size_t keySize;
+    atomic_size_t count;
+    _Atomic uint64_t epoch;
+    _Atomic(struct epochRecord *) records;
+    uint64_t id;
+};
+
+// list ids, so that a thread's cached record is never mistaken for one of a freed list at the same address
+static _Atomic uint64_t nextListId = 1;
+
+// a thread's last used list and its record there, and a variable whose address identifies the thread
+static _Thread_local uint64_t cachedListId = 0;
+static _Thread_local struct epochRecord *cachedRecord = NULL;
+static _Thread_local char threadMarker;
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Allocates a node of a provided height with a copy of a key (or no key for the head), unlinked.
+
+    Parameters:
+        t (const SkipList *) : pointer to the list
+        key (const void *) : pointer to the key, or NULL
+        height (int) : number of levels
+
+    Runtime: O(height)
+*/
+static struct skipNode *createNode(const SkipList *t, const void *key, int height);
+
+/*
+    Start and end an operation on a list by the calling thread (see the comment at the top of the file).
+    enter() finds or adds the thread's record, and leave() frees the thread's retired nodes once enough have
+    been collected.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        record (struct epochRecord *) : the record returned by enter()
+
+    Output:
+        enter() returns the thread's record.
+
+    Runtime: O(1), O(# threads) the first time a thread uses the list, O(# threads + # retired nodes) for a
+        leave() that frees
+*/
+static struct epochRecord *enter(SkipList *t);
+static void leave(SkipList *t, struct epochRecord *record);
+
+/*
+    Adds an unlinked node to the calling thread's retire list.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        record (struct epochRecord *) : the thread's record
+        node (struct skipNode *) : pointer to the node, unreachable from the list
+
+    Runtime: O(1)
+*/
+static void retire(SkipList *t, struct epochRecord *record, struct skipNode *node);
+
+/*
+    Advances the global epoch if every active record has seen it, then frees the nodes of a record's retire
+    list that are 2 epochs old.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        record (struct epochRecord *) : the record
+
+    Runtime: O(# threads + # retired nodes)
+*/
+static void reclaim(SkipList *t, struct epochRecord *record);
+
+/*
+    Draws the height of a new node: 1 plus the number of heads before the first tail, at most MAX_LEVEL.
+
+    Parameters:
+        record (struct epochRecord *) : the thread's record, whose generator is used
+
+    Runtime: O(1)
+*/
+static int randomHeight(struct epochRecord *record);
+
+/*
+    Finds the place of a key in every level, unlinking the marked nodes passed on the way.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        key (const void *) : pointer to the key
+        preds (struct skipNode **) : for each level, where the last node with a key < key is stored
+        succs (struct skipNode **) : for each level, where the node after preds[level] is stored (NULL at the
+            end of the level)
+
+    Output:
+        1 if key is in the list (succs[0] holds it), 0 otherwise.
+
+    Runtime: O(log(n))
+*/
+static int find(SkipList *t, const void *key, struct skipNode **preds, struct skipNode **succs);
+
+/*
+    Searches the list without writing to it, stepping over marked nodes.
+
+    Parameters:
+        t (const SkipList *) : pointer to the list
+        key (const void *) : pointer to the probe, or NULL (see SEEK_GE and SEEK_LT)
+        mode (int) : SEEK_GE, SEEK_GT, or SEEK_LT
+
+    Output:
+        The node found, or NULL if there is none.
+
+    Runtime: O(log(n))
+*/
+static struct skipNode *seek(const SkipList *t, const void *key, int mode);
+
+/*
+    Copies the key of a node found by seek() out of the list.
+
+    Parameters:
+        t (const SkipList *) : pointer to the list
+        node (const struct skipNode *) : the node, or NULL
+        out (void *) : where the key is copied
+
+    Output:
+        1 if node is not NULL (and its key was copied), 0 otherwise.
+
+    Runtime: O(1)
+*/
+static int copyOut(const SkipList *t, const struct skipNode *node, void *out);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+SkipList *skipCreate(size_t keySize, int (*comp)(const void *, const void *))
+{
+    if (keySize == 0)
+    {
+        return NULL;
+    }
+    SkipList *t = (SkipList *)malloc(sizeof(SkipList));
+    t->comp = comp;
+    t->keySize = keySize;
+    t->head = createNode(t, NULL, MAX_LEVEL);
+    atomic_init(&t->count, 0);
+    atomic_init(&t->epoch, 0);
+    atomic_init(&t->records, NULL);
+    t->id = atomic_fetch_add(&nextListId, 1);
+    return t;
+}
+
+int skipSearch(SkipList *t, const void *key)
+{
+    struct epochRecord *record = enter(t);
+    struct skipNode *n = seek(t, key, SEEK_GE);
+    int found = n != NULL && (*t->comp)(n->key, key) == 0;
+    leave(t, record);
+    return found;
+}
+
+int skipMinimum(SkipList *t, void *out)
+{
+    struct epochRecord *record = enter(t);
+    int found = copyOut(t, seek(t, NULL, SEEK_GE), out);
+    leave(t, record);
+    return found;
+}
+
+int skipMaximum(SkipList *t, void *out)
+{
+    struct epochRecord *record = enter(t);
+    int found = copyOut(t, seek(t, NULL, SEEK_LT), out);
+    leave(t, record);
+    return found;
+}
+
+int skipPredecessor(SkipList *t, const void *key, void *out)
+{
+    struct epochRecord *record = enter(t);
+    int found = copyOut(t, seek(t, key, SEEK_LT), out);
+    leave(t, record);
+    return found;
+}
+
+int skipSuccessor(SkipList *t, const void *key, void *out)
+{
+    struct epochRecord *record = enter(t);
+    int found = copyOut(t, seek(t, key, SEEK_GT), out);
+    leave(t, record);
+    return found;
+}
+
+int skipInsert(SkipList *t, const void *key)
+{
+    struct skipNode *preds[MAX_LEVEL];
+    struct skipNode *succs[MAX_LEVEL];
+    struct epochRecord *record = enter(t);
+    int height = randomHeight(record);
+    struct skipNode *node = NULL;
+
+    // linking the node into the bottom level inserts the key
+    while (1)
+    {
+        if (find(t, key, preds, succs))
+        {
+            // the node was never reachable, so it can be freed right away
+            free((void *)node);
+            leave(t, record);
+            return 0;
+        }
+        if (node == NULL)
+        {
+            node = createNode(t, key, height);
+        }
+        for (int level = 0; level < height; level++)
+        {
+            atomic_store_explicit(&node->next[level], (uintptr_t)succs[level], memory_order_relaxed);
+        }
+        uintptr_t expected = (uintptr_t)succs[0];
+        if (atomic_compare_exchange_strong(&preds[0]->next[0], &expected, (uintptr_t)node))
+        {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&t->count, 1, memory_order_relaxed);
+
+    // then the levels above, unless the node is being deleted
+    for (int level = 1; level < height; level++)
+    {
+        while (1)
+        {
+            uintptr_t link = atomic_load(&node->next[level]);
+            if (IS_MARKED(link))
+            {
+                level = height;
+                break;
+            }
+            // the node must point to the current successor before it is linked in front of it
+            if (NODE_OF(link) != succs[level] && !atomic_compare_exchange_strong(&node->next[level], &link, (uintptr_t)succs[level]))
+            {
+                continue;
+            }
+            uintptr_t expected = (uintptr_t)succs[level];
+            if (atomic_compare_exchange_strong(&preds[level]->next[level], &expected, (uintptr_t)node))
+            {
+                break;
+            }
+            // the neighbors changed, find them again (the node is gone from the bottom level if it was deleted)
+            find(t, key, preds, succs);
+            if (succs[0] != node)
+            {
+                level = height;
+                break;
+            }
+        }
+    }
+
+    // a deletion may have unlinked the node before the last levels were linked, unlink those too
+    if (IS_MARKED(atomic_load(&node->next[0])))
+    {
+        find(t, key, preds, succs);
+    }
+    if (atomic_fetch_or(&node->state, INSERTED) & UNLINKED)
+    {
+        retire(t, record, node);
+    }
+    leave(t, record);
+    return 1;
+}
+
+int skipDelete(SkipList *t, const void *key)
+{
+    struct skipNode *preds[MAX_LEVEL];
+    struct skipNode *succs[MAX_LEVEL];
+    struct epochRecord *record = enter(t);
+    if (!find(t, key, preds, succs))
+    {
+        leave(t, record);
+        return 0;
+    }
+
+    // mark the upper levels (whoever marks them), then race for the bottom one
+    struct skipNode *node = succs[0];
+    for (int level = node->height - 1; level > 0; level--)
+    {
+        uintptr_t link = atomic_load(&node->next[level]);
+        while (!IS_MARKED(link) && !atomic_compare_exchange_weak(&node->next[level], &link, MARKED(link)))
+        {
+        }
+    }
+    uintptr_t link = atomic_load(&node->next[0]);
+    while (1)
+    {
+        if (IS_MARKED(link))
+        {
+            // another thread deleted the key first
+            leave(t, record);
+            return 0;
+        }
+        if (atomic_compare_exchange_weak(&node->next[0], &link, MARKED(link)))
+        {
+            break;
+        }
+    }
+    atomic_fetch_sub_explicit(&t->count, 1, memory_order_relaxed);
+
+    find(t, key, preds, succs);
+    if (atomic_fetch_or(&node->state, UNLINKED) & INSERTED)
+    {
+        retire(t, record, node);
+    }
+    leave(t, record);
+    return 1;
+}
+
+size_t skipRange(SkipList *t, const void *low, const void *high, void (*visit)(const void *, void *), void *arg)
+{
+    struct epochRecord *record = enter(t);
+    size_t count = 0;
+    struct skipNode *n = seek(t, low, SEEK_GE);
+    while (n != NULL)
+    {
+        uintptr_t link = atomic_load(&n->next[0]);
+        if (!IS_MARKED(link))
+        {
+            if (high != NULL && (*t->comp)(n->key, high) > 0)
+            {
+                break;
+            }
+            (*visit)(n->key, arg);
+            count++;
+        }
+        n = NODE_OF(link);
+    }
+    leave(t, record);
+    return count;
+}
+
+size_t skipSize(SkipList *t)
+{
+    return atomic_load_explicit(&t->count, memory_order_relaxed);
+}
+
+void skipFree(SkipList *t)
+{
+    // with no thread in an operation, every deleted node has been retired, so the nodes still in the bottom
+    // level and the retire lists are all the nodes, once each
+    struct skipNode *n = t->head;
+    while (n != NULL)
+    {
+        struct skipNode *next = NODE_OF(atomic_load(&n->next[0]));
+        free((void *)n);
+        n = next;
+    }
+    struct epochRecord *r = atomic_load(&t->records);
+    while (r != NULL)
+    {
+        struct epochRecord *next = r->next;
+        while (r->retired != NULL)
+        {
+            struct skipNode *retired = r->retired->retired;
+            free((void *)r->retired);
+            r->retired = retired;
+        }
+        free((void *)r);
+        r = next;
+    }
+    free((void *)t);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static struct skipNode *createNode(const SkipList *t, const void *key, int height)
+{
+    // key goes after the links, rounded up so that it is aligned for any standard type
+    size_t keyOffset = sizeof(struct skipNode) + (size_t)height * sizeof(uintptr_t);
+    keyOffset = (keyOffset + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+    struct skipNode *n = (struct skipNode *)malloc(keyOffset + (key != NULL ? t->keySize : 0));
+    n->key = key != NULL ? (char *)n + keyOffset : NULL;
+    if (key != NULL)
+    {
+        memcpy(n->key, key, t->keySize);
+    }
+    n->height = height;
+    atomic_init(&n->state, 0);
+    n->retired = NULL;
+    n->retiredAt = 0;
+    for (int level = 0; level < height; level++)
+    {
+        atomic_init(&n->next[level], (uintptr_t)0);
+    }
+    return n;
+}
+
+static struct epochRecord *enter(SkipList *t)
+{
+    struct epochRecord *record = cachedRecord;
+    if (cachedListId != t->id)
+    {
+        // look for the thread's record, and add one if it has none
+        record = atomic_load(&t->records);
+        while (record != NULL && record->owner != (const void *)&threadMarker)
+        {
+            record = record->next;
+        }
+        if (record == NULL)
+        {
+            record = (struct epochRecord *)malloc(sizeof(struct epochRecord));
+            atomic_init(&record->epoch, 0);
+            atomic_init(&record->active, 0);
+            record->owner = (const void *)&threadMarker;
+            record->retired = NULL;
+            record->pending = 0;
+            record->threshold = RECLAIM_BATCH;
+            record->random = (uint64_t)(uintptr_t)record * 0x9E3779B97F4A7C15ULL | 1;
+            record->next = atomic_load(&t->records);
+            while (!atomic_compare_exchange_weak(&t->records, &record->next, record))
+            {
+            }
+        }
+        cachedListId = t->id;
+        cachedRecord = record;
+    }
+
+    // the record must be seen as active with this epoch before any node is read (sequentially consistent
+    // stores and loads, so a thread advancing the epoch sees it)
+    atomic_store(&record->active, 1);
+    atomic_store(&record->epoch, atomic_load(&t->epoch));
+    atomic_thread_fence(memory_order_seq_cst);
+    return record;
+}
+
+static void leave(SkipList *t, struct epochRecord *record)
+{
+    atomic_store(&record->active, 0);
+    if (record->pending >= record->threshold)
+    {
+        reclaim(t, record);
+    }
+}
+
+static void retire(SkipList *t, struct epochRecord *record, struct skipNode *node)
+{
+    node->retiredAt = atomic_load(&t->epoch);
+    node->retired = record->retired;
+    record->retired = node;
+    record->pending++;
+}
+
+static void reclaim(SkipList *t, struct epochRecord *record)
+{
+    uint64_t epoch = atomic_load(&t->epoch);
+    int current = 1;
+    for (struct epochRecord *r = atomic_load(&t->records); r != NULL && current; r = r->next)
+    {
+        current = !atomic_load(&r->active) || atomic_load(&r->epoch) == epoch;
+    }
+    if (current && atomic_compare_exchange_strong(&t->epoch, &epoch, epoch + 1))
+    {
+        epoch++;
+    }
+
+    struct skipNode **link = &record->retired;
+    while (*link != NULL)
+    {
+        struct skipNode *n = *link;
+        if (n->retiredAt + 2 <= epoch)
+        {
+            *link = n->retired;
+            free((void *)n);
+            record->pending--;
+        }
+        else
+        {
+            link = &n->retired;
+        }
+    }
+    // nodes that could not be freed yet wait for another batch, so the list is not scanned on every leave()
+    record->threshold = record->pending + RECLAIM_BATCH;
+}
+
+static int randomHeight(struct epochRecord *record)
+{
+    // xorshift64*, whose bits are used as coin flips
+    record->random ^= record->random >> 12;
+    record->random ^= record->random << 25;
+    record->random ^= record->random >> 27;
+    uint64_t bits = record->random * 2685821657736338717ULL;
+    int height = 1;
+    while (height < MAX_LEVEL && (bits & 1))
+    {
+        height++;
+        bits >>= 1;
+    }
+    return height;
+}
+
+static int find(SkipList *t, const void *key, struct skipNode **preds, struct skipNode **succs)
+{
+    struct skipNode *pred = NULL;
+retry:
+    pred = t->head;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--)
+    {
+        struct skipNode *curr = NODE_OF(atomic_load(&pred->next[level]));
+        while (curr != NULL)
+        {
+            uintptr_t succ = atomic_load(&curr->next[level]);
+            if (IS_MARKED(succ))
+            {
+                // unlink curr from this level, which fails if pred changed or is being deleted too
+                uintptr_t expected = (uintptr_t)curr;
+                if (!atomic_compare_exchange_strong(&pred->next[level], &expected, (uintptr_t)NODE_OF(succ)))
+                {
+                    goto retry;
+                }
+                curr = NODE_OF(succ);
+                continue;
+            }
+            if ((*t->comp)(curr->key, key) >= 0)
+            {
+                break;
+            }
+            pred = curr;
+            curr = NODE_OF(succ);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] != NULL && (*t->comp)(succs[0]->key, key) == 0;
+}
+
+static struct skipNode *seek(const SkipList *t, const void *key, int mode)
+{
+    struct skipNode *pred = t->head;
+    struct skipNode *curr = NULL;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--)
+    {
+        curr = NODE_OF(atomic_load(&pred->next[level]));
+        while (curr != NULL)
+        {
+            uintptr_t succ = atomic_load(&curr->next[level]);
+            // deleted, step over it without unlinking it
+            if (IS_MARKED(succ))
+            {
+                curr = NODE_OF(succ);
+                continue;
+            }
+            // a NULL probe is above every key for SEEK_LT, and below every key otherwise
+            int c = key != NULL ? (*t->comp)(curr->key, key) : (mode == SEEK_LT ? -1 : 1);
+            if (c > 0 || (c == 0 && mode != SEEK_GT))
+            {
+                break;
+            }
+            pred = curr;
+            curr = NODE_OF(succ);
+        }
+    }
+    return mode == SEEK_LT ? (pred != t->head ? pred : NULL) : curr;
+}
+
+static int copyOut(const SkipList *t, const struct skipNode *node, void *out)
+{
+    if (node == NULL)
+    {
+        return 0;
+    }
+    memcpy(out, node->key, t->keySize);
+    return 1;
+}
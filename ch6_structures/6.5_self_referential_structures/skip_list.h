@@ -0,0 +1,185 @@
+/*
+    Contains declarations of a lock-free ordered set for fixed size generic keys, which may be used by many
+    threads at once without an outside lock. It supports the ordered set operations of trees.h (search, minimum,
+    maximum, predecessor, successor, insertion, deletion, range).
+
+    It is a skip list: a sorted linked list of the keys, where each node is also linked into a random number of
+    express lists above it (a node is in level i + 1 with probability 1/2 if it is in level i), so a search
+    skips most of the list from the top level down in O(log(n)) expected steps. Unlike a tree, there is nothing
+    to rebalance, so every change is a few compare-and-swaps (CAS) on the links next to the key, and threads
+    changing different parts of the set never wait for each other:
+
+        -   An insertion links the new node into the bottom list with one CAS, which makes the key present, then
+            into the lists above.
+        -   A deletion marks the node's links (a bit in each next pointer), the bottom one last, which makes the
+            key absent, and then any thread that passes the node unlinks it with a CAS.
+        -   Searches take no locks and write nothing, they step over marked nodes.
+
+    A node that has been unlinked may still be being read by a thread that reached it earlier, so it is freed
+    only once every thread that was in an operation at the time has finished one (epoch based reclamation).
+
+    Requirements:
+        1.  C11 atomics (<stdatomic.h>) and thread local storage (_Thread_local).
+        2.  A thread stopped in the middle of an operation (e.g. descheduled for a long time) holds back the
+            freeing of deleted nodes, though not the other threads' operations.
+
+    For runtime calculations of the declared operations, they are done with respect to the number of keys (n)
+    in the list, without contention (a failed CAS repeats part of the operation). They are expected runtimes,
+    as the shape of the list is random.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the SkipList. It is implemented via a structure that holds the head node, the state of
+    the epoch based reclamation, and the parameters supplied to skipCreate().
+*/
+typedef struct SkipList SkipList;
+
+/*
+    Creates an empty SkipList.
+
+    Parameters:
+        keySize (size_t) : size in bytes of every key (keys are copied with memcpy())
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used on keys. The
+            keys in the list never change, so it may be any comparison function.
+
+    Output:
+        A pointer to the created SkipList, or NULL if keySize is 0. Unlike the other operations, creation is not
+        thread-safe (the list must be created before it is shared).
+
+    Runtime: O(1)
+*/
+SkipList *skipCreate(size_t keySize, int (*comp)(const void *, const void *));
+
+/*
+    Searches a provided list for a provided key.
+
+    Parameters:
+        t (SkipList *) : pointer to the list to search
+        key (const void *) : pointer to the key (not modified)
+
+    Output:
+        1 if key is in the list, 0 otherwise.
+
+    Runtime: O(log(n))
+*/
+int skipSearch(SkipList *t, const void *key);
+
+/*
+    Retrieve the minimum and maximum keys of a provided list. Pointers into the list would be unsafe once
+    returned, so the key found is copied out.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        out (void *) : pointer to keySize bytes where the key found is copied
+
+    Output:
+        1 if the list has a key (copied into out), 0 if it is empty.
+
+    Runtime: O(1) for the minimum, O(log(n)) for the maximum
+*/
+int skipMinimum(SkipList *t, void *out);
+int skipMaximum(SkipList *t, void *out);
+
+/*
+    Retrieve the largest key smaller (smallest key larger) than a provided key. The key does not need to be in
+    the list.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        key (const void *) : pointer to the key (not modified)
+        out (void *) : pointer to keySize bytes where the key found is copied (may be the same as key)
+
+    Output:
+        1 if there is a predecessor (successor) and it was copied into out, 0 otherwise.
+
+    Runtime: O(log(n))
+*/
+int skipPredecessor(SkipList *t, const void *key, void *out);
+int skipSuccessor(SkipList *t, const void *key, void *out);
+
+/*
+    Inserts a copy of a provided key into a provided list.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        key (const void *) : pointer to the key to insert (keySize bytes are copied)
+
+    Output:
+        1 if key was inserted, 0 if it was already in the list.
+
+    Runtime: O(log(n))
+
+        NOTE: memory allocation is assumed to be independent
+*/
+int skipInsert(SkipList *t, const void *key);
+
+/*
+    Deletes a provided key from a provided list.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        key (const void *) : pointer to the key to delete (not modified)
+
+    Output:
+        1 if key was deleted, 0 if it was not in the list (or another thread deleted it first).
+
+    Runtime: O(log(n))
+*/
+int skipDelete(SkipList *t, const void *key);
+
+/*
+    Visits the keys of a provided list in a range, in order. Keys inserted or deleted by other threads during
+    the walk may or may not be visited, but the keys visited are always increasing.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+        low (const void *) : pointer to the smallest key to visit (not modified), or NULL to start at the minimum
+        high (const void *) : pointer to the largest key to visit (not modified), or NULL to stop at the maximum
+        visit (void (*) (const void *, void *)) : function called with each key and arg. The key pointer is only
+            valid during the call, and visit must not call the other operations on t.
+        arg (void *) : passed to every call of visit (may be NULL)
+
+    Output:
+        The number of keys visited.
+
+    Runtime: O(log(n) + # keys visited)
+*/
+size_t skipRange(SkipList *t, const void *low, const void *high, void (*visit)(const void *, void *), void *arg);
+
+/*
+    Retrieves the number of keys in a provided list. While other threads are inserting or deleting, the result
+    is only a snapshot.
+
+    Parameters:
+        t (SkipList *) : pointer to the list
+
+    Output:
+        The number of keys in the list.
+
+    Runtime: O(1)
+*/
+size_t skipSize(SkipList *t);
+
+/*
+    De-allocates the memory allocated to a provided list. No other thread may be using the list.
+
+    Parameters:
+        t (SkipList *) : pointer to the list to free
+
+    Output:
+        The list, all of its nodes, and the deleted nodes not yet freed are freed. The calling function should
+        set t to NULL afterwards to avoid undefined behavior.
+
+    Runtime: O(n + # threads that used the list)
+*/
+void skipFree(SkipList *t);
+
+#endif
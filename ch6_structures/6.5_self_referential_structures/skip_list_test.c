@@ -0,0 +1,237 @@
+#include "skip_list.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#define THREADS 4        // number of writer threads, and of reader threads
+#define PER_THREAD 50000 // keys inserted by each writer
+#define CHURN_KEYS 64    // keys all threads of the churn test insert and delete
+
+SkipList *t = NULL;
+
+int intCmp(const void *a, const void *b);
+void printVisit(const void *key, void *arg);
+void orderVisit(const void *key, void *arg);
+void *writer(void *arg);
+void *reader(void *arg);
+void *churner(void *arg);
+void smallTest(void);
+void threadTest(void);
+void churnTest(void);
+
+int main()
+{
+    smallTest();
+    threadTest();
+    churnTest();
+    return 0;
+}
+
+void smallTest(void)
+{
+    printf("%p\n", (void *)skipCreate(0, intCmp)); // (nil)
+
+    // the keys come in backwards, every insertion links at the head of the bottom list
+    t = skipCreate(sizeof(int), intCmp);
+    for (int k = 90; k >= 0; k -= 10)
+    {
+        skipInsert(t, &k);
+    }
+    size_t count = skipRange(t, &(int){15}, &(int){50}, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // 20 30 40 50 \n 4
+    count = skipRange(t, NULL, &(int){25}, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // 0 10 20 \n 3
+    count = skipRange(t, &(int){85}, NULL, printVisit, NULL);
+    printf("\n%u\n", (unsigned)count); // 90 \n 1
+
+    // a deleted key is absent as soon as its node is marked, and the same key can be inserted again
+    printf("%d\n", skipDelete(t, &(int){50})); // 1
+    printf("%d\n", skipDelete(t, &(int){50})); // 0
+    printf("%d\n", skipSearch(t, &(int){50})); // 0
+    int out = 50;
+    skipPredecessor(t, &out, &out);
+    printf("%d\n", out);                       // 40
+    printf("%d\n", skipInsert(t, &(int){50})); // 1
+    printf("%d\n", skipInsert(t, &(int){50})); // 0
+    printf("%u\n", (unsigned)skipSize(t));     // 10
+
+    // nothing is copied out past either end
+    out = -1;
+    printf("%d\n", skipSuccessor(t, &(int){90}, &out));  // 0
+    printf("%d\n", skipPredecessor(t, &(int){0}, &out)); // 0
+    printf("%d\n", out);                                 // -1
+    skipMaximum(t, &out);
+    printf("%d\n", out); // 90
+
+    skipFree(t);
+    t = NULL;
+    printf("SMALL TEST DONE.\n");
+}
+
+void threadTest(void)
+{
+    t = skipCreate(sizeof(int), intCmp);
+    pthread_t writers[THREADS];
+    pthread_t readers[THREADS];
+    int ids[THREADS];
+    int ok[THREADS];
+    for (int i = 0; i < THREADS; i++)
+    {
+        ids[i] = i;
+        ok[i] = i;
+        pthread_create(&writers[i], NULL, writer, &ids[i]);
+        pthread_create(&readers[i], NULL, reader, &ok[i]);
+    }
+    for (int i = 0; i < THREADS; i++)
+    {
+        pthread_join(writers[i], NULL);
+        pthread_join(readers[i], NULL);
+    }
+
+    // each writer inserted its keys (interleaved with the other writers') and deleted the odd ones
+    int found = skipSize(t) == (size_t)(THREADS * PER_THREAD / 2);
+    for (int k = 0; k < THREADS * PER_THREAD; k++)
+    {
+        found = found && skipSearch(t, &k) == (k % 2 == 0);
+    }
+    printf("%d\n", found); // 1
+
+    // the range walk visits exactly the even keys, in order
+    int state[3] = {1, 0, 0};
+    skipRange(t, NULL, NULL, orderVisit, state);
+    printf("%d\n", state[0] && state[1] == THREADS * PER_THREAD / 2); // 1
+
+    int readersOk = 1;
+    for (int i = 0; i < THREADS; i++)
+    {
+        readersOk = readersOk && ok[i];
+    }
+    printf("%d\n", readersOk); // 1
+
+    skipFree(t);
+    t = NULL;
+    printf("THREAD TEST DONE.\n");
+}
+
+void churnTest(void)
+{
+    // every thread inserts and deletes the same few keys, so nodes are deleted while others are still being
+    // linked or read, and many are retired and freed
+    t = skipCreate(sizeof(int), intCmp);
+    pthread_t threads[2 * THREADS];
+    int balance[2 * THREADS];
+    for (int i = 0; i < 2 * THREADS; i++)
+    {
+        balance[i] = i;
+        pthread_create(&threads[i], NULL, churner, &balance[i]);
+    }
+    long total = 0;
+    for (int i = 0; i < 2 * THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        total += balance[i];
+    }
+
+    // successful insertions minus successful deletions is what is left
+    int present = 0;
+    for (int k = 0; k < CHURN_KEYS; k++)
+    {
+        present += skipSearch(t, &k);
+    }
+    printf("%d\n", total == present && skipSize(t) == (size_t)present); // 1
+    skipFree(t);
+    t = NULL;
+    printf("CHURN TEST DONE.\n");
+}
+
+void *writer(void *arg)
+{
+    int id = *(int *)arg;
+    for (int i = 0; i < PER_THREAD; i++)
+    {
+        int key = i * THREADS + id;
+        skipInsert(t, &key);
+    }
+    for (int i = 0; i < PER_THREAD; i++)
+    {
+        int key = i * THREADS + id;
+        if (key % 2 == 1)
+        {
+            skipDelete(t, &key);
+        }
+    }
+    return NULL;
+}
+
+void *reader(void *arg)
+{
+    // the keys seen in order must always be increasing, whatever the writers are doing
+    int *ok = (int *)arg;
+    int seed = *ok;
+    *ok = 1;
+    for (int i = 0; i < 2000; i++)
+    {
+        int key = (i * 7919 + seed * 104729) % (THREADS * PER_THREAD);
+        int next = 0;
+        int prev = 0;
+        if (skipSuccessor(t, &key, &next))
+        {
+            *ok = *ok && next > key;
+        }
+        if (skipPredecessor(t, &key, &prev))
+        {
+            *ok = *ok && prev < key;
+        }
+        int state[3] = {1, 0, 0};
+        int high = key + 100;
+        skipRange(t, &key, &high, orderVisit, state);
+        *ok = *ok && state[0];
+        skipSearch(t, &key);
+    }
+    return NULL;
+}
+
+void *churner(void *arg)
+{
+    int *balance = (int *)arg;
+    unsigned seed = (unsigned)*balance + 1;
+    *balance = 0;
+    for (int i = 0; i < 100000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int key = (int)(seed >> 16) % CHURN_KEYS;
+        if (seed & 0x100)
+        {
+            *balance += skipInsert(t, &key);
+        }
+        else
+        {
+            *balance -= skipDelete(t, &key);
+        }
+    }
+    return NULL;
+}
+
+void printVisit(const void *key, void *arg)
+{
+    (void)arg;
+    printf("%d ", *(const int *)key);
+}
+
+void orderVisit(const void *key, void *arg)
+{
+    // state[0] stays 1 while the keys are increasing, state[1] counts them, and state[2] is the last one
+    int *state = (int *)arg;
+    int k = *(const int *)key;
+    state[0] = state[0] && (state[1] == 0 || k > state[2]);
+    state[2] = k;
+    state[1]++;
+}
+
+int intCmp(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
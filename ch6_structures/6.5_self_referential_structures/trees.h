@@ -21,13 +21,23 @@
     Fields: 
         left (struct bstNode *) : pointer to left child (which is a bstNode)
         right (struct bstNode *) : pointer to right child (which is a bstNode)
-        key (void *) : pointer to the data key of any type
+        key (void *) : pointer to the data key of any type. The key is stored in the same allocation as the 
+            node, directly after it, so it is freed with the node.
+        height (int) : number of nodes on the longest path from this node down to a leaf (1 for a leaf). This
+            is only kept up to date by the balanced (AVL) operations avlInsert() and avlDelete().
+        size (size_t) : number of nodes in the subtree rooted at this node (1 for a leaf). This is kept up to 
+            date by every operation that adds, removes, or moves nodes, and is used by bstRank() and bstSelect().
+        value (void *) : pointer to the value of the key when the BST is used as a map (see bstUpsert()), NULL
+            otherwise. The value is stored in the node's allocation, between the node and its key.
 */
 struct bstNode
 {
     struct bstNode *left;
     struct bstNode *right;
     void *key;
+    int height;
+    size_t size;
+    void *value;
 };
 
 /*
@@ -165,6 +175,61 @@ struct bstNode *bstSuccessor(struct bstNode *root, const void *key, int (*comp)(
 */
 struct bstNode *bstInsert(struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
 
+/*
+    Inserts a copy of the provided key into a BST if it is not already there, and retrieves the node holding it. 
+
+    Parameters: 
+        root, key, copy, size, comp : see bstInsert() 
+        node (struct bstNode **) : pointer to where the node containing key is stored (may be NULL if the node
+            is not needed)
+
+    Output: 
+        The same as bstInsert(). In addition, *node is set to the node containing key, which is the newly 
+        created node if key was not in the BST and the existing node otherwise. 
+
+    Usage: 
+        This replaces a bstSearch() followed by a bstInsert(), which descends the tree twice. The comparison 
+        function is called once per visited node. 
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
+
+        NOTE: memory allocation is assumed to be independent
+*/
+struct bstNode *bstInsertOrFind(struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), struct bstNode **node);
+
+/*
+    Inserts a key with a value into a BST used as a map, or updates the value of a key already there, in a 
+    single descent. Each node of a map holds a value of valueSize bytes in the same allocation as the node 
+    and its key (node->value), so updating it in place needs no further lookup, allocation, or copy. 
+
+    Parameters: 
+        root, key, copy, size, comp : see bstInsert() 
+        value (const void *) : pointer to the value (not modified) 
+        valueSize (size_t) : size of every value of the map in bytes (the same for every call on a BST) 
+        merge (void (*) (void *, const void *)) : pointer to a function that updates a value already in the 
+            map (1st param, modified in place) with a new value (2nd param) 
+
+    Output: 
+        A pointer to the root of the BST. If key was not in the BST, a node is added whose value is a byte for 
+        byte copy of value. Otherwise merge(node->value, value) is called. 
+
+    Usage: 
+        Counting word frequencies (the use case of section 6.5), with int values: 
+
+            void add(void *count, const void *one) { *(int *)count += *(const int *)one; }
+            ...
+            root = bstUpsert(root, word, &(int){1}, sizeof(int), strcpy, stralloc, strcmp, add); 
+
+        (with the casts of bstInsert()). A map must only be grown with bstUpsert(), as nodes made by the other 
+        insertion and construction functions have no value. The functions that search, delete, or move 
+        nodes work on maps unchanged, values stay with their keys. 
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
+
+        NOTE: memory allocation is assumed to be independent
+*/
+struct bstNode *bstUpsert(struct bstNode *root, const void *key, const void *value, size_t valueSize, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), void (*merge)(void *, const void *));
+
 /*
     Deletes the node from a BST containing a provided key. 
 
@@ -192,13 +257,13 @@ struct bstNode *bstDelete(struct bstNode *root, const void *key, int (*comp)(con
         root (struct bstNode *) : a pointer to the root of the BST to free 
 
     Output: 
-        All nodes in the tree have their left, right, and key pointers set to NULL and are freed. 
-        This means that all nodes in the tree besides the root are set to NULL.
-        The root pointer points to a struct where the left, right, and key are NULL. 
-        It is recommended that the root is set to NULL after a function is used in the calling function to
-            prevent undefined behavior.
+        Every node in the tree is freed. The calling function should set root to NULL afterwards to avoid
+            undefined behavior.
 
     Runtime: O(n)   n - # nodes in BST
+
+        NOTE: the tree is taken apart with rotations rather than recursion, so only O(1) extra space is used
+        even for a degenerate (linked list) tree.
 */
 void bstFree(struct bstNode *root);
 
@@ -216,7 +281,474 @@ void bstFree(struct bstNode *root);
             is printed.
 
     Runtime: O(n)   n - # nodes in BST
+
+        NOTE: the traversal is a Morris traversal, which uses O(1) extra space instead of recursion. It 
+        temporarily modifies right pointers of the tree, so the tree must not be accessed by other code (e.g.
+        from toString) during the traversal. The tree is restored when the function returns.
 */
 void bstPrint(struct bstNode *root, const char *(*toString)(const void *));
 
-#endif
\ No newline at end of file
+/*
+    Inserts a copy of the provided key into a balanced (AVL) BST. 
+
+    The parameters and output are the same as bstInsert(). After the insertion, the heights of the left and 
+    right subtrees of every node differ by at most 1. This is restored with rotations on the path from the 
+    inserted node up to the root, so the tree has O(log(n)) height no matter the order of insertion (e.g. 
+    sorted keys no longer produce a linked list).
+
+    bstSearch(), bstMinimum(), bstMaximum(), bstPredecessor(), bstSuccessor(), bstFree(), and bstPrint() may be
+    used on an AVL tree. However, a tree must be built and modified only with avlInsert() and avlDelete() to
+    stay balanced (bstInsert() and bstDelete() do not update heights).
+
+    Runtime: O(log(n))    n = # nodes in BST 
+
+        NOTE: memory allocation is assumed to be independent
+*/
+struct bstNode *avlInsert(struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+
+/*
+    Deletes the node containing a provided key from a balanced (AVL) BST. 
+
+    The parameters and output are the same as bstDelete(). As with avlInsert(), balance is restored with 
+    rotations on the path from the removed node up to the root. See avlInsert() for which operations may be 
+    used on an AVL tree.
+
+    Runtime: O(log(n))    n = # nodes in BST
+*/
+struct bstNode *avlDelete(struct bstNode *root, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Type definition of a node arena. Nodes (and their keys) inserted through an arena are carved out of large 
+    blocks one after another, instead of being allocated one at a time. Nodes inserted together therefore sit 
+    next to each other in memory, and the whole tree is freed with a single bstArenaFree() rather than a node 
+    by node bstFree().
+*/
+struct bstArena;
+
+/*
+    Creates an empty node arena. 
+
+    Output: 
+        A pointer to the created arena. 
+
+    Runtime: O(1)
+*/
+struct bstArena *bstArenaCreate(void);
+
+/*
+    Versions of bstInsert(), bstDelete(), avlInsert(), and avlDelete() for trees whose nodes are allocated from 
+    a provided arena. The other parameters and outputs are the same. 
+
+    Usage: 
+        Every node of a tree must come from the same arena, so a tree built with these functions must only be 
+        modified with these functions (several trees may share an arena). bstFree() must not be used on such a 
+        tree, use bstArenaFree() instead. The other read-only operations (bstSearch(), bstPrint(), ...) may be 
+        used as normal. 
+
+        A deleted node is unlinked from the tree but its memory is only reclaimed by bstArenaFree(), so an 
+        arena suits trees that mostly grow. 
+
+    Runtime: same as the corresponding non-arena operation 
+*/
+struct bstNode *bstArenaInsert(struct bstArena *arena, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+struct bstNode *bstArenaDelete(struct bstArena *arena, struct bstNode *root, const void *key, int (*comp)(const void *, const void *));
+struct bstNode *avlArenaInsert(struct bstArena *arena, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+struct bstNode *avlArenaDelete(struct bstArena *arena, struct bstNode *root, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Frees a provided arena, including every node allocated from it. 
+
+    Parameters: 
+        arena (struct bstArena *) : pointer to the arena to free 
+
+    Output: 
+        The arena and every node of every tree built in it are freed. The calling function should set the 
+        arena and the roots of those trees to NULL afterwards to avoid undefined behavior. 
+
+    Runtime: O(# arena blocks)    (each block holds thousands of small nodes)
+*/
+void bstArenaFree(struct bstArena *arena);
+
+/*
+    Builds a perfectly balanced BST from keys that are already sorted. 
+
+    Parameters: 
+        keys (const void *const *) : array of n pointers to the keys, sorted according to the comparison 
+            function the tree will be used with, without duplicates. Copies of the keys are put in the tree.
+        n (size_t) : number of keys 
+        copy, size : see bstInsert()
+
+    Output: 
+        A pointer to the root of the built tree (NULL if n is 0). The heights of the left and right subtrees 
+        of every node differ by at most 1 and the height (and size) fields are set, so the tree may also be 
+        used with avlInsert() and avlDelete(). 
+
+    Usage: 
+        Inserting sorted keys one by one with bstInsert() makes a linked list in O(n^2) time, this takes O(n).
+
+    Runtime: O(n)
+*/
+struct bstNode *bstBuildFromSorted(const void *const *keys, size_t n, void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Builds a perfectly balanced BST from keys in any order, see bstBuildFromSorted(). 
+
+    Parameters: 
+        keys (const void *const *) : array of n pointers to the keys (not modified). Duplicates are allowed, 
+            only the first of a set of equal keys is put in the tree.
+        n (size_t) : number of keys 
+        copy, size, comp : see bstInsert()
+
+    Runtime: O(n*log(n))    (a merge sort of the pointers, then bstBuildFromSorted())
+*/
+struct bstNode *bstBuildFromUnsorted(const void *const *keys, size_t n, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *));
+
+/*
+    Rebalances a BST in place with the Day-Stout-Warren algorithm: the tree is flattened into a linked list 
+    with rotations and then folded back into a complete tree with rotations. No nodes are allocated or freed. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the BST to rebalance
+
+    Output: 
+        A pointer to the new root. The tree is balanced and its height and size fields are set, as for 
+        bstBuildFromSorted(). 
+
+    Runtime: O(n) with O(1) extra space besides recomputing the heights (O(log(n)) recursion depth)
+*/
+struct bstNode *bstRebalance(struct bstNode *root);
+
+/*
+    Retrieves the rank of a provided key in a BST, which is the number of keys in the BST smaller than it. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the BST to search
+        key (const void *) : pointer to the key (not modified), which does not need to be in the BST
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used in the
+            search / construction of the BST. 
+
+    Output: 
+        The number of keys smaller than key. If key is in the BST, then it is the key's position in sorted 
+        order starting from 0, so bstSelect(root, bstRank(root, key, comp)) is its node. 
+
+    Usage: 
+        A percentile p (0 to 1) of a BST of n keys is bstSelect(root, (size_t)(p * (n - 1))) where n is 
+        root->size, instead of an O(n) inorder walk. 
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
+*/
+size_t bstRank(struct bstNode *root, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Retrieves the node with the k-th smallest key of a BST, counting from 0. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the BST to search
+        k (size_t) : position of the key in sorted order (0 for the minimum)
+
+    Output: 
+        A pointer to the node with k keys smaller than its key, or NULL if the BST has k or fewer nodes. 
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
+*/
+struct bstNode *bstSelect(struct bstNode *root, size_t k);
+
+/*
+    Searches a BST for a provided key and splays the node found to the root (self-adjusting mode). Each step
+    rotates the node up past its parent, or past its parent and grandparent at once, which also roughly halves
+    the depth of every node on the search path. Keys that are searched for often therefore stay near the root,
+    and a sequence of m searches costs O((m + n) log(n)) in total, however skewed the searches are.
+
+    The mode is opt in: a BST is only restructured by the calls to bstSplay(), and the other operations of this
+    file can still be used on it. Heights are not kept up to date, so it should not be mixed with the AVL
+    operations.
+
+    Parameters:
+        root (struct bstNode *) : pointer to the root of the BST to search
+        key (const void *) : pointer to the search key (not modified)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used in the
+            search / construction of the BST.
+        depth (size_t *) : if not NULL, set to the depth at which the search ended before splaying (0 for the
+            root), so that the effect on a workload can be measured
+
+    Output:
+        A pointer to the root of the restructured BST. If key is in the BST, its node is the root. Otherwise the
+        root is the last node in the search for key (as bstSearch() returns), which holds the predecessor or
+        successor of key.
+
+    Runtime: O(n) worst case, O(log(n)) amortized    n = # nodes in BST
+*/
+struct bstNode *bstSplay(struct bstNode *root, const void *key, int (*comp)(const void *, const void *), size_t *depth);
+
+/*
+    Type definition of a range cursor. A cursor returns the nodes of a BST with keys in a range in order. It 
+    seeks to the start of the range once, and then keeps the path to the next node on an explicit stack, so 
+    each further node costs O(1) amortized instead of a bstSuccessor() search from the root. 
+*/
+struct bstCursor;
+
+/*
+    Opens a cursor over the keys of a BST in a range. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the BST 
+        low (const void *) : pointer to the smallest key of the range (not modified), or NULL for no low bound 
+        high (const void *) : pointer to the largest key of the range (not modified), or NULL for no high bound
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function to be used in the
+            search / construction of the BST. 
+
+    Output: 
+        A pointer to the cursor, positioned before the first node with low <= key <= high. low and high don't 
+        need to be in the BST. The BST must not be modified, and high must stay valid, until the cursor is 
+        closed. 
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST 
+*/
+struct bstCursor *bstRangeOpen(struct bstNode *root, const void *low, const void *high, int (*comp)(const void *, const void *));
+
+/*
+    Advances a cursor. 
+
+    Parameters: 
+        cursor (struct bstCursor *) : pointer to the cursor 
+
+    Output: 
+        A pointer to the next node of the range in order, or NULL once the range is exhausted. 
+
+    Runtime: O(1) amortized, one comparison with the high bound per call
+*/
+struct bstNode *bstRangeNext(struct bstCursor *cursor);
+
+/*
+    Frees a cursor. 
+
+    Parameters: 
+        cursor (struct bstCursor *) : pointer to the cursor, which should be set to NULL afterwards
+
+    Runtime: O(1)
+*/
+void bstRangeClose(struct bstCursor *cursor);
+
+/*
+    Counts the keys of a BST in a range without visiting them. 
+
+    Parameters: 
+        root, low, high, comp : see bstRangeOpen()
+
+    Output: 
+        The number of keys with low <= key <= high. 
+
+    Runtime: O(n) unbalanced, O(log(n)) balanced    n = # nodes in BST    (uses the size fields, see bstRank())
+*/
+size_t bstRangeCount(struct bstNode *root, const void *low, const void *high, int (*comp)(const void *, const void *));
+
+/*
+    Type definition of a frozen snapshot. A snapshot is a read-only copy of the keys of a BST stored in an array 
+    in Eytzinger (breadth first) order: the root first, then the keys of the next level, and so on. Searching it 
+    needs no child pointers, the next position is computed from the comparison result without a branch, and 
+    the positions a few levels ahead are prefetched, so searches are faster than on the pointer based tree. 
+*/
+struct bstSnapshot;
+
+/*
+    Freezes a BST into a snapshot. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the BST (not modified)
+        copy, size : see bstInsert()
+
+    Output: 
+        A pointer to a snapshot holding copies of the keys of the BST. The snapshot does not depend on the BST 
+        afterwards, so the BST may be modified or freed. 
+
+    Runtime: O(n)    n = # nodes in BST
+*/
+struct bstSnapshot *bstFreeze(struct bstNode *root, void (*copy)(void *, const void *), size_t (*size)(const void *));
+
+/*
+    Versions of bstSearch(), bstPredecessor(), and bstSuccessor() for a snapshot. 
+
+    Parameters: 
+        snapshot (const struct bstSnapshot *) : pointer to the snapshot (not modified)
+        key (const void *) : pointer to the key (not modified)
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function the BST was built with
+
+    Output: 
+        A pointer to the snapshot's copy of the key that was found, or NULL if there is none. Unlike 
+        bstSearch(), bstFrozenSearch() returns NULL if key is not in the snapshot. 
+
+    Runtime: O(log(n))    n = # keys in snapshot (the snapshot is always balanced)
+*/
+const void *bstFrozenSearch(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *));
+const void *bstFrozenPredecessor(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *));
+const void *bstFrozenSuccessor(const struct bstSnapshot *snapshot, const void *key, int (*comp)(const void *, const void *));
+
+/*
+    Frees a snapshot, including its key copies. 
+
+    Parameters: 
+        snapshot (struct bstSnapshot *) : pointer to the snapshot, which should be set to NULL afterwards
+
+    Runtime: O(1)
+*/
+void bstFrozenFree(struct bstSnapshot *snapshot);
+
+/*
+    Structure of the shape statistics of a BST, filled by bstStats(). 
+
+    Fields:
+        nodes (size_t) : number of nodes 
+        height (size_t) : number of nodes on the longest path from the root down to a leaf (0 for an empty BST)
+        minHeight (size_t) : smallest possible height of a BST with as many nodes, floor(log2(nodes)) + 1 
+        averageDepth (double) : average number of nodes above a node (the root is at depth 0), so a search for
+            a key in the BST compares against averageDepth + 1 nodes on average 
+*/
+struct bstStatistics
+{
+    size_t nodes;
+    size_t height;
+    size_t minHeight;
+    double averageDepth;
+};
+
+/*
+    Measures the shape of a BST, to see how far it is from balanced (e.g. height against minHeight). See 
+    bst_bench.c, which also counts comparisons with a counting comparison function. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the BST. As in bstPrint(), the BST is temporarily 
+            modified and restored before returning. 
+
+    Output: 
+        The statistics of the BST. 
+
+    Runtime: O(n)    n = # nodes in BST (no recursion or stack, as in bstPrint())
+*/
+struct bstStatistics bstStats(struct bstNode *root);
+
+/*
+    Splits an AVL tree around a provided key. 
+
+    Parameters: 
+        root (struct bstNode *) : pointer to the root of the AVL tree, whose nodes are taken over 
+        key (const void *) : pointer to the key to split at (not modified) 
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of the tree 
+        left (struct bstNode **) : where the root of an AVL tree of the keys smaller than key is stored 
+        right (struct bstNode **) : where the root of an AVL tree of the keys larger than key is stored 
+
+    Output: 
+        The node containing key, detached from both trees (no children), or NULL if key was not in the tree. 
+
+    Runtime: O(log(n))    n = # nodes in the tree
+*/
+struct bstNode *avlSplit(struct bstNode *root, const void *key, int (*comp)(const void *, const void *), struct bstNode **left, struct bstNode **right);
+
+/*
+    Joins 2 AVL trees and a node whose key is between them into 1 AVL tree. The taller tree is descended along 
+    its spine to a subtree as tall as the shorter tree, where the node is attached, and the spine is rebalanced 
+    on the way back up. 
+
+    Parameters: 
+        left (struct bstNode *) : pointer to the root of an AVL tree of keys smaller than mid's key (may be NULL)
+        mid (struct bstNode *) : pointer to the node (its children are overwritten)
+        right (struct bstNode *) : pointer to the root of an AVL tree of keys larger than mid's key (may be NULL)
+
+    Output: 
+        A pointer to the root of the joined AVL tree. 
+
+    Runtime: O(|height(left) - height(right)| + 1)
+*/
+struct bstNode *avlJoin(struct bstNode *left, struct bstNode *mid, struct bstNode *right);
+
+/*
+    Set operations on 2 AVL trees, built from avlSplit() and avlJoin(): the root key of b splits a, the 2 
+    halves are combined with b's subtrees recursively, and the results are joined. This costs 
+    O(m log(n / m + 1)) for trees of m <= n nodes, much less than inserting the m keys one by one when m is 
+    small, and at worst the O(n) of a merge when m is close to n. 
+
+    When compiled with BST_THREADS defined (and linked with -pthread), the 2 recursive calls run in parallel 
+    (fork-join with POSIX threads) while both have enough keys to be worth a thread, on up to 
+    2^BST_FORK_DEPTH threads. 
+
+    Parameters: 
+        a (struct bstNode *) : pointer to the root of the first AVL tree 
+        b (struct bstNode *) : pointer to the root of the second AVL tree 
+        comp (int (*) (const void *, const void *)) : pointer to the comparison function of both trees 
+
+    Output: 
+        A pointer to the root of an AVL tree of the keys in a or b (avlUnion()), in a and b 
+        (avlIntersection()), or in a and not in b (avlDifference()). Both trees are consumed: their nodes are 
+        reused in the result or freed, so a and b should not be used afterwards. When a key is in both trees, 
+        the result keeps b's node for a union and a's node for an intersection. The trees must not come from 
+        an arena. 
+
+    Runtime: O(m log(n / m + 1))    m, n = # nodes in the smaller and larger tree 
+*/
+struct bstNode *avlUnion(struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *));
+struct bstNode *avlIntersection(struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *));
+struct bstNode *avlDifference(struct bstNode *a, struct bstNode *b, int (*comp)(const void *, const void *));
+
+/*
+    Type definition of an insertion hint. A hint remembers the path from the root to the node of the last key 
+    inserted (or found) through it, like the iterator passed to std::map::emplace_hint. The next insertion 
+    starts from that node: it walks up the path only as far as needed to reach a subtree whose key range 
+    holds the new key, and descends from there. When keys arrive in (nearly) sorted order the new key belongs 
+    next to the last one, so an insertion costs O(1) comparisons amortized instead of O(log(n)).
+*/
+struct bstHint;
+
+/*
+    Creates an empty insertion hint. 
+
+    Output: 
+        A pointer to the hint. Its first insertion descends from the root.
+
+    Runtime: O(1)
+*/
+struct bstHint *bstHintCreate(void);
+
+/*
+    Inserts a copy of a provided key into a BST (bstInsertHint()) or an AVL tree (avlInsertHint()), starting 
+    from the position remembered by a hint, and moves the hint to the key's node. 
+
+    Parameters: 
+        hint (struct bstHint *) : pointer to the hint 
+        root, key, copy, size, comp, node : see bstInsertOrFind() 
+
+    Output: 
+        The same as bstInsertOrFind() (bstInsert() or avlInsert() for the shape of the tree). The hint is only 
+        valid for the tree it was last used with, and only while that tree is changed through the hint alone. 
+        It starts over from the root when given a different root, but after any other change to the tree 
+        (e.g. a deletion) it must be reset with bstHintReset() first. 
+
+    Runtime: O(1) comparisons amortized for avlInsertHint() when each key is next to the previous one in 
+        order (e.g. sorted input), O(log(n)) at worst. bstInsertHint() needs as few comparisons, but sorted 
+        keys still make the BST a path. The sizes (and for an AVL tree, heights) of the ancestors are still 
+        updated on the way up, which needs no comparisons.    n = # nodes in BST 
+
+        NOTE: memory allocation is assumed to be independent
+*/
+struct bstNode *bstInsertHint(struct bstHint *hint, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), struct bstNode **node);
+struct bstNode *avlInsertHint(struct bstHint *hint, struct bstNode *root, const void *key, void (*copy)(void *, const void *), size_t (*size)(const void *), int (*comp)(const void *, const void *), struct bstNode **node);
+
+/*
+    Makes a hint forget its position, so that its next insertion descends from the root. 
+
+    Parameters: 
+        hint (struct bstHint *) : pointer to the hint 
+
+    Runtime: O(1)
+*/
+void bstHintReset(struct bstHint *hint);
+
+/*
+    Frees a hint. 
+
+    Parameters: 
+        hint (struct bstHint *) : pointer to the hint, which should be set to NULL afterwards
+
+    Runtime: O(1)
+*/
+void bstHintFree(struct bstHint *hint);
+
+#endif
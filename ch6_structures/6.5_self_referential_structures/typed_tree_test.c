@@ -0,0 +1,112 @@
+#include "typed_tree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INT_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+#define STR_CMP(a, b) strcmp((a), (b))
+
+DEFINE_BST(intBst, int, INT_CMP)
+DEFINE_BST(strBst, const char *, STR_CMP)
+
+void intTest(void);
+void randomTest(void);
+void stringTest(void);
+
+int main()
+{
+    intTest();
+    randomTest();
+    stringTest();
+    return 0;
+}
+
+void intTest(void)
+{
+    struct intBstNode *root = NULL;
+    printf("%p\n", (void *)intBstMinimum(root)); // (nil)
+
+    int keys[] = {50, 20, 80, 10, 30, 70, 90, 25, 35};
+    for (int i = 0; i < 9; i++)
+    {
+        root = intBstInsert(root, keys[i]);
+    }
+    root = intBstInsert(root, 50);                  // duplicate, no change
+    printf("%d\n", intBstSearch(root, 30)->key);     // 30
+    printf("%p\n", (void *)intBstSearch(root, 40));  // (nil)
+    printf("%d\n", intBstMinimum(root)->key);        // 10
+    printf("%d\n", intBstMaximum(root)->key);        // 90
+    printf("%d\n", intBstPredecessor(root, 50)->key); // 35
+    printf("%d\n", intBstSuccessor(root, 36)->key);   // 50
+    printf("%p\n", (void *)intBstSuccessor(root, 90)); // (nil)
+
+    // a node with 2 children whose successor is its right child's leftmost node, then the root
+    root = intBstDelete(root, 20);
+    printf("%d\n", root->left->key); // 25
+    root = intBstDelete(root, 50);
+    printf("%d\n", root->key); // 70
+    root = intBstDelete(root, 99);
+    for (struct intBstNode *n = intBstMinimum(root); n != NULL; n = intBstSuccessor(root, n->key))
+    {
+        printf("%d ", n->key);
+    }
+    printf("\n"); // 10 25 30 35 70 80 90
+    intBstFree(root);
+    printf("INT TEST DONE.\n");
+}
+
+void randomTest(void)
+{
+    // random insertions and deletions, checked against a presence array
+    int n = 5000;
+    char *present = (char *)calloc(n, 1);
+    struct intBstNode *root = NULL;
+    srand(44);
+    for (int i = 0; i < 100000; i++)
+    {
+        int k = rand() % n;
+        if (rand() % 3 == 0)
+        {
+            root = intBstDelete(root, k);
+            present[k] = 0;
+        }
+        else
+        {
+            root = intBstInsert(root, k);
+            present[k] = 1;
+        }
+    }
+    int ok = 1;
+    int prev = -1;
+    for (int k = 0; k < n; k++)
+    {
+        ok = ok && (intBstSearch(root, k) != NULL) == present[k];
+        if (present[k])
+        {
+            struct intBstNode *p = intBstPredecessor(root, k);
+            ok = ok && (prev < 0 ? p == NULL : p != NULL && p->key == prev);
+            prev = k;
+        }
+    }
+    printf("%d\n", ok); // 1
+    intBstFree(root);
+    free(present);
+    printf("RANDOM TEST DONE.\n");
+}
+
+void stringTest(void)
+{
+    // keys are the pointers, the strings themselves are not copied
+    struct strBstNode *root = NULL;
+    const char *words[] = {"pear", "apple", "fig", "kiwi", "banana"};
+    for (int i = 0; i < 5; i++)
+    {
+        root = strBstInsert(root, words[i]);
+    }
+    printf("%s\n", strBstSuccessor(root, "fig")->key);   // kiwi
+    printf("%s\n", strBstPredecessor(root, "fig")->key); // banana
+    root = strBstDelete(root, "pear");
+    printf("%s\n", strBstMaximum(root)->key); // kiwi
+    strBstFree(root);
+    printf("STRING TEST DONE.\n");
+}
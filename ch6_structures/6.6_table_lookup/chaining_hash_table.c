@@ -22,15 +22,32 @@
 
 // ***************************** NECESSARY HEADERS ***************************************
 
+// glibc hides MAP_ANONYMOUS in strict ISO modes (e.g. -std=c99), which would silently turn off the mmap() path
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include "hash_table.h" // needed for hash table operations
 #include <stdlib.h>     // needed for malloc(), free()
 #include <stddef.h>     // needed for size_t
 #include <stdio.h>      // needed for printf()
 
+// anonymous mappings are only available on POSIX systems, elsewhere calloc() is always used
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h> // needed for mmap(), munmap(), madvise()
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifdef MAP_ANONYMOUS
+#define USE_MMAP
+#endif
+#endif
+
 // ***************************** CONSTANTS ***********************************************
 
-#define LOAD_FACTOR 0.75    // ratio of table that must be full to trigger rehash
-#define INITIAL_CAPACITY 13 // initial size of internal array
+#define LOAD_FACTOR 0.75         // ratio of table that must be full to trigger rehash
+#define INITIAL_CAPACITY 13      // initial size of internal array
+#define MMAP_THRESHOLD (1 << 21) // internal arrays of at least this many bytes (2 MB) are mapped if possible
 
 // ***************************** STRUCTURE DEFINITIONS ***********************************
 
@@ -56,6 +73,7 @@ struct EntryNode
         table (struct EntryNode **) : pointer to array of (struct EntryNode *) SLL heads. 
         size (size_t) : number of entries in the table 
         capacity (size_t) : length of 'table' 
+        mapped (int) : 1 if 'table' was allocated with mmap() rather than calloc()
         hash (size_t (*) (const void *)) : hash function to be used on entry keys in the table. 
         keyCmp (int (*) (const void *, const void *)) : comparison function to be used on entry keys. 
         keyCpy (void (*) (void *, const void *)) : copies key data into a void * pointer (destination) 
@@ -80,6 +98,7 @@ struct ChainedHashTable
     struct EntryNode **table;
     size_t size;
     size_t capacity;
+    int mapped;
     size_t (*hash)(const void *);
     int (*keyCmp)(const void *, const void *);
     void (*keyCpy)(void *, const void *);
@@ -117,11 +136,29 @@ static void rehash(HashTable *t);
 
     Output: 
         The internal array of t is allocated according to its capacity and has its elements initialized to NULL.
+        Arrays of at least MMAP_THRESHOLD bytes are mapped anonymously where available, as the operating system
+        hands out zero-filled pages as they are first touched (and transparent huge pages are requested for them
+        where supported). Smaller arrays come from calloc(), which also returns zeroed memory.
 
-    Runtime: O(m)
+    Runtime: O(1) for mapped arrays, O(m) otherwise
 */
 static void allocInternalTable(HashTable *t);
 
+/*
+    Frees an internal array previously allocated by allocInternalTable().
+
+    Parameters: 
+        table (struct EntryNode **) : the internal array to free
+        capacity (size_t) : the length the array was allocated with
+        mapped (int) : whether the array was mapped (the value of the table's mapped field at allocation)
+
+    Output: 
+        The memory of the array is returned to the system.
+
+    Runtime: O(1)
+*/
+static void freeInternalTable(struct EntryNode **table, size_t capacity, int mapped);
+
 /*
     Creates an entry from a provided key, value pair to be stored in a HashTable.
 
@@ -334,7 +371,7 @@ void tableFree(HashTable *t)
     }
 
     // all chains destroyed, can free the table and set it to NULL
-    free((void *)t->table);
+    freeInternalTable(t->table, t->capacity, t->mapped);
     t->table = NULL;
     // set size, capacity to 0
     t->size = 0;
@@ -372,12 +409,30 @@ void tablePrint(const HashTable *t)
     printf("\n");
 }
 
+void tableForEach(const HashTable *t, void (*visit)(const void *, void *, void *), void *arg)
+{
+    // will iterate over chains in table
+    struct EntryNode *curr = NULL;
+    // for each chain
+    for (size_t i = 0; i < t->capacity; i++)
+    {
+        // hand each entry in the chain to the visitor
+        curr = t->table[i];
+        while (curr != NULL)
+        {
+            (*visit)(curr->key, curr->val, arg);
+            curr = curr->next;
+        }
+    }
+}
+
 // ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
 
 static void rehash(HashTable *t)
 {
     // create another pointer to point at original table
     struct EntryNode **tableCpy = t->table;
+    int tableCpyMapped = t->mapped;
     // double new table's capacity and allocate an array of this size
     t->capacity *= 2;
     allocInternalTable(t);
@@ -423,19 +478,50 @@ static void rehash(HashTable *t)
     }
 
     // now that all the elements of original table are null, can free original memory
-    free((void *)tableCpy);
+    freeInternalTable(tableCpy, t->capacity / 2, tableCpyMapped);
     tableCpy = NULL;
 }
 
-void allocInternalTable(HashTable *t)
+static void allocInternalTable(HashTable *t)
 {
-    // allocate array of chains based on current capacity
+    t->mapped = 0;
+#ifdef USE_MMAP
+    size_t bytes = t->capacity * sizeof(struct EntryNode *);
+    // large array, let the system zero the pages lazily instead of touching all of them now
+    if (bytes >= MMAP_THRESHOLD)
+    {
+        void *mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED)
+        {
+#ifdef MADV_HUGEPAGE
+            // fewer TLB misses on the random accesses made by hashing (only a hint, failure is harmless)
+            madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+            t->table = (struct EntryNode **)mem;
+            t->mapped = 1;
+            return;
+        }
+        // mapping failed, fall back on calloc()
+    }
+#endif
+    // allocate array of chains based on current capacity, calloc() zeroes it so all chains start empty (NULL)
     t->table = (struct EntryNode **)calloc(t->capacity, sizeof(struct EntryNode *));
-    // set all chains to  be empty (NULL) or they will be garbage
-    for (size_t i = 0; i < t->capacity; i++)
+}
+
+static void freeInternalTable(struct EntryNode **table, size_t capacity, int mapped)
+{
+#ifdef USE_MMAP
+    if (mapped)
     {
-        t->table[i] = NULL;
+        munmap((void *)table, capacity * sizeof(struct EntryNode *));
+        return;
     }
+#else
+    // only mapped arrays need their size and kind
+    (void)capacity;
+    (void)mapped;
+#endif
+    free((void *)table);
 }
 
 static struct EntryNode *createEntry(HashTable *t, const void *key, const void *value)
@@ -0,0 +1,446 @@
+/*
+    Contains implementation of a streaming hash aggregation (GROUP BY) operator built on top of the HashTable in
+    hash_table.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    For runtime calculations of the declared operations, they are done with respect to the number of distinct
+    keys (g) and the number of records fed to the operator (r).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "hash_aggregate.h" // needed for aggregation operations
+#include "hash_table.h"     // needed for HashTable operations
+#include <stdlib.h>         // needed for malloc(), realloc(), free()
+#include <stddef.h>         // needed for size_t
+#include <stdio.h>          // needed for tmpfile(), fread(), fwrite(), fseek(), fflush()
+#include <string.h>         // needed for memcpy()
+
+// ***************************** CONSTANTS ***********************************************
+
+#define NUM_PARTITIONS 16                    // number of temporary files groups are spilled into
+#define ENTRY_OVERHEAD (4 * sizeof(void *)) // estimated bytes used by the table per entry besides key and state
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure that represents a hash aggregation operator.
+
+    Fields:
+        groups (HashTable *) : table mapping group keys to their (struct AggState) aggregate state
+        partitions (FILE *[NUM_PARTITIONS]) : temporary files that spilled groups are written to (NULL until
+            the first spill)
+        memoryUsed (size_t) : estimated number of bytes occupied by the groups in memory
+        memoryBudget (size_t) : number of bytes the groups may occupy before being spilled (0 = unlimited)
+        spills (size_t) : number of spills since the operator was last finished
+        failed (int) : 1 if a partition file could not be created or written since the operator was last
+            finished, 0 otherwise
+        hash (size_t (*) (const void *)) : hash function to be used on group keys
+        keyCmp (int (*) (const void *, const void *)) : comparison function to be used on group keys
+        keyCpy (void (*) (void *, const void *)) : copies key data into a void * pointer (destination)
+            from a const void * (source)
+        keySize (size_t (*) (const void *)) : calculates the key allocation size (in bytes) for data referenced
+            from a const void * (key pointer)
+*/
+struct HashAggregator
+{
+    HashTable *groups;
+    FILE *partitions[NUM_PARTITIONS];
+    size_t memoryUsed;
+    size_t memoryBudget;
+    size_t spills;
+    int failed;
+    size_t (*hash)(const void *);
+    int (*keyCmp)(const void *, const void *);
+    void (*keyCpy)(void *, const void *);
+    size_t (*keySize)(const void *);
+};
+
+/*
+    Structure used to pass the client's emit function through tableForEach().
+
+    Fields:
+        emit (void (*) (const void *, const struct AggState *, void *)) : client function to call per group
+        arg (void *) : client data for emit
+*/
+struct EmitContext
+{
+    void (*emit)(const void *, const struct AggState *, void *);
+    void *arg;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Creates an empty HashTable for storing the groups of a provided HashAggregator.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator whose key functions are used
+
+    Output:
+        A pointer to an empty HashTable mapping keys to (struct AggState) values.
+
+    Runtime: O(1)
+*/
+static HashTable *createGroupTable(HashAggregator *a);
+
+/*
+    Combines a partial aggregate state into the group with a provided key, creating the group if needed.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator to update
+        key (const void *) : pointer to the group key
+        partial (const struct AggState *) : aggregate state to combine into the group
+
+    Output:
+        The group's state afterwards describes the union of the values described by its old state and partial.
+        The memory estimate of a is increased if a group was created.
+
+    Runtime: O(1) expected
+*/
+static void combineIntoGroup(HashAggregator *a, const void *key, const struct AggState *partial);
+
+/*
+    Writes every in-memory group of a provided HashAggregator to its partition file and empties the table.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator to spill
+
+    Output:
+        All groups are appended to the partition files (which are created if needed), the table is replaced by
+        an empty one, and the memory estimate is reset to 0. If a partition file cannot be created or written,
+        a->failed is set to 1 (the groups are dropped either way, as the aggregation has failed).
+
+    Runtime: O(g)
+*/
+static void spill(HashAggregator *a);
+
+/*
+    Visitor used with tableForEach() to write a group to its partition file. arg is the HashAggregator, whose
+    failed field is set if a write fails (later groups are then skipped).
+*/
+static void spillGroup(const void *key, void *val, void *arg);
+
+/*
+    Reads the groups of a partition file back into the table of a provided HashAggregator.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator to merge into
+        f (FILE *) : partition file to read from the start
+        keyBuf (void **) : pointer to the buffer spilled keys are read into (grown as needed)
+        keyBufSize (size_t *) : pointer to the size of *keyBuf
+
+    Output:
+        1 if every record of f was read and combined into its group, 0 if f could not be read or ended in the
+        middle of a record.
+
+    Runtime: O(# records in f)
+*/
+static int mergePartition(HashAggregator *a, FILE *f, void **keyBuf, size_t *keyBufSize);
+
+/*
+    Visitor used with tableForEach() to hand a group to the client's emit function. arg is an EmitContext.
+*/
+static void emitGroup(const void *key, void *val, void *arg);
+
+/*
+    Chooses the partition file of a provided key.
+
+    Parameters:
+        a (const HashAggregator *) : pointer to the HashAggregator the key belongs to
+        key (const void *) : pointer to the group key
+
+    Output:
+        An index into a->partitions. The key's hash is mixed before being reduced so that keys that share a
+        partition are still spread over the whole table when that partition is merged.
+
+    Runtime: O(1)
+*/
+static size_t partitionOf(const HashAggregator *a, const void *key);
+
+/*
+    Copy and size functions used by the group table for (struct AggState) values.
+*/
+static void stateCpy(void *dest, const void *src);
+static size_t stateSize(const void *state);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+HashAggregator *aggCreate(size_t (*hash)(const void *), int (*keyCmp)(const void *, const void *), void (*keyCpy)(void *, const void *), size_t (*keySize)(const void *), size_t memoryBudget)
+{
+    HashAggregator *a = (HashAggregator *)malloc(sizeof(HashAggregator));
+    a->hash = hash;
+    a->keyCmp = keyCmp;
+    a->keyCpy = keyCpy;
+    a->keySize = keySize;
+    a->memoryBudget = memoryBudget;
+    a->memoryUsed = 0;
+    a->spills = 0;
+    a->failed = 0;
+    // partition files are only created on the first spill
+    for (size_t i = 0; i < NUM_PARTITIONS; i++)
+    {
+        a->partitions[i] = NULL;
+    }
+    a->groups = createGroupTable(a);
+    return a;
+}
+
+int aggAdd(HashAggregator *a, const void *key, double value)
+{
+    // the aggregation already lost groups, so later records cannot make it correct
+    if (a->failed)
+    {
+        return 0;
+    }
+
+    // a single record is a group of 1 value
+    struct AggState record = {value, value, value, 1};
+    combineIntoGroup(a, key, &record);
+
+    // spill if the new group pushed memory over the budget
+    if (a->memoryBudget != 0 && a->memoryUsed > a->memoryBudget)
+    {
+        spill(a);
+    }
+    return !a->failed;
+}
+
+int aggFinish(HashAggregator *a, void (*emit)(const void *, const struct AggState *, void *), void *arg)
+{
+    struct EmitContext ctx = {emit, arg};
+
+    // nothing was spilled, every group is complete in memory
+    if (a->spills == 0 && !a->failed)
+    {
+        tableForEach(a->groups, emitGroup, &ctx);
+    }
+    else if (!a->failed)
+    {
+        // the groups still in memory are partial, so they must be merged with their partitions
+        spill(a);
+
+        // writes are buffered, so a full disk may only be reported once the partitions are flushed
+        for (size_t i = 0; i < NUM_PARTITIONS && !a->failed; i++)
+        {
+            a->failed = fflush(a->partitions[i]) != 0 || ferror(a->partitions[i]);
+        }
+
+        // buffer that spilled keys are read into, grown as needed
+        void *keyBuf = NULL;
+        size_t keyBufSize = 0;
+
+        // merge one partition at a time so that only its groups are in memory
+        for (size_t i = 0; i < NUM_PARTITIONS && !a->failed; i++)
+        {
+            a->failed = !mergePartition(a, a->partitions[i], &keyBuf, &keyBufSize);
+            if (!a->failed)
+            {
+                // partition fully merged, report it
+                tableForEach(a->groups, emitGroup, &ctx);
+            }
+
+            // start the next partition with an empty table
+            tableFree(a->groups);
+            a->groups = createGroupTable(a);
+            a->memoryUsed = 0;
+        }
+        free(keyBuf);
+    }
+
+    // reset for reuse, the partitions are no longer needed
+    int ok = !a->failed;
+    for (size_t i = 0; i < NUM_PARTITIONS; i++)
+    {
+        if (a->partitions[i] != NULL)
+        {
+            fclose(a->partitions[i]);
+            a->partitions[i] = NULL;
+        }
+    }
+    tableFree(a->groups);
+    a->groups = createGroupTable(a);
+    a->memoryUsed = 0;
+    a->spills = 0;
+    a->failed = 0;
+    return ok;
+}
+
+double aggResult(const struct AggState *s, enum AggFunction f)
+{
+    switch (f)
+    {
+    case AGG_SUM:
+        return s->sum;
+    case AGG_COUNT:
+        return (double)s->count;
+    case AGG_MIN:
+        return s->min;
+    case AGG_MAX:
+        return s->max;
+    case AGG_AVG:
+        return s->sum / s->count;
+    default:
+        return 0.0;
+    }
+}
+
+size_t aggSpillCount(const HashAggregator *a)
+{
+    return a->spills;
+}
+
+void aggFree(HashAggregator *a)
+{
+    tableFree(a->groups);
+    a->groups = NULL;
+    // temporary files are removed by the library once closed
+    for (size_t i = 0; i < NUM_PARTITIONS; i++)
+    {
+        if (a->partitions[i] != NULL)
+        {
+            fclose(a->partitions[i]);
+            a->partitions[i] = NULL;
+        }
+    }
+    a->hash = NULL;
+    a->keyCmp = NULL;
+    a->keyCpy = NULL;
+    a->keySize = NULL;
+    free((void *)a);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static HashTable *createGroupTable(HashAggregator *a)
+{
+    // groups are never printed, so no toString functions are needed
+    return tableCreate(a->hash, a->keyCmp, a->keyCpy, stateCpy, a->keySize, stateSize, NULL, NULL, NULL, NULL);
+}
+
+static void combineIntoGroup(HashAggregator *a, const void *key, const struct AggState *partial)
+{
+    // the table hands back its own copy of the state, so existing groups are updated in place
+    struct AggState *s = (struct AggState *)tableSearch(a->groups, key);
+    if (s == NULL)
+    {
+        tableInsert(a->groups, key, partial);
+        a->memoryUsed += (*a->keySize)(key) + sizeof(struct AggState) + ENTRY_OVERHEAD;
+        return;
+    }
+
+    s->sum += partial->sum;
+    s->count += partial->count;
+    if (partial->min < s->min)
+    {
+        s->min = partial->min;
+    }
+    if (partial->max > s->max)
+    {
+        s->max = partial->max;
+    }
+}
+
+static void spill(HashAggregator *a)
+{
+    // create the partition files on the first spill
+    for (size_t i = 0; i < NUM_PARTITIONS && !a->failed; i++)
+    {
+        if (a->partitions[i] == NULL)
+        {
+            a->partitions[i] = tmpfile();
+            a->failed = a->partitions[i] == NULL;
+        }
+    }
+
+    if (!a->failed)
+    {
+        tableForEach(a->groups, spillGroup, a);
+    }
+    tableFree(a->groups);
+    a->groups = createGroupTable(a);
+    a->memoryUsed = 0;
+    a->spills++;
+}
+
+static void spillGroup(const void *key, void *val, void *arg)
+{
+    HashAggregator *a = (HashAggregator *)arg;
+    if (a->failed)
+    {
+        return;
+    }
+    FILE *f = a->partitions[partitionOf(a, key)];
+    // record format: key length, key bytes, aggregate state
+    size_t keyLen = (*a->keySize)(key);
+    if (fwrite(&keyLen, sizeof(size_t), 1, f) != 1 || fwrite(key, 1, keyLen, f) != keyLen || fwrite(val, sizeof(struct AggState), 1, f) != 1)
+    {
+        a->failed = 1;
+    }
+}
+
+static int mergePartition(HashAggregator *a, FILE *f, void **keyBuf, size_t *keyBufSize)
+{
+    size_t keyLen;
+    struct AggState partial;
+    if (fseek(f, 0, SEEK_SET) != 0)
+    {
+        return 0;
+    }
+    size_t lenRead;
+    while ((lenRead = fread(&keyLen, 1, sizeof(size_t), f)) == sizeof(size_t))
+    {
+        if (keyLen > *keyBufSize)
+        {
+            *keyBuf = realloc(*keyBuf, keyLen);
+            *keyBufSize = keyLen;
+        }
+        // a record cut short means the partition is damaged, so none of its groups can be trusted
+        if (fread(*keyBuf, 1, keyLen, f) != keyLen || fread(&partial, sizeof(struct AggState), 1, f) != 1)
+        {
+            return 0;
+        }
+        combineIntoGroup(a, *keyBuf, &partial);
+    }
+    // the loop also stops on a read error or a cut off length, which are not the end of the partition
+    return lenRead == 0 && !ferror(f);
+}
+
+static void emitGroup(const void *key, void *val, void *arg)
+{
+    struct EmitContext *ctx = (struct EmitContext *)arg;
+    (*ctx->emit)(key, (const struct AggState *)val, ctx->arg);
+}
+
+static size_t partitionOf(const HashAggregator *a, const void *key)
+{
+    // 64-bit finalizer from MurmurHash3, spreads weak hashes over all bits before taking the remainder
+    unsigned long long h = (unsigned long long)(*a->hash)(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (size_t)(h % NUM_PARTITIONS);
+}
+
+static void stateCpy(void *dest, const void *src)
+{
+    memcpy(dest, src, sizeof(struct AggState));
+}
+
+static size_t stateSize(const void *state)
+{
+    (void)state;
+    return sizeof(struct AggState);
+}
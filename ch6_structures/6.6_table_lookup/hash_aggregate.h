@@ -0,0 +1,170 @@
+/*
+    Contains declarations of a streaming hash aggregation (GROUP BY) operator built on top of the HashTable in
+    hash_table.h. Records of the form (key, value) are fed to the operator one at a time and the sum, count,
+    minimum, maximum, and average of the values are maintained for every distinct key.
+
+    The aggregate state of each group is stored as the value of its HashTable entry and is updated in place. When
+    the estimated memory used by the in-memory groups exceeds a provided budget, the groups are spilled to
+    temporary partition files (partitioned by key hash) and the table is emptied. When the stream ends, each
+    partition is read back and merged on its own, so only one partition's groups need to fit in memory at once.
+
+    For runtime calculations of the declared operations, they are done with respect to the number of distinct
+    keys (g) and the number of records fed to the operator (r). Hashing, comparing, copying, and sizing keys
+    are considered to be O(1).
+
+    NOTE: Since spilled keys are written to disk as the raw bytes reported by the key size function, keys must
+    be stored contiguously (e.g. strings, integers, flat structures). Keys containing pointers to other data
+    cannot be spilled, and the behavior is undefined if a spill occurs with such keys.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef HASH_AGGREGATE_H
+#define HASH_AGGREGATE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the aggregation operator. It is implemented via a structure that wraps a HashTable.
+*/
+typedef struct HashAggregator HashAggregator;
+
+/*
+    Structure holding the aggregate state of a single group.
+
+    Fields:
+        sum (double) : sum of the values in the group
+        min (double) : minimum value in the group
+        max (double) : maximum value in the group
+        count (size_t) : number of values in the group
+*/
+struct AggState
+{
+    double sum;
+    double min;
+    double max;
+    size_t count;
+};
+
+/*
+    Aggregate functions that can be read from an AggState using aggResult().
+*/
+enum AggFunction
+{
+    AGG_SUM,
+    AGG_COUNT,
+    AGG_MIN,
+    AGG_MAX,
+    AGG_AVG
+};
+
+/*
+    Creates a HashAggregator for client use.
+
+    Parameters:
+        hash (size_t (*) (const void *)) : hash function to be used on group keys
+        keyCmp (int (*) (const void *, const void *)) : comparison function to be used on group keys
+        keyCpy (void (*) (void *, const void *)) : copies key data into a void * pointer (destination)
+            from a const void * (source)
+        keySize (size_t (*) (const void *)) : calculates the key allocation size (in bytes) for data referenced
+            from a const void * (key pointer)
+        memoryBudget (size_t) : approximate number of bytes the in-memory groups may occupy before they are
+            spilled to temporary files. A budget of 0 means the groups are never spilled.
+
+    Output:
+        A pointer to a HashAggregator with no groups.
+
+    Runtime: O(1)
+*/
+HashAggregator *aggCreate(size_t (*hash)(const void *), int (*keyCmp)(const void *, const void *), void (*keyCpy)(void *, const void *), size_t (*keySize)(const void *), size_t memoryBudget);
+
+/*
+    Adds a (key, value) record to a provided HashAggregator.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator to update
+        key (const void *) : pointer to the group key of the record (copied if the group is new)
+        value (double) : value of the record
+
+    Output:
+        The aggregate state of the group with the provided key is updated with value. If no such group is in
+        memory, one is created. If creating the group makes the in-memory groups exceed the memory budget, all
+        in-memory groups are spilled to the partition files.
+
+        1 is returned on success, 0 if a partition file could not be created or written. The spilled groups are
+        then lost, so the aggregation has failed: every later record is ignored (0 is returned) and aggFinish()
+        reports the failure.
+
+    Runtime: O(1) expected, O(g) when a spill occurs
+*/
+int aggAdd(HashAggregator *a, const void *key, double value);
+
+/*
+    Ends the record stream of a provided HashAggregator and reports the final aggregate of every group.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator to finish
+        emit (void (*) (const void *, const struct AggState *, void *)) : pointer to a function that is called
+            once per group with the group's key, its final aggregate state, and arg
+        arg (void *) : client data that is passed through to every call of emit (may be NULL)
+
+    Output:
+        emit is called exactly once for every distinct key added since the HashAggregator was created (or last
+        finished) in an implementation-defined order. Afterwards, the HashAggregator is empty and may be reused.
+
+        If spills occurred, the groups are merged one partition at a time. A partition that is larger than the
+        memory budget is still merged in memory.
+
+        1 is returned on success. 0 is returned if the aggregation failed (see aggAdd()), or if a partition file
+        could not be written or read back. Nothing is emitted for a failed aggregation, and emitting stops at
+        the partition that could not be read, so every aggregate state passed to emit is complete (a group is
+        never emitted from part of its records). In both cases the HashAggregator is still emptied for reuse.
+
+    Runtime: O(g + r)
+*/
+int aggFinish(HashAggregator *a, void (*emit)(const void *, const struct AggState *, void *), void *arg);
+
+/*
+    Reads the result of an aggregate function from a provided aggregate state.
+
+    Parameters:
+        s (const struct AggState *) : pointer to the aggregate state of a group
+        f (enum AggFunction) : the aggregate function to read
+
+    Output:
+        The value of f over the group described by s. The count is returned as a double.
+
+    Runtime: O(1)
+*/
+double aggResult(const struct AggState *s, enum AggFunction f);
+
+/*
+    Retrieves the number of times a provided HashAggregator has spilled its groups since it was last finished.
+
+    Parameters:
+        a (const HashAggregator *) : pointer to a HashAggregator (not modified)
+
+    Output:
+        The number of spills. This is 0 if every group has fit in the memory budget so far.
+
+    Runtime: O(1)
+*/
+size_t aggSpillCount(const HashAggregator *a);
+
+/*
+    De-allocates the memory allocated to a provided HashAggregator, including any unmerged groups and temporary
+    partition files.
+
+    Parameters:
+        a (HashAggregator *) : pointer to the HashAggregator to free
+
+    Output:
+        The memory previously allocated to a is freed. The calling function should set a to NULL afterwards to
+        avoid undefined behavior.
+
+    Runtime: O(g)
+*/
+void aggFree(HashAggregator *a);
+
+#endif
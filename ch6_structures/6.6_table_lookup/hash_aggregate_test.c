@@ -0,0 +1,108 @@
+#include "hash_aggregate.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+#define NUM_GROUPS 10
+
+struct AggState results[NUM_GROUPS];
+int emitted[NUM_GROUPS];
+
+size_t strHash(const void *s);
+size_t strSize(const void *s);
+void collect(const void *key, const struct AggState *s, void *arg);
+int feed(HashAggregator *a);
+void printResults(void);
+void inMemoryTest(void);
+void spillTest(void);
+
+int main()
+{
+    inMemoryTest();
+    spillTest();
+    return 0;
+}
+
+void inMemoryTest(void)
+{
+    HashAggregator *a = aggCreate(strHash, (int (*)(const void *, const void *))strcmp, (void (*)(void *, const void *))strcpy, strSize, 0);
+    printf("%d\n", feed(a));                            // 1
+    printf("spills=%u\n", (unsigned)aggSpillCount(a)); // 0
+    printf("%d\n", aggFinish(a, collect, NULL));       // 1
+    printResults();
+
+    // operator is reusable after finishing
+    aggAdd(a, "g3", 7.0);
+    aggFinish(a, collect, NULL);
+    printResults(); // g3 only: sum=7 count=1 min=7 max=7 avg=7
+
+    aggFree(a);
+    printf("IN MEMORY TEST DONE.\n");
+}
+
+void spillTest(void)
+{
+    // budget only fits a couple of groups, so every few records trigger a spill
+    HashAggregator *a = aggCreate(strHash, (int (*)(const void *, const void *))strcmp, (void (*)(void *, const void *))strcpy, strSize, 100);
+    printf("%d\n", feed(a));                       // 1
+    printf("spilled=%d\n", aggSpillCount(a) > 0); // 1
+    printf("%d\n", aggFinish(a, collect, NULL));  // 1
+    printResults(); // same as first result of in memory test
+    printf("spills=%u\n", (unsigned)aggSpillCount(a)); // 0
+
+    aggFree(a);
+    printf("SPILL TEST DONE.\n");
+}
+
+int feed(HashAggregator *a)
+{
+    char key[3] = "g0";
+    int ok = 1;
+    // group i receives the values i, i + 1, ..., i + 99 (one per round)
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < NUM_GROUPS; i++)
+        {
+            key[1] = '0' + i;
+            ok = aggAdd(a, key, (double)(i + round)) && ok;
+        }
+    }
+    return ok;
+}
+
+void collect(const void *key, const struct AggState *s, void *arg)
+{
+    (void)arg;
+    int i = ((const char *)key)[1] - '0';
+    results[i] = *s;
+    emitted[i]++;
+}
+
+void printResults(void)
+{
+    for (int i = 0; i < NUM_GROUPS; i++)
+    {
+        if (emitted[i] > 0)
+        {
+            printf("g%d emitted=%d sum=%.0f count=%.0f min=%.0f max=%.0f avg=%.1f\n", i, emitted[i], aggResult(&results[i], AGG_SUM), aggResult(&results[i], AGG_COUNT), aggResult(&results[i], AGG_MIN), aggResult(&results[i], AGG_MAX), aggResult(&results[i], AGG_AVG));
+        }
+        emitted[i] = 0;
+    }
+}
+
+size_t strHash(const void *s)
+{
+    size_t h = 0;
+    const char *cs = (const char *)s;
+    while (*cs != '\0')
+    {
+        h += *cs - '\0';
+        cs++;
+    }
+    return h;
+}
+
+size_t strSize(const void *s)
+{
+    return strlen((const char *)s) + 1;
+}
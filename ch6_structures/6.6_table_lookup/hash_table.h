@@ -183,4 +183,24 @@ void tableFree(HashTable *t);
 */
 void tablePrint(const HashTable *t);
 
+/*
+    Visits every entry stored in a provided HashTable.
+
+    Parameters:
+        t (const HashTable *) : pointer to HashTable to iterate over
+        visit (void (*) (const void *, void *, void *)) : pointer to a function that is called once per entry
+            with the entry's key (not modified), the entry's value, and arg
+        arg (void *) : client data that is passed through to every call of visit (may be NULL)
+
+    Output:
+        visit is called on every entry of the table in an implementation-defined order. The value pointer
+        references the table's own copy of the value, so visit may update it in place as long as the update
+        does not require more storage than valSize reported when the entry was inserted.
+
+        visit must not insert into or delete from t, otherwise the behavior is undefined.
+
+    Runtime: O(n + m)
+*/
+void tableForEach(const HashTable *t, void (*visit)(const void *, void *, void *), void *arg);
+
 #endif
\ No newline at end of file
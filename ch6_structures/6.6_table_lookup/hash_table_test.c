@@ -8,15 +8,21 @@ HashTable *t = NULL;
 size_t strHash(const void *s);
 size_t strSize(const void *s);
 const char *strToString(const void *s);
+size_t intHash(const void *i);
+int intCmp(const void *a, const void *b);
+void intCpy(void *dest, const void *src);
+size_t intSize(const void *i);
 void insertTest(void);
 void searchTest(void);
 void deleteTest(void);
+void largeTest(void);
 
 int main()
 {
     insertTest();
     searchTest();
     deleteTest();
+    largeTest();
     return 0;
 }
 
@@ -203,6 +209,34 @@ void deleteTest(void)
     printf("DELETE TEST DONE.\n");
 }
 
+void largeTest(void)
+{
+    // 330000 entries take the internal array from 425984 chains (3.25 MB, already mapped) to 851968, so
+    // a mapped array is both created and rehashed out of, then unmapped
+    t = tableCreate(intHash, intCmp, intCpy, intCpy, intSize, intSize, NULL, NULL, NULL, NULL);
+    int n = 330000;
+    for (int i = 0; i < n; i++)
+    {
+        int value = 2 * i;
+        tableInsert(t, &i, &value);
+    }
+    printf("%u\n", tableSize(t)); // 330000
+
+    int found = 1;
+    for (int i = 0; i < n; i++)
+    {
+        const int *value = (const int *)tableSearch(t, &i);
+        found = found && value != NULL && *value == 2 * i;
+    }
+    printf("%d\n", found);                        // 1
+    printf("%p\n", tableSearch(t, &(int){-1})); // (nil)
+    printf("%d\n", tableDelete(t, &(int){0}));  // 1
+    printf("%u\n", tableSize(t));               // 329999
+
+    tableFree(t);
+    printf("LARGE TEST DONE.\n");
+}
+
 size_t strHash(const void *s)
 {
     size_t h = 0;
@@ -223,4 +257,28 @@ size_t strSize(const void *s)
 const char *strToString(const void *s)
 {
     return (const char *)s;
-}
\ No newline at end of file
+}
+
+size_t intHash(const void *i)
+{
+    // Knuth's multiplicative hash, consecutive keys land far apart
+    return (size_t)(*(const unsigned *)i * 2654435761u);
+}
+
+int intCmp(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void intCpy(void *dest, const void *src)
+{
+    *(int *)dest = *(const int *)src;
+}
+
+size_t intSize(const void *i)
+{
+    (void)i;
+    return sizeof(int);
+}
@@ -0,0 +1,296 @@
+/*
+    Contains implementation of the string interning pool declared in intern_pool.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    The index is an open addressing table (linear probing) of pointers into the arena. Each slot also stores
+    the full hash of its string, so most mismatching slots are skipped without calling strcmp().
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "intern_pool.h" // needed for pool operations
+#include <stdlib.h>      // needed for malloc(), calloc(), free()
+#include <stddef.h>      // needed for size_t
+#include <string.h>      // needed for strlen(), strcmp(), memcpy()
+
+// ***************************** CONSTANTS ***********************************************
+
+#define BLOCK_SIZE 65536          // bytes of string data per arena block
+#define INITIAL_INDEX_CAPACITY 64 // initial number of index slots (must be a power of 2)
+#define MAX_LOAD_FACTOR 0.5       // ratio of index slots that may be used before the index is doubled
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure for a block of the arena. Interned strings are copied one after another into data.
+
+    Fields:
+        next (struct ArenaBlock *) : pointer to the previously filled block (blocks form a SLL)
+        used (size_t) : number of bytes of data in use
+        capacity (size_t) : length of data
+        data (char []) : the string bytes (flexible array member, allocated with the block)
+*/
+struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t used;
+    size_t capacity;
+    char data[];
+};
+
+/*
+    Structure for a slot of the index.
+
+    Fields:
+        str (const char *) : interned string in the arena, or NULL for an empty slot
+        hash (size_t) : hash of str's characters
+*/
+struct InternSlot
+{
+    const char *str;
+    size_t hash;
+};
+
+/*
+    Structure that represents an interning pool.
+
+    Fields:
+        blocks (struct ArenaBlock *) : most recent arena block (head of the SLL of blocks)
+        slots (struct InternSlot *) : index slots
+        capacity (size_t) : length of 'slots' (a power of 2)
+        count (size_t) : number of interned strings
+*/
+struct InternPool
+{
+    struct ArenaBlock *blocks;
+    struct InternSlot *slots;
+    size_t capacity;
+    size_t count;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Hashes the characters of a string (FNV-1a).
+
+    Parameters:
+        s (const char *) : the string
+        len (size_t) : strlen(s)
+
+    Runtime: O(k)
+*/
+static size_t strHash(const char *s, size_t len);
+
+/*
+    Finds the slot of a string in a pool's index.
+
+    Parameters:
+        p (const InternPool *) : pointer to the pool
+        s (const char *) : the string
+        hash (size_t) : strHash() of s
+
+    Output:
+        The position of the slot holding s, or of the empty slot where s would be inserted.
+
+    Runtime: O(k) expected
+*/
+static size_t findSlot(const InternPool *p, const char *s, size_t hash);
+
+/*
+    Copies a string into a pool's arena.
+
+    Parameters:
+        p (InternPool *) : pointer to the pool
+        s (const char *) : the string
+        len (size_t) : strlen(s)
+
+    Output:
+        A pointer to the copy. A new block is allocated when the current one is full. A string that is larger
+        than a block gets a block of its own.
+
+    Runtime: O(k)
+*/
+static const char *arenaCopy(InternPool *p, const char *s, size_t len);
+
+/*
+    Doubles the capacity of a pool's index and re-inserts every string.
+
+    Parameters:
+        p (InternPool *) : pointer to the pool
+
+    Runtime: O(number of strings), strings are not re-hashed
+*/
+static void growIndex(InternPool *p);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+InternPool *internCreate(void)
+{
+    InternPool *p = (InternPool *)malloc(sizeof(InternPool));
+    p->blocks = NULL;
+    p->capacity = INITIAL_INDEX_CAPACITY;
+    p->count = 0;
+    // calloc() leaves every slot empty (NULL str)
+    p->slots = (struct InternSlot *)calloc(p->capacity, sizeof(struct InternSlot));
+    return p;
+}
+
+const char *intern(InternPool *p, const char *s)
+{
+    size_t len = strlen(s);
+    size_t hash = strHash(s, len);
+    size_t pos = findSlot(p, s, hash);
+
+    // already interned
+    if (p->slots[pos].str != NULL)
+    {
+        return p->slots[pos].str;
+    }
+
+    // make room first so the slot found below stays valid
+    if ((p->count + 1) > MAX_LOAD_FACTOR * p->capacity)
+    {
+        growIndex(p);
+        pos = findSlot(p, s, hash);
+    }
+    p->slots[pos].str = arenaCopy(p, s, len);
+    p->slots[pos].hash = hash;
+    p->count++;
+    return p->slots[pos].str;
+}
+
+const char *internLookup(const InternPool *p, const char *s)
+{
+    return p->slots[findSlot(p, s, strHash(s, strlen(s)))].str;
+}
+
+size_t internCount(const InternPool *p)
+{
+    return p->count;
+}
+
+void internFree(InternPool *p)
+{
+    // strings live in the blocks, so freeing the blocks frees every string at once
+    struct ArenaBlock *tmp = NULL;
+    while (p->blocks != NULL)
+    {
+        tmp = p->blocks->next;
+        free((void *)p->blocks);
+        p->blocks = tmp;
+    }
+    free((void *)p->slots);
+    p->slots = NULL;
+    p->capacity = 0;
+    p->count = 0;
+    free((void *)p);
+}
+
+size_t internedHash(const void *key)
+{
+    // interned strings are packed next to each other, so the low bits of their addresses vary, but the high bits
+    // are shared by the whole arena and only help once folded down over them
+    size_t h = (size_t)(*(const char *const *)key);
+    return h ^ (h >> 4) ^ (h >> 16);
+}
+
+int internedCmp(const void *key1, const void *key2)
+{
+    const char *s1 = *(const char *const *)key1;
+    const char *s2 = *(const char *const *)key2;
+    return (s1 > s2) - (s1 < s2);
+}
+
+void internedCpy(void *dest, const void *src)
+{
+    *(const char **)dest = *(const char *const *)src;
+}
+
+size_t internedSize(const void *key)
+{
+    (void)key;
+    return sizeof(const char *);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static size_t strHash(const char *s, size_t len)
+{
+    size_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static size_t findSlot(const InternPool *p, const char *s, size_t hash)
+{
+    // capacity is a power of 2, so masking is the same as the remainder
+    size_t mask = p->capacity - 1;
+    size_t pos = hash & mask;
+    // load factor keeps empty slots around, so the probe always ends
+    while (p->slots[pos].str != NULL)
+    {
+        if (p->slots[pos].hash == hash && strcmp(p->slots[pos].str, s) == 0)
+        {
+            return pos;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+static const char *arenaCopy(InternPool *p, const char *s, size_t len)
+{
+    // start a new block if the string (and its terminating null character) doesn't fit in the current one
+    if (p->blocks == NULL || p->blocks->used + len + 1 > p->blocks->capacity)
+    {
+        size_t capacity = len + 1 > BLOCK_SIZE ? len + 1 : BLOCK_SIZE;
+        struct ArenaBlock *b = (struct ArenaBlock *)malloc(sizeof(struct ArenaBlock) + capacity);
+        b->used = 0;
+        b->capacity = capacity;
+        b->next = p->blocks;
+        p->blocks = b;
+    }
+
+    char *copy = p->blocks->data + p->blocks->used;
+    memcpy(copy, s, len + 1);
+    p->blocks->used += len + 1;
+    return copy;
+}
+
+static void growIndex(InternPool *p)
+{
+    struct InternSlot *old = p->slots;
+    size_t oldCapacity = p->capacity;
+    p->capacity *= 2;
+    p->slots = (struct InternSlot *)calloc(p->capacity, sizeof(struct InternSlot));
+
+    // strings are distinct, so each one just goes in the first empty slot of its probe sequence
+    size_t mask = p->capacity - 1;
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+        if (old[i].str != NULL)
+        {
+            size_t pos = old[i].hash & mask;
+            while (p->slots[pos].str != NULL)
+            {
+                pos = (pos + 1) & mask;
+            }
+            p->slots[pos] = old[i];
+        }
+    }
+    free((void *)old);
+}
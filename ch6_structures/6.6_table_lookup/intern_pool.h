@@ -0,0 +1,112 @@
+/*
+    Contains declarations of a string interning pool. Interning a string returns a canonical, read-only copy of
+    it that lives as long as the pool, and every string with the same characters is given the same copy. The
+    copies are packed into large blocks (an arena) instead of being allocated one by one, and a hash index over
+    them finds the existing copy of a string.
+
+    Two interned strings are equal if and only if their pointers are equal, so a HashTable (see hash_table.h)
+    keyed on interned strings can hash and compare the pointers rather than the characters, and only has to
+    copy a pointer per key. The interned* functions below are the tableCreate() callbacks for such a table.
+
+    For runtime calculations of the declared operations, they are done with respect to the length (k) of the
+    string being interned.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef INTERN_POOL_H
+#define INTERN_POOL_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the InternPool. It is implemented via a structure that holds the arena and the index.
+*/
+typedef struct InternPool InternPool;
+
+/*
+    Creates an empty InternPool.
+
+    Output:
+        A pointer to the created InternPool.
+
+    Runtime: O(1)
+*/
+InternPool *internCreate(void);
+
+/*
+    Retrieves the canonical copy of a string, adding it to a provided pool if needed.
+
+    Parameters:
+        p (InternPool *) : pointer to the pool to use
+        s (const char *) : string to intern (not modified, not kept)
+
+    Output:
+        A pointer to the pool's copy of s. The same pointer is returned for every string equal to s until the
+        pool is freed. The copy must not be modified.
+
+    Runtime: O(k) expected
+*/
+const char *intern(InternPool *p, const char *s);
+
+/*
+    Retrieves the canonical copy of a string without adding it to a provided pool.
+
+    Parameters:
+        p (const InternPool *) : pointer to the pool to search (not modified)
+        s (const char *) : string to search for (not modified)
+
+    Output:
+        A pointer to the pool's copy of s if s has been interned, NULL otherwise.
+
+    Runtime: O(k) expected
+*/
+const char *internLookup(const InternPool *p, const char *s);
+
+/*
+    Retrieves the number of distinct strings in a provided pool.
+
+    Parameters:
+        p (const InternPool *) : pointer to a pool (not modified)
+
+    Output:
+        The number of distinct strings interned so far.
+
+    Runtime: O(1)
+*/
+size_t internCount(const InternPool *p);
+
+/*
+    De-allocates the memory allocated to a provided pool, including every interned string.
+
+    Parameters:
+        p (InternPool *) : pointer to the pool to free
+
+    Output:
+        The pool and all of its strings are freed, so every pointer returned by intern() becomes invalid. The
+        calling function should set p to NULL afterwards to avoid undefined behavior.
+
+    Runtime: O(number of strings / strings per arena block)
+*/
+void internFree(InternPool *p);
+
+/*
+    tableCreate() callbacks for a HashTable whose keys are interned strings. Keys are passed to the table as a
+    pointer to the interned pointer, e.g. for 'const char *word = intern(p, "the");' use tableInsert(t, &word, ...).
+    The table then stores only the pointer.
+
+        internedHash : hashes the interned pointer (not the characters)
+        internedCmp : compares the interned pointers. Equal strings compare 0, other strings are ordered by
+            address rather than alphabetically.
+        internedCpy : copies the interned pointer
+        internedSize : size of the stored key, sizeof(const char *)
+
+    Runtime: O(1)
+*/
+size_t internedHash(const void *key);
+int internedCmp(const void *key1, const void *key2);
+void internedCpy(void *dest, const void *src);
+size_t internedSize(const void *key);
+
+#endif
@@ -0,0 +1,137 @@
+#include "intern_pool.h"
+#include "hash_table.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+InternPool *p = NULL;
+
+const char *countToString(const void *c);
+size_t countSize(const void *c);
+void countCpy(void *dest, const void *src);
+void internTest(void);
+void growTest(void);
+void tableTest(void);
+
+int main()
+{
+    internTest();
+    growTest();
+    tableTest();
+    return 0;
+}
+
+void internTest(void)
+{
+    p = internCreate();
+    printf("%u\n", (unsigned)internCount(p));          // 0
+    printf("%p\n", (void *)internLookup(p, "cosi10")); // NULL
+
+    // equal strings from different buffers share one copy
+    char buf[16];
+    strcpy(buf, "cosi10");
+    const char *a = intern(p, "cosi10");
+    const char *b = intern(p, buf);
+    printf("%d\n", a == b);                      // 1
+    printf("%d\n", a != buf);                    // 1
+    printf("%s\n", a);                           // cosi10
+    printf("%d\n", internLookup(p, "cosi10") == a); // 1
+    printf("%u\n", (unsigned)internCount(p));    // 1
+
+    // different strings get different copies
+    const char *c = intern(p, "cosi11");
+    printf("%d\n", a != c);                   // 1
+    printf("%u\n", (unsigned)internCount(p)); // 2
+
+    // empty string is a valid string
+    printf("%d\n", intern(p, "") == intern(p, "")); // 1
+    printf("%u\n", (unsigned)internCount(p));       // 3
+
+    internFree(p);
+    printf("INTERN TEST DONE.\n");
+}
+
+void growTest(void)
+{
+    p = internCreate();
+    char buf[64];
+    const char *first[2000];
+
+    // enough strings to grow the index several times and fill more than one arena block
+    for (int i = 0; i < 2000; i++)
+    {
+        sprintf(buf, "token%d-%040d", i, i);
+        first[i] = intern(p, buf);
+    }
+    int same = 1;
+    for (int i = 0; i < 2000; i++)
+    {
+        sprintf(buf, "token%d-%040d", i, i);
+        same = same && intern(p, buf) == first[i] && strcmp(first[i], buf) == 0;
+    }
+    printf("%d\n", same);                     // 1
+    printf("%u\n", (unsigned)internCount(p)); // 2000
+
+    // a string larger than an arena block
+    static char big[100000];
+    memset(big, 'x', sizeof(big) - 1);
+    const char *bigCopy = intern(p, big);
+    printf("%d\n", strlen(bigCopy) == sizeof(big) - 1); // 1
+    printf("%d\n", intern(p, big) == bigCopy);         // 1
+
+    internFree(p);
+    printf("GROW TEST DONE.\n");
+}
+
+void tableTest(void)
+{
+    p = internCreate();
+    HashTable *t = tableCreate(internedHash, internedCmp, internedCpy, countCpy, internedSize, countSize, NULL, countToString, NULL, NULL);
+
+    // count words, the table only ever stores interned pointers
+    const char *words[] = {"the", "cat", "the", "hat", "the", "cat"};
+    for (int i = 0; i < 6; i++)
+    {
+        const char *w = intern(p, words[i]);
+        int *count = (int *)tableSearch(t, &w);
+        if (count == NULL)
+        {
+            int one = 1;
+            tableInsert(t, &w, &one);
+        }
+        else
+        {
+            (*count)++;
+        }
+    }
+
+    const char *the = intern(p, "the");
+    const char *cat = intern(p, "cat");
+    const char *hat = intern(p, "hat");
+    printf("%u\n", (unsigned)tableSize(t));     // 3
+    printf("%d\n", *(int *)tableSearch(t, &the)); // 3
+    printf("%d\n", *(int *)tableSearch(t, &cat)); // 2
+    printf("%d\n", *(int *)tableSearch(t, &hat)); // 1
+
+    tableFree(t);
+    internFree(p);
+    printf("TABLE TEST DONE.\n");
+}
+
+const char *countToString(const void *c)
+{
+    static char buf[16];
+    sprintf(buf, "%d", *(const int *)c);
+    return buf;
+}
+
+size_t countSize(const void *c)
+{
+    (void)c;
+    return sizeof(int);
+}
+
+void countCpy(void *dest, const void *src)
+{
+    *(int *)dest = *(const int *)src;
+}
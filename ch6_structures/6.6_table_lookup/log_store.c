@@ -0,0 +1,792 @@
+/*
+    Contains implementation of an append-only, log-structured key-value store that uses the HashTable in
+    hash_table.h as its in-memory index.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    Segment record format (integers are written in native byte order):
+        checksum (uint32_t) : FNV-1a hash of the value length, key bytes, and value bytes
+        keyLen (uint32_t) : number of key bytes (the terminating null character is not stored)
+        valLen (uint32_t) : number of value bytes, or TOMBSTONE for a delete record
+        key bytes, followed by value bytes (none for a delete record)
+
+    Hint record format:
+        keyLen (uint32_t), valLen (uint32_t), valOffset (uint64_t) : as above, plus the offset of the value
+            bytes in the segment file
+        key bytes
+
+    For runtime calculations of the declared operations, they are done with respect to the number of live keys
+    (n) and the number of records on disk (r).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "log_store.h"  // needed for store operations
+#include "hash_table.h" // needed for HashTable operations
+#include <stdlib.h>     // needed for malloc(), realloc(), free()
+#include <stddef.h>     // needed for size_t
+#include <stdio.h>      // needed for FILE, fopen(), fread(), fwrite(), fseek(), remove(), rename()
+#include <string.h>     // needed for strlen(), strcmp(), strcpy(), memcpy()
+#include <stdint.h>     // needed for uint32_t, uint64_t
+
+// ***************************** CONSTANTS ***********************************************
+
+#define TOMBSTONE 0xFFFFFFFFu              // valLen of a delete record
+#define HEADER_SIZE (3 * sizeof(uint32_t)) // bytes in a segment record before the key
+#define PATH_SUFFIX_SIZE 32                // room for ".<id>.hint" or ".meta.tmp" after the base path
+#define FNV_OFFSET 2166136261u             // FNV-1a initial hash value
+#define FNV_PRIME 16777619u                // FNV-1a multiplier
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure describing where the current value of a key is stored. It is the value type of the index.
+
+    Fields:
+        segment (size_t) : position of the segment in the store's segment list
+        offset (long) : offset of the value bytes in the segment file
+        length (uint32_t) : number of value bytes
+*/
+struct LogLocation
+{
+    size_t segment;
+    long offset;
+    uint32_t length;
+};
+
+/*
+    Structure for an open segment file.
+
+    Fields:
+        id (unsigned long) : id used in the segment's file names
+        file (FILE *) : the open segment file (readable by all segments, also writable by the active one)
+*/
+struct Segment
+{
+    unsigned long id;
+    FILE *file;
+};
+
+/*
+    Structure that represents a log-structured store.
+
+    Fields:
+        index (HashTable *) : table mapping key strings to (struct LogLocation) values
+        segments (struct Segment *) : array of segments, oldest first. The last one is the active segment.
+        numSegments (size_t) : length of 'segments'
+        nextId (unsigned long) : id given to the next segment that is created (ids are never reused)
+        writeOffset (long) : offset at which the next record is written in the active segment
+        maxSegmentSize (size_t) : size after which a new active segment is started
+        base (char *) : base path of the store's files
+        pathBuf (char *) : buffer large enough for any of the store's file names
+*/
+struct LogStore
+{
+    HashTable *index;
+    struct Segment *segments;
+    size_t numSegments;
+    unsigned long nextId;
+    long writeOffset;
+    size_t maxSegmentSize;
+    char *base;
+    char *pathBuf;
+};
+
+/*
+    Structure passed to a record visitor when index entries are built from a segment.
+
+    Fields:
+        s (LogStore *) : the store whose index is being built
+        segment (size_t) : position of the segment being read
+*/
+struct IndexContext
+{
+    LogStore *s;
+    size_t segment;
+};
+
+/*
+    Structure passed through tableForEach() during compaction.
+
+    Fields:
+        s (LogStore *) : the store being compacted
+        activeSegment (size_t) : position of the active segment in the segment list before compaction
+        merged (FILE *) : merged segment being written
+        offset (long) : offset of the next record in the merged segment (only used when relocating)
+        buf (void *) : buffer that values are copied through
+        bufSize (size_t) : size of buf
+        ok (int) : 1 as long as every record has been copied successfully
+*/
+struct CompactContext
+{
+    LogStore *s;
+    size_t activeSegment;
+    FILE *merged;
+    long offset;
+    void *buf;
+    size_t bufSize;
+    int ok;
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Builds the name of one of a store's files into its path buffer.
+
+    Parameters:
+        s (LogStore *) : pointer to the store
+        id (unsigned long) : segment id (ignored for the meta file)
+        ext (const char *) : "log", "hint", "meta", or "meta.tmp"
+
+    Output:
+        s->pathBuf holds the file name, which is also returned.
+
+    Runtime: O(1)
+*/
+static const char *filePath(LogStore *s, unsigned long id, const char *ext);
+
+/*
+    Appends a record to a provided segment file.
+
+    Parameters:
+        f (FILE *) : segment file, positioned where the record is to be written
+        key (const char *) : key string
+        value (const void *) : value bytes (ignored for a delete record)
+        valLen (uint32_t) : number of value bytes or TOMBSTONE
+
+    Output:
+        1 if the whole record was written, 0 otherwise.
+
+    Runtime: O(1)
+*/
+static int writeRecord(FILE *f, const char *key, const void *value, uint32_t valLen);
+
+/*
+    Reads the records of a segment file in order, stopping at the end of the file or at the first record that
+    is incomplete or fails its checksum.
+
+    Parameters:
+        f (FILE *) : segment file to read (read from the beginning)
+        visit (void (*) (const char *, uint32_t, long, void *)) : called for every valid record with its key,
+            valLen (TOMBSTONE for deletes), the offset of its value bytes, and ctx
+        ctx (void *) : passed through to visit
+
+    Output:
+        The offset just past the last valid record.
+
+    Runtime: O(records in segment)
+*/
+static long scanSegment(FILE *f, void (*visit)(const char *, uint32_t, long, void *), void *ctx);
+
+/*
+    Record visitor that applies a record to the index. ctx is an IndexContext.
+*/
+static void indexRecord(const char *key, uint32_t valLen, long valOffset, void *ctx);
+
+/*
+    Record visitor that writes a record to a hint file. ctx is the hint FILE.
+*/
+static void hintRecord(const char *key, uint32_t valLen, long valOffset, void *ctx);
+
+/*
+    Loads the index entries of a segment from its hint file.
+
+    Parameters:
+        s (LogStore *) : pointer to the store
+        segment (size_t) : position of the segment
+        hint (FILE *) : the segment's open hint file
+
+    Output:
+        The index reflects every record described by the hint file.
+
+    Runtime: O(records in segment)
+*/
+static void loadHint(LogStore *s, size_t segment, FILE *hint);
+
+/*
+    Writes the hint file of a segment by reading the segment file.
+
+    Parameters:
+        s (LogStore *) : pointer to the store
+        segment (const struct Segment *) : the segment to write a hint for
+
+    Output:
+        <path>.<id>.hint describes every valid record of the segment. 1 is returned on success, 0 otherwise.
+
+    Runtime: O(records in segment)
+*/
+static int writeHint(LogStore *s, const struct Segment *segment);
+
+/*
+    Replaces the meta file with the store's current segment list.
+
+    Parameters:
+        s (LogStore *) : pointer to the store
+
+    Output:
+        The list is written to <path>.meta.tmp, which then replaces <path>.meta. 1 is returned on success,
+        0 otherwise.
+
+    Runtime: O(number of segments)
+*/
+static int writeMeta(LogStore *s);
+
+/*
+    Closes the active segment to writes and starts a new, empty active segment.
+
+    Parameters:
+        s (LogStore *) : pointer to the store
+
+    Output:
+        A hint is written for the old active segment, a new segment file is created and added to the segment
+        list, and the meta file is rewritten. 1 is returned on success, 0 otherwise.
+
+    Runtime: O(records in the old active segment)
+*/
+static int rotate(LogStore *s);
+
+/*
+    tableForEach() visitors used by compaction. ctx is a CompactContext.
+        copyLiveValue : copies the value of every key not in the active segment into the merged segment
+        relocateValue : points the index at the copied values, in the same order copyLiveValue wrote them
+*/
+static void copyLiveValue(const void *key, void *val, void *ctx);
+static void relocateValue(const void *key, void *val, void *ctx);
+
+/*
+    Continues an FNV-1a hash over a provided number of bytes.
+*/
+static uint32_t fnv1a(uint32_t h, const void *data, size_t len);
+
+/*
+    Functions used by the index for string keys and (struct LogLocation) values.
+*/
+static size_t keyHash(const void *key);
+static size_t keySize(const void *key);
+static void locationCpy(void *dest, const void *src);
+static size_t locationSize(const void *loc);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+LogStore *storeOpen(const char *path, size_t maxSegmentSize)
+{
+    LogStore *s = (LogStore *)malloc(sizeof(LogStore));
+    s->base = (char *)malloc(strlen(path) + 1);
+    strcpy(s->base, path);
+    s->pathBuf = (char *)malloc(strlen(path) + PATH_SUFFIX_SIZE);
+    s->maxSegmentSize = maxSegmentSize;
+    s->index = tableCreate(keyHash, (int (*)(const void *, const void *))strcmp, (void (*)(void *, const void *))strcpy, locationCpy, keySize, locationSize, NULL, NULL, NULL, NULL);
+    s->segments = NULL;
+    s->numSegments = 0;
+    s->nextId = 0;
+    s->writeOffset = 0;
+
+    // read the segment list, a leftover temporary list means a crash happened while it was being replaced
+    FILE *meta = fopen(filePath(s, 0, "meta"), "r");
+    if (meta == NULL)
+    {
+        meta = fopen(filePath(s, 0, "meta.tmp"), "r");
+    }
+    if (meta != NULL)
+    {
+        unsigned long id;
+        while (fscanf(meta, "%lu", &id) == 1)
+        {
+            s->segments = (struct Segment *)realloc(s->segments, (s->numSegments + 1) * sizeof(struct Segment));
+            s->segments[s->numSegments].id = id;
+            s->segments[s->numSegments].file = NULL;
+            s->numSegments++;
+            if (id >= s->nextId)
+            {
+                s->nextId = id + 1;
+            }
+        }
+        fclose(meta);
+    }
+
+    // brand new store, start with one empty active segment
+    if (s->numSegments == 0)
+    {
+        s->segments = (struct Segment *)malloc(sizeof(struct Segment));
+        s->segments[0].id = s->nextId++;
+        s->segments[0].file = fopen(filePath(s, s->segments[0].id, "log"), "w+b");
+        s->numSegments = 1;
+        if (s->segments[0].file == NULL || !writeMeta(s))
+        {
+            storeClose(s);
+            return NULL;
+        }
+        return s;
+    }
+
+    // rebuild the index oldest segment first, so newer records override older ones
+    for (size_t i = 0; i < s->numSegments; i++)
+    {
+        int active = i == s->numSegments - 1;
+        s->segments[i].file = fopen(filePath(s, s->segments[i].id, "log"), active ? "r+b" : "rb");
+        if (s->segments[i].file == NULL)
+        {
+            storeClose(s);
+            return NULL;
+        }
+
+        // the active segment never has a hint, it has to be read record by record
+        FILE *hint = active ? NULL : fopen(filePath(s, s->segments[i].id, "hint"), "rb");
+        if (hint != NULL)
+        {
+            loadHint(s, i, hint);
+            fclose(hint);
+        }
+        else
+        {
+            struct IndexContext ctx = {s, i};
+            long end = scanSegment(s->segments[i].file, indexRecord, &ctx);
+            if (active)
+            {
+                // anything after the last valid record is a torn write and will be overwritten
+                s->writeOffset = end;
+            }
+        }
+    }
+    return s;
+}
+
+int storePut(LogStore *s, const char *key, const void *value, size_t valLen)
+{
+    size_t keyLen = strlen(key);
+    size_t recordSize = HEADER_SIZE + keyLen + valLen;
+    if (valLen >= TOMBSTONE)
+    {
+        return 0;
+    }
+
+    // start a new segment if this record would overflow a non-empty active segment
+    if (s->writeOffset > 0 && s->writeOffset + recordSize > s->maxSegmentSize && !rotate(s))
+    {
+        return 0;
+    }
+
+    FILE *active = s->segments[s->numSegments - 1].file;
+    // reads may have moved the file position, so always seek to the end of the valid records
+    fseek(active, s->writeOffset, SEEK_SET);
+    if (!writeRecord(active, key, value, (uint32_t)valLen) || fflush(active) != 0)
+    {
+        return 0;
+    }
+
+    struct LogLocation loc = {s->numSegments - 1, (long)(s->writeOffset + HEADER_SIZE + keyLen), (uint32_t)valLen};
+    tableInsert(s->index, key, &loc);
+    s->writeOffset += recordSize;
+    return 1;
+}
+
+long storeGet(LogStore *s, const char *key, void *buf, size_t bufLen)
+{
+    struct LogLocation *loc = (struct LogLocation *)tableSearch(s->index, key);
+    if (loc == NULL)
+    {
+        return -1;
+    }
+
+    // only copy as much as the caller has room for
+    size_t toRead = loc->length < bufLen ? loc->length : bufLen;
+    FILE *f = s->segments[loc->segment].file;
+    // a failed read would leave stale bytes in buf, so it must not look like a found value
+    if (fseek(f, loc->offset, SEEK_SET) != 0 || fread(buf, 1, toRead, f) != toRead)
+    {
+        return -2;
+    }
+    return (long)loc->length;
+}
+
+int storeDelete(LogStore *s, const char *key)
+{
+    if (tableSearch(s->index, key) == NULL)
+    {
+        return 0;
+    }
+
+    size_t recordSize = HEADER_SIZE + strlen(key);
+    if (s->writeOffset > 0 && s->writeOffset + recordSize > s->maxSegmentSize && !rotate(s))
+    {
+        return 0;
+    }
+
+    FILE *active = s->segments[s->numSegments - 1].file;
+    fseek(active, s->writeOffset, SEEK_SET);
+    if (!writeRecord(active, key, NULL, TOMBSTONE) || fflush(active) != 0)
+    {
+        return 0;
+    }
+    s->writeOffset += recordSize;
+    tableDelete(s->index, key);
+    return 1;
+}
+
+size_t storeSize(const LogStore *s)
+{
+    return tableSize(s->index);
+}
+
+int storeCompact(LogStore *s)
+{
+    // only the active segment exists, nothing to merge
+    if (s->numSegments < 2)
+    {
+        return 1;
+    }
+
+    // copy the live values of the inactive segments into a new segment
+    struct Segment merged = {s->nextId, NULL};
+    merged.file = fopen(filePath(s, merged.id, "log"), "w+b");
+    if (merged.file == NULL)
+    {
+        return 0;
+    }
+    struct CompactContext ctx = {s, s->numSegments - 1, merged.file, 0, NULL, 0, 1};
+    tableForEach(s->index, copyLiveValue, &ctx);
+    if (!ctx.ok || fflush(merged.file) != 0 || !writeHint(s, &merged))
+    {
+        // index has not been touched yet, so discarding the merged segment leaves the store as it was
+        free(ctx.buf);
+        fclose(merged.file);
+        remove(filePath(s, merged.id, "log"));
+        remove(filePath(s, merged.id, "hint"));
+        return 0;
+    }
+    free(ctx.buf);
+
+    // new segment list is [merged, active]
+    struct Segment *old = s->segments;
+    size_t numOld = s->numSegments;
+    s->segments = (struct Segment *)malloc(2 * sizeof(struct Segment));
+    s->segments[0] = merged;
+    s->segments[1] = old[numOld - 1];
+    s->numSegments = 2;
+    s->nextId++;
+    if (!writeMeta(s))
+    {
+        // the old list is still the one on disk, go back to it
+        free(s->segments);
+        s->segments = old;
+        s->numSegments = numOld;
+        fclose(merged.file);
+        remove(filePath(s, merged.id, "log"));
+        remove(filePath(s, merged.id, "hint"));
+        return 0;
+    }
+
+    // the merged segment is now the one on disk, point the index at it (visits entries in the same order)
+    ctx.offset = 0;
+    tableForEach(s->index, relocateValue, &ctx);
+
+    // old segments are no longer referenced
+    for (size_t i = 0; i < numOld - 1; i++)
+    {
+        fclose(old[i].file);
+        remove(filePath(s, old[i].id, "log"));
+        remove(filePath(s, old[i].id, "hint"));
+    }
+    free(old);
+    return 1;
+}
+
+void storeClose(LogStore *s)
+{
+    for (size_t i = 0; i < s->numSegments; i++)
+    {
+        if (s->segments[i].file != NULL)
+        {
+            fclose(s->segments[i].file);
+            s->segments[i].file = NULL;
+        }
+    }
+    free(s->segments);
+    s->segments = NULL;
+    tableFree(s->index);
+    s->index = NULL;
+    free(s->base);
+    s->base = NULL;
+    free(s->pathBuf);
+    s->pathBuf = NULL;
+    free((void *)s);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static const char *filePath(LogStore *s, unsigned long id, const char *ext)
+{
+    // meta files are not tied to a segment
+    if (ext[0] == 'm')
+    {
+        sprintf(s->pathBuf, "%s.%s", s->base, ext);
+    }
+    else
+    {
+        sprintf(s->pathBuf, "%s.%lu.%s", s->base, id, ext);
+    }
+    return s->pathBuf;
+}
+
+static int writeRecord(FILE *f, const char *key, const void *value, uint32_t valLen)
+{
+    uint32_t keyLen = (uint32_t)strlen(key);
+    uint32_t valBytes = valLen == TOMBSTONE ? 0 : valLen;
+
+    // checksum covers the length so a delete can't be mistaken for an empty put
+    uint32_t checksum = fnv1a(FNV_OFFSET, &valLen, sizeof(uint32_t));
+    checksum = fnv1a(checksum, key, keyLen);
+    checksum = fnv1a(checksum, value, valBytes);
+
+    return fwrite(&checksum, sizeof(uint32_t), 1, f) == 1 &&
+           fwrite(&keyLen, sizeof(uint32_t), 1, f) == 1 &&
+           fwrite(&valLen, sizeof(uint32_t), 1, f) == 1 &&
+           fwrite(key, 1, keyLen, f) == keyLen &&
+           (valBytes == 0 || fwrite(value, 1, valBytes, f) == valBytes);
+}
+
+static long scanSegment(FILE *f, void (*visit)(const char *, uint32_t, long, void *), void *ctx)
+{
+    // key and value buffers, grown as needed
+    char *key = NULL;
+    size_t keyCap = 0;
+    char *val = NULL;
+    size_t valCap = 0;
+
+    uint32_t header[3]; // checksum, keyLen, valLen
+    long offset = 0;
+    rewind(f);
+    while (fread(header, sizeof(uint32_t), 3, f) == 3)
+    {
+        uint32_t valBytes = header[2] == TOMBSTONE ? 0 : header[2];
+        if (header[1] + 1 > keyCap)
+        {
+            keyCap = header[1] + 1;
+            key = (char *)realloc(key, keyCap);
+        }
+        if (valBytes > valCap)
+        {
+            valCap = valBytes;
+            val = (char *)realloc(val, valCap);
+        }
+
+        // stop at a record that was cut off or corrupted
+        if (fread(key, 1, header[1], f) != header[1] || (valBytes > 0 && fread(val, 1, valBytes, f) != valBytes))
+        {
+            break;
+        }
+        uint32_t checksum = fnv1a(FNV_OFFSET, &header[2], sizeof(uint32_t));
+        checksum = fnv1a(checksum, key, header[1]);
+        checksum = fnv1a(checksum, val, valBytes);
+        if (checksum != header[0])
+        {
+            break;
+        }
+
+        key[header[1]] = '\0';
+        (*visit)(key, header[2], (long)(offset + HEADER_SIZE + header[1]), ctx);
+        offset += HEADER_SIZE + header[1] + valBytes;
+    }
+
+    free(key);
+    free(val);
+    return offset;
+}
+
+static void indexRecord(const char *key, uint32_t valLen, long valOffset, void *ctx)
+{
+    struct IndexContext *ic = (struct IndexContext *)ctx;
+    if (valLen == TOMBSTONE)
+    {
+        tableDelete(ic->s->index, key);
+    }
+    else
+    {
+        struct LogLocation loc = {ic->segment, valOffset, valLen};
+        tableInsert(ic->s->index, key, &loc);
+    }
+}
+
+static void hintRecord(const char *key, uint32_t valLen, long valOffset, void *ctx)
+{
+    FILE *hint = (FILE *)ctx;
+    uint32_t keyLen = (uint32_t)strlen(key);
+    uint64_t offset = (uint64_t)valOffset;
+    fwrite(&keyLen, sizeof(uint32_t), 1, hint);
+    fwrite(&valLen, sizeof(uint32_t), 1, hint);
+    fwrite(&offset, sizeof(uint64_t), 1, hint);
+    fwrite(key, 1, keyLen, hint);
+}
+
+static void loadHint(LogStore *s, size_t segment, FILE *hint)
+{
+    struct IndexContext ctx = {s, segment};
+    char *key = NULL;
+    size_t keyCap = 0;
+    uint32_t lens[2]; // keyLen, valLen
+    uint64_t offset;
+
+    while (fread(lens, sizeof(uint32_t), 2, hint) == 2 && fread(&offset, sizeof(uint64_t), 1, hint) == 1)
+    {
+        if (lens[0] + 1 > keyCap)
+        {
+            keyCap = lens[0] + 1;
+            key = (char *)realloc(key, keyCap);
+        }
+        if (fread(key, 1, lens[0], hint) != lens[0])
+        {
+            break;
+        }
+        key[lens[0]] = '\0';
+        indexRecord(key, lens[1], (long)offset, &ctx);
+    }
+    free(key);
+}
+
+static int writeHint(LogStore *s, const struct Segment *segment)
+{
+    FILE *hint = fopen(filePath(s, segment->id, "hint"), "wb");
+    if (hint == NULL)
+    {
+        return 0;
+    }
+    scanSegment(segment->file, hintRecord, hint);
+    // a hint that failed to write would be trusted on restart, so remove it instead. A buffered write that
+    // failed (e.g. a full disk) sets the error flag but may not make fclose() fail, so both are checked.
+    int failed = ferror(hint);
+    if (fclose(hint) != 0 || failed)
+    {
+        remove(filePath(s, segment->id, "hint"));
+        return 0;
+    }
+    return 1;
+}
+
+static int writeMeta(LogStore *s)
+{
+    FILE *meta = fopen(filePath(s, 0, "meta.tmp"), "w");
+    if (meta == NULL)
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < s->numSegments; i++)
+    {
+        fprintf(meta, "%lu\n", s->segments[i].id);
+    }
+    if (fclose(meta) != 0)
+    {
+        return 0;
+    }
+
+    // rename() does not replace an existing file on every platform, so the old list is removed first.
+    // storeOpen() falls back to the temporary list if a crash happens in between.
+    char *tmpPath = (char *)malloc(strlen(s->pathBuf) + 1);
+    strcpy(tmpPath, s->pathBuf);
+    remove(filePath(s, 0, "meta"));
+    int ok = rename(tmpPath, s->pathBuf) == 0;
+    free(tmpPath);
+    return ok;
+}
+
+static int rotate(LogStore *s)
+{
+    // the old active segment is now read-only, give it a hint for faster restarts
+    if (!writeHint(s, &s->segments[s->numSegments - 1]))
+    {
+        return 0;
+    }
+
+    struct Segment next = {s->nextId, NULL};
+    next.file = fopen(filePath(s, next.id, "log"), "w+b");
+    if (next.file == NULL)
+    {
+        return 0;
+    }
+    s->segments = (struct Segment *)realloc(s->segments, (s->numSegments + 1) * sizeof(struct Segment));
+    s->segments[s->numSegments] = next;
+    s->numSegments++;
+    s->nextId++;
+    s->writeOffset = 0;
+    return writeMeta(s);
+}
+
+static void copyLiveValue(const void *key, void *val, void *ctx)
+{
+    struct CompactContext *cc = (struct CompactContext *)ctx;
+    struct LogLocation *loc = (struct LogLocation *)val;
+    // values in the active segment stay where they are
+    if (!cc->ok || loc->segment == cc->activeSegment)
+    {
+        return;
+    }
+
+    if (loc->length > cc->bufSize)
+    {
+        cc->bufSize = loc->length;
+        cc->buf = realloc(cc->buf, cc->bufSize);
+    }
+    FILE *f = cc->s->segments[loc->segment].file;
+    cc->ok = fseek(f, loc->offset, SEEK_SET) == 0 &&
+             fread(cc->buf, 1, loc->length, f) == loc->length &&
+             writeRecord(cc->merged, (const char *)key, cc->buf, loc->length);
+}
+
+static void relocateValue(const void *key, void *val, void *ctx)
+{
+    struct CompactContext *cc = (struct CompactContext *)ctx;
+    struct LogLocation *loc = (struct LogLocation *)val;
+    size_t keyLen = strlen((const char *)key);
+
+    // segment list is now [merged, active], loc->segment still refers to the old list
+    if (loc->segment == cc->activeSegment)
+    {
+        loc->segment = 1;
+        return;
+    }
+
+    // copyLiveValue wrote the records back to back, so the offsets can be recomputed in the same order
+    loc->segment = 0;
+    loc->offset = (long)(cc->offset + HEADER_SIZE + keyLen);
+    cc->offset += HEADER_SIZE + keyLen + loc->length;
+}
+
+static uint32_t fnv1a(uint32_t h, const void *data, size_t len)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= bytes[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static size_t keyHash(const void *key)
+{
+    return (size_t)fnv1a(FNV_OFFSET, key, strlen((const char *)key));
+}
+
+static size_t keySize(const void *key)
+{
+    return strlen((const char *)key) + 1;
+}
+
+static void locationCpy(void *dest, const void *src)
+{
+    memcpy(dest, src, sizeof(struct LogLocation));
+}
+
+static size_t locationSize(const void *loc)
+{
+    (void)loc;
+    return sizeof(struct LogLocation);
+}
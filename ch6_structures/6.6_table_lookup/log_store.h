@@ -0,0 +1,152 @@
+/*
+    Contains declarations of an append-only, log-structured key-value store (in the style of Bitcask) that
+    persists string keys and arbitrary byte values to local files. The HashTable in hash_table.h is used as an
+    in-memory index that maps every live key to the location of its most recent value on disk.
+
+    On disk, a store named by a base path is made up of:
+        <path>.meta         : text file listing the ids of the store's segments from oldest to newest
+        <path>.<id>.log     : segment files holding records (puts and deletes) in the order they were written
+        <path>.<id>.hint    : optional index of a segment (key, value location), written once a segment stops
+                              receiving writes, so restart does not need to read every value
+
+    Writes are only ever appended to the newest (active) segment, so puts are sequential writes. A get is a
+    single positioned read from the segment the index points to. Overwritten and deleted values are reclaimed
+    by storeCompact(), which merges all segments except the active one into a single segment.
+
+    For runtime calculations of the declared operations, they are done with respect to the number of live keys
+    (n) and the number of records on disk (r). Hashing and comparing keys is considered to be O(1).
+
+    NOTE: Durability is limited to what the C library provides: every record is flushed with fflush() before a
+    put or delete returns, which hands it to the operating system but does not force it to the disk.
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definition of the LogStore. It is implemented via a structure that holds the HashTable index and the
+    open segment files.
+*/
+typedef struct LogStore LogStore;
+
+/*
+    Opens the store with a provided base path, creating it if it does not exist.
+
+    Parameters:
+        path (const char *) : base path of the store's files (e.g. "data/store")
+        maxSegmentSize (size_t) : number of bytes after which the active segment is closed and a new one is
+            started. A record larger than this still gets a segment of its own.
+
+    Output:
+        A pointer to the opened LogStore, with its index rebuilt from the hint files (or the segment files for
+        segments without a hint). A trailing record that was only partially written is ignored and will be
+        overwritten by the next write.
+
+        If a segment file cannot be opened or created, NULL is returned.
+
+    Runtime: O(r)
+*/
+LogStore *storeOpen(const char *path, size_t maxSegmentSize);
+
+/*
+    Associates a value with a key in a provided LogStore, replacing any previous value.
+
+    Parameters:
+        s (LogStore *) : pointer to the LogStore to update
+        key (const char *) : key string (not modified)
+        value (const void *) : pointer to the value bytes (not modified)
+        valLen (size_t) : number of bytes referenced by value
+
+    Output:
+        The record is appended to the active segment and flushed, and the index is updated to point at it.
+        1 is returned on success, 0 if the record could not be written.
+
+    Runtime: O(1) expected
+*/
+int storePut(LogStore *s, const char *key, const void *value, size_t valLen);
+
+/*
+    Retrieves the value associated with a key in a provided LogStore.
+
+    Parameters:
+        s (LogStore *) : pointer to the LogStore to search
+        key (const char *) : key string (not modified)
+        buf (void *) : buffer the value is copied into
+        bufLen (size_t) : size of buf in bytes
+
+    Output:
+        If the key exists, the first min(bufLen, value length) bytes of its value are copied into buf and the
+        full length of the value is returned, so a return value larger than bufLen means buf was too small.
+
+        If the key does not exist, -1 is returned. If the key exists but its value could not be read from its
+        segment, -2 is returned (buf may have been partly overwritten).
+
+    Runtime: O(1) expected (1 positioned read)
+*/
+long storeGet(LogStore *s, const char *key, void *buf, size_t bufLen);
+
+/*
+    Removes a key from a provided LogStore.
+
+    Parameters:
+        s (LogStore *) : pointer to the LogStore to update
+        key (const char *) : key string (not modified)
+
+    Output:
+        If the key exists, a delete record is appended to the active segment, the key is removed from the index,
+        and 1 is returned. Otherwise, 0 is returned.
+
+    Runtime: O(1) expected
+*/
+int storeDelete(LogStore *s, const char *key);
+
+/*
+    Retrieves the number of live keys in a provided LogStore.
+
+    Parameters:
+        s (const LogStore *) : pointer to a LogStore (not modified)
+
+    Output:
+        The number of keys that currently have a value.
+
+    Runtime: O(1)
+*/
+size_t storeSize(const LogStore *s);
+
+/*
+    Merges every segment except the active one into a single segment holding only their live values.
+
+    Parameters:
+        s (LogStore *) : pointer to the LogStore to compact
+
+    Output:
+        A new segment (with a hint file) containing the live values of the old segments is written and listed
+        in the meta file, after which the old segment and hint files are removed. If the process stops before
+        the meta file is replaced, the store reopens in its previous state.
+
+        1 is returned on success, 0 if the merged segment could not be written (the store is left unchanged).
+
+    Runtime: O(n + r)
+*/
+int storeCompact(LogStore *s);
+
+/*
+    Closes a provided LogStore and de-allocates its memory.
+
+    Parameters:
+        s (LogStore *) : pointer to the LogStore to close
+
+    Output:
+        All segment files are flushed and closed and the memory allocated to s is freed. The calling function
+        should set s to NULL afterwards to avoid undefined behavior.
+
+    Runtime: O(n)
+*/
+void storeClose(LogStore *s);
+
+#endif
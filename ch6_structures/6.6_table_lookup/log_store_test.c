@@ -0,0 +1,165 @@
+#include "log_store.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+#define STORE_PATH "log_store_test_db"
+
+LogStore *s = NULL;
+
+void put(const char *key, const char *value);
+void get(const char *key);
+void removeStoreFiles(void);
+void putGetTest(void);
+void reopenTest(void);
+void compactTest(void);
+void tornWriteTest(void);
+
+int main()
+{
+    removeStoreFiles();
+    putGetTest();
+    reopenTest();
+    compactTest();
+    tornWriteTest();
+    removeStoreFiles();
+    return 0;
+}
+
+void putGetTest(void)
+{
+    // small segments so that rotation happens every few records
+    s = storeOpen(STORE_PATH, 64);
+    get("cosi10");                             // NULL
+    printf("%d\n", storeDelete(s, "cosi10")); // 0
+
+    put("cosi10", "java");
+    get("cosi10"); // java
+    put("cosi10", "python");
+    get("cosi10"); // python
+    put("cosi11", "java");
+    put("cosi12", "c");
+    put("cosi21", "scheme");
+    printf("%u\n", (unsigned)storeSize(s)); // 4
+
+    printf("%d\n", storeDelete(s, "cosi12")); // 1
+    printf("%d\n", storeDelete(s, "cosi12")); // 0
+    get("cosi12");                            // NULL
+    printf("%u\n", (unsigned)storeSize(s));  // 3
+
+    // buffer too small, length is still reported
+    char small[2];
+    printf("%ld\n", storeGet(s, "cosi21", small, sizeof(small))); // 7
+
+    storeClose(s);
+    printf("PUT GET TEST DONE.\n");
+}
+
+void reopenTest(void)
+{
+    // index is rebuilt from hint files and the active segment
+    s = storeOpen(STORE_PATH, 64);
+    printf("%u\n", (unsigned)storeSize(s)); // 3
+    get("cosi10");                           // python
+    get("cosi11");                           // java
+    get("cosi12");                           // NULL
+    get("cosi21");                           // scheme
+
+    put("cosi12", "c++");
+    storeClose(s);
+
+    s = storeOpen(STORE_PATH, 64);
+    get("cosi12"); // c++
+    storeClose(s);
+    printf("REOPEN TEST DONE.\n");
+}
+
+void compactTest(void)
+{
+    s = storeOpen(STORE_PATH, 64);
+    // pile up overwritten values
+    for (int i = 0; i < 20; i++)
+    {
+        char value[16];
+        sprintf(value, "v%d", i);
+        put("counter", value);
+    }
+    printf("%d\n", storeCompact(s)); // 1
+    printf("%u\n", (unsigned)storeSize(s)); // 5
+    get("counter");                          // v19
+    get("cosi10");                           // python
+    get("cosi12");                           // c++
+
+    // writes after compaction land in the active segment
+    put("cosi10", "rust");
+    printf("%d\n", storeCompact(s)); // 1
+    storeClose(s);
+
+    s = storeOpen(STORE_PATH, 64);
+    printf("%u\n", (unsigned)storeSize(s)); // 5
+    get("counter");                          // v19
+    get("cosi10");                           // rust
+    get("cosi11");                           // java
+    get("cosi12");                           // c++
+    get("cosi21");                           // scheme
+    storeClose(s);
+    printf("COMPACT TEST DONE.\n");
+}
+
+void tornWriteTest(void)
+{
+    removeStoreFiles();
+    s = storeOpen(STORE_PATH, 1024);
+    put("a", "1");
+    put("b", "2");
+    storeClose(s);
+
+    // simulate a crash in the middle of a write by appending half a record
+    FILE *f = fopen(STORE_PATH ".0.log", "ab");
+    fwrite("\x01\x02\x03\x04\x05", 1, 5, f);
+    fclose(f);
+
+    s = storeOpen(STORE_PATH, 1024);
+    printf("%u\n", (unsigned)storeSize(s)); // 2
+    put("c", "3");
+    storeClose(s);
+
+    s = storeOpen(STORE_PATH, 1024);
+    get("a"); // 1
+    get("b"); // 2
+    get("c"); // 3
+    storeClose(s);
+    printf("TORN WRITE TEST DONE.\n");
+}
+
+void put(const char *key, const char *value)
+{
+    storePut(s, key, value, strlen(value) + 1);
+}
+
+void get(const char *key)
+{
+    char buf[64];
+    if (storeGet(s, key, buf, sizeof(buf)) < 0)
+    {
+        printf("NULL\n");
+    }
+    else
+    {
+        printf("%s\n", buf);
+    }
+}
+
+void removeStoreFiles(void)
+{
+    char path[64];
+    remove(STORE_PATH ".meta");
+    remove(STORE_PATH ".meta.tmp");
+    for (int id = 0; id < 100; id++)
+    {
+        sprintf(path, "%s.%d.log", STORE_PATH, id);
+        remove(path);
+        sprintf(path, "%s.%d.hint", STORE_PATH, id);
+        remove(path);
+    }
+}
@@ -0,0 +1,263 @@
+/*
+    Contains implementation of the HyperLogLog and Count-Min sketches declared in sketches.h.
+
+    File format :
+        1.  Necessary headers
+        2.  Constants
+        3.  Structure definitions
+        4.  Private (static) helper function declarations
+        5.  Public header function definitions
+        6.  Private (static) helper function definitions
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+// ***************************** NECESSARY HEADERS ***************************************
+
+#include "sketches.h" // needed for sketch operations
+#include <stdlib.h>   // needed for malloc(), calloc(), free()
+#include <stddef.h>   // needed for size_t
+#include <math.h>     // needed for ldexp(), log()
+
+// ***************************** CONSTANTS ***********************************************
+
+#define HLL_MIN_PRECISION 4  // smallest supported number of register index bits
+#define HLL_MAX_PRECISION 18 // largest supported number of register index bits
+
+// ***************************** STRUCTURE DEFINITIONS ***********************************
+
+/*
+    Structure that represents a HyperLogLog.
+
+    Fields:
+        registers (unsigned char *) : array of 2^precision registers, each holding the largest rank seen by
+            keys whose hash selects that register
+        precision (unsigned) : number of hash bits used to select a register
+        hash (size_t (*) (const void *)) : hash function to be used on keys
+*/
+struct HyperLogLog
+{
+    unsigned char *registers;
+    unsigned precision;
+    size_t (*hash)(const void *);
+};
+
+/*
+    Structure that represents a Count-Min sketch.
+
+    Fields:
+        counters (size_t *) : depth rows of width counters stored row after row
+        width (size_t) : number of counters per row
+        depth (size_t) : number of rows
+        hash (size_t (*) (const void *)) : hash function to be used on keys
+*/
+struct CountMinSketch
+{
+    size_t *counters;
+    size_t width;
+    size_t depth;
+    size_t (*hash)(const void *);
+};
+
+// ***************************** PRIVATE HELPER FUNCTION DECLARATIONS ***********************************
+
+/*
+    Spreads the bits of a provided hash value over a 64 bit word (MurmurHash3 finalizer).
+
+    Parameters:
+        h (size_t) : hash value from a client hash function
+
+    Output:
+        A 64 bit value in which every input bit affects every output bit.
+
+    Runtime: O(1)
+*/
+static unsigned long long mix(size_t h);
+
+/*
+    Computes the column of a key's counter in a row of a CountMinSketch.
+
+    Parameters:
+        c (const CountMinSketch *) : pointer to the sketch
+        h (unsigned long long) : mixed hash of the key
+        row (size_t) : the row
+
+    Output:
+        A column in [0, c->width). Each row uses a different function of h (double hashing), so keys that
+        collide in one row are unlikely to collide in the others.
+
+    Runtime: O(1)
+*/
+static size_t cmsColumn(const CountMinSketch *c, unsigned long long h, size_t row);
+
+// ***************************** PUBLIC HEADER FUNCTION DEFINITIONS ***********************************
+
+HyperLogLog *hllCreate(unsigned precision, size_t (*hash)(const void *))
+{
+    if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION)
+    {
+        return NULL;
+    }
+    HyperLogLog *h = (HyperLogLog *)malloc(sizeof(HyperLogLog));
+    h->precision = precision;
+    h->hash = hash;
+    // registers start at 0 (no key seen)
+    h->registers = (unsigned char *)calloc((size_t)1 << precision, sizeof(unsigned char));
+    return h;
+}
+
+void hllAdd(HyperLogLog *h, const void *key)
+{
+    unsigned long long x = mix((*h->hash)(key));
+    // top precision bits choose the register
+    size_t reg = (size_t)(x >> (64 - h->precision));
+    // rank = position of the first 1 bit in the remaining bits
+    unsigned long long rest = x << h->precision;
+    unsigned char rank = 1;
+    while (rank <= 64 - h->precision && (rest & 0x8000000000000000ULL) == 0)
+    {
+        rank++;
+        rest <<= 1;
+    }
+    if (rank > h->registers[reg])
+    {
+        h->registers[reg] = rank;
+    }
+}
+
+double hllCount(const HyperLogLog *h)
+{
+    size_t m = (size_t)1 << h->precision;
+    // harmonic mean of 2^register over all registers, and number of untouched registers
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (size_t i = 0; i < m; i++)
+    {
+        sum += ldexp(1.0, -(int)h->registers[i]);
+        if (h->registers[i] == 0)
+        {
+            zeros++;
+        }
+    }
+
+    // bias correction constant from Flajolet et al. (valid for m >= 128, close enough for smaller m)
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+
+    // raw estimate is biased for small cardinalities, linear counting is accurate there
+    if (estimate <= 2.5 * m && zeros > 0)
+    {
+        estimate = m * log((double)m / zeros);
+    }
+    return estimate;
+}
+
+int hllMerge(HyperLogLog *dest, const HyperLogLog *src)
+{
+    if (dest->precision != src->precision)
+    {
+        return 0;
+    }
+    // union of the key sets keeps the larger rank per register
+    size_t m = (size_t)1 << dest->precision;
+    for (size_t i = 0; i < m; i++)
+    {
+        if (src->registers[i] > dest->registers[i])
+        {
+            dest->registers[i] = src->registers[i];
+        }
+    }
+    return 1;
+}
+
+void hllFree(HyperLogLog *h)
+{
+    free((void *)h->registers);
+    h->registers = NULL;
+    h->hash = NULL;
+    free((void *)h);
+}
+
+CountMinSketch *cmsCreate(size_t width, size_t depth, size_t (*hash)(const void *))
+{
+    if (width == 0 || depth == 0)
+    {
+        return NULL;
+    }
+    CountMinSketch *c = (CountMinSketch *)malloc(sizeof(CountMinSketch));
+    c->width = width;
+    c->depth = depth;
+    c->hash = hash;
+    c->counters = (size_t *)calloc(width * depth, sizeof(size_t));
+    return c;
+}
+
+void cmsAdd(CountMinSketch *c, const void *key, size_t count)
+{
+    // key is only hashed once, the rows derive their columns from the same mixed hash
+    unsigned long long h = mix((*c->hash)(key));
+    for (size_t row = 0; row < c->depth; row++)
+    {
+        c->counters[row * c->width + cmsColumn(c, h, row)] += count;
+    }
+}
+
+size_t cmsEstimate(const CountMinSketch *c, const void *key)
+{
+    unsigned long long h = mix((*c->hash)(key));
+    // every row over-counts by its collisions, so the smallest counter is the best estimate
+    size_t min = c->counters[cmsColumn(c, h, 0)];
+    for (size_t row = 1; row < c->depth; row++)
+    {
+        size_t count = c->counters[row * c->width + cmsColumn(c, h, row)];
+        if (count < min)
+        {
+            min = count;
+        }
+    }
+    return min;
+}
+
+int cmsMerge(CountMinSketch *dest, const CountMinSketch *src)
+{
+    if (dest->width != src->width || dest->depth != src->depth)
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < dest->width * dest->depth; i++)
+    {
+        dest->counters[i] += src->counters[i];
+    }
+    return 1;
+}
+
+void cmsFree(CountMinSketch *c)
+{
+    free((void *)c->counters);
+    c->counters = NULL;
+    c->hash = NULL;
+    free((void *)c);
+}
+
+// ***************************** PRIVATE HELPER FUNCTION DEFINITIONS ***********************************
+
+static unsigned long long mix(size_t h)
+{
+    unsigned long long x = (unsigned long long)h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static size_t cmsColumn(const CountMinSketch *c, unsigned long long h, size_t row)
+{
+    // g_row(h) = h1 + row * h2. An odd h2 is coprime to a power of two width, so then the first width rows of a
+    // key never share a column. Other widths only make that likely (h2 may be a multiple of the width).
+    unsigned long long h1 = h & 0xFFFFFFFFULL;
+    unsigned long long h2 = (h >> 32) | 1;
+    return (size_t)((h1 + row * h2) % c->width);
+}
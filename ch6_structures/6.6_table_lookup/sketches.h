@@ -0,0 +1,162 @@
+/*
+    Contains declarations of approximate counting structures that answer questions normally answered by filling
+    a HashTable (see hash_table.h) using a small, fixed amount of memory:
+
+        HyperLogLog     : estimates the number of distinct keys added (what tableSize() would report)
+        CountMinSketch  : estimates how many times each key was added (what a table of counters would hold)
+
+    Both structures take the same hash function type as tableCreate(). The hash is mixed before use, so a
+    hash that only distributes well modulo a table capacity is fine, but keys whose hashes collide are counted
+    as the same key. Both structures can be merged with another structure of the same shape, so sketches built
+    over separate parts of a data set can be combined into a sketch of the whole data set.
+
+    Operations on keys are considered to be O(1).
+
+    Author: Chami Lamelas
+    10/19/2026
+*/
+
+#ifndef SKETCHES_H
+#define SKETCHES_H
+
+#include <stddef.h> // needed for size_t
+
+/*
+    Type definitions of the sketches. They are implemented via structures that hold register/counter arrays.
+*/
+typedef struct HyperLogLog HyperLogLog;
+typedef struct CountMinSketch CountMinSketch;
+
+/*
+    Creates an empty HyperLogLog.
+
+    Parameters:
+        precision (unsigned) : number of hash bits used to choose a register, between 4 and 18. The sketch
+            uses 2^precision bytes and its estimates have a standard error of about 1.04 / sqrt(2^precision)
+            (e.g. 0.81% for a precision of 14, which uses 16 KB).
+        hash (size_t (*) (const void *)) : hash function to be used on keys
+
+    Output:
+        A pointer to the created HyperLogLog, or NULL if precision is out of range.
+
+    Runtime: O(2^precision)
+*/
+HyperLogLog *hllCreate(unsigned precision, size_t (*hash)(const void *));
+
+/*
+    Adds a key to a provided HyperLogLog.
+
+    Parameters:
+        h (HyperLogLog *) : pointer to the HyperLogLog to update
+        key (const void *) : pointer to the key (not modified, not stored)
+
+    Runtime: O(1)
+*/
+void hllAdd(HyperLogLog *h, const void *key);
+
+/*
+    Estimates the number of distinct keys added to a provided HyperLogLog.
+
+    Parameters:
+        h (const HyperLogLog *) : pointer to a HyperLogLog (not modified)
+
+    Output:
+        The estimated number of distinct keys. Small cardinalities are estimated by linear counting, which is
+        close to exact.
+
+    Runtime: O(2^precision)
+*/
+double hllCount(const HyperLogLog *h);
+
+/*
+    Merges the keys of one HyperLogLog into another.
+
+    Parameters:
+        dest (HyperLogLog *) : pointer to the HyperLogLog to update
+        src (const HyperLogLog *) : pointer to the HyperLogLog to merge (not modified)
+
+    Output:
+        If both sketches have the same precision, dest afterwards estimates the number of distinct keys added to
+        either sketch and 1 is returned. Otherwise, dest is unchanged and 0 is returned. The sketches are
+        assumed to use the same hash function.
+
+    Runtime: O(2^precision)
+*/
+int hllMerge(HyperLogLog *dest, const HyperLogLog *src);
+
+/*
+    De-allocates the memory allocated to a provided HyperLogLog. The calling function should set h to NULL
+    afterwards to avoid undefined behavior.
+
+    Runtime: O(1)
+*/
+void hllFree(HyperLogLog *h);
+
+/*
+    Creates an empty CountMinSketch.
+
+    Parameters:
+        width (size_t) : number of counters per row. Estimates exceed the true count by at most
+            e / width * (total count added) with probability 1 - delta.
+        depth (size_t) : number of rows, delta = e^(-depth)
+        hash (size_t (*) (const void *)) : hash function to be used on keys
+
+    Output:
+        A pointer to the created CountMinSketch, or NULL if width or depth is 0. The sketch uses
+        width * depth counters.
+
+    Runtime: O(width * depth)
+*/
+CountMinSketch *cmsCreate(size_t width, size_t depth, size_t (*hash)(const void *));
+
+/*
+    Adds occurrences of a key to a provided CountMinSketch.
+
+    Parameters:
+        c (CountMinSketch *) : pointer to the CountMinSketch to update
+        key (const void *) : pointer to the key (not modified, not stored)
+        count (size_t) : number of occurrences to add
+
+    Runtime: O(depth)
+*/
+void cmsAdd(CountMinSketch *c, const void *key, size_t count);
+
+/*
+    Estimates the number of occurrences of a key in a provided CountMinSketch.
+
+    Parameters:
+        c (const CountMinSketch *) : pointer to a CountMinSketch (not modified)
+        key (const void *) : pointer to the key (not modified)
+
+    Output:
+        An estimate that is never smaller than the true number of occurrences.
+
+    Runtime: O(depth)
+*/
+size_t cmsEstimate(const CountMinSketch *c, const void *key);
+
+/*
+    Merges the counts of one CountMinSketch into another.
+
+    Parameters:
+        dest (CountMinSketch *) : pointer to the CountMinSketch to update
+        src (const CountMinSketch *) : pointer to the CountMinSketch to merge (not modified)
+
+    Output:
+        If both sketches have the same width and depth, dest afterwards estimates the combined counts of both
+        sketches and 1 is returned. Otherwise, dest is unchanged and 0 is returned. The sketches are assumed
+        to use the same hash function.
+
+    Runtime: O(width * depth)
+*/
+int cmsMerge(CountMinSketch *dest, const CountMinSketch *src);
+
+/*
+    De-allocates the memory allocated to a provided CountMinSketch. The calling function should set c to NULL
+    afterwards to avoid undefined behavior.
+
+    Runtime: O(1)
+*/
+void cmsFree(CountMinSketch *c);
+
+#endif
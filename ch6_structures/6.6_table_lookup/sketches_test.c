@@ -0,0 +1,114 @@
+#include "sketches.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+size_t fnvHash(const void *s);
+void hllTest(void);
+void cmsTest(void);
+
+int main()
+{
+    hllTest();
+    cmsTest();
+    return 0;
+}
+
+void hllTest(void)
+{
+    char key[32];
+    printf("%p\n", (void *)hllCreate(3, fnvHash)); // NULL
+
+    HyperLogLog *a = hllCreate(14, fnvHash);
+    HyperLogLog *b = hllCreate(14, fnvHash);
+    HyperLogLog *c = hllCreate(10, fnvHash);
+    printf("%.0f\n", hllCount(a)); // 0
+
+    // small cardinality, linear counting is near exact
+    for (int i = 0; i < 100; i++)
+    {
+        sprintf(key, "key%d", i);
+        hllAdd(a, key);
+        hllAdd(a, key); // duplicates don't count
+    }
+    printf("%d\n", hllCount(a) > 97 && hllCount(a) < 103); // 1
+
+    // a: [0, 100000), b: [50000, 150000)
+    for (int i = 0; i < 150000; i++)
+    {
+        sprintf(key, "key%d", i);
+        if (i < 100000)
+        {
+            hllAdd(a, key);
+        }
+        if (i >= 50000)
+        {
+            hllAdd(b, key);
+        }
+    }
+    // within 3% (about 4 standard errors)
+    double count = hllCount(a);
+    printf("%d\n", count > 97000 && count < 103000); // 1
+
+    printf("%d\n", hllMerge(a, c)); // 0
+    printf("%d\n", hllMerge(a, b)); // 1
+    count = hllCount(a);
+    printf("%d\n", count > 145500 && count < 154500); // 1
+
+    hllFree(a);
+    hllFree(b);
+    hllFree(c);
+    printf("HLL TEST DONE.\n");
+}
+
+void cmsTest(void)
+{
+    char key[32];
+    printf("%p\n", (void *)cmsCreate(0, 4, fnvHash)); // NULL
+
+    CountMinSketch *a = cmsCreate(2048, 4, fnvHash);
+    CountMinSketch *b = cmsCreate(2048, 4, fnvHash);
+    CountMinSketch *c = cmsCreate(1024, 4, fnvHash);
+    printf("%u\n", (unsigned)cmsEstimate(a, "heavy")); // 0
+
+    // one heavy hitter among many light keys
+    cmsAdd(a, "heavy", 5000);
+    for (int i = 0; i < 10000; i++)
+    {
+        sprintf(key, "light%d", i);
+        cmsAdd(a, key, 1);
+        cmsAdd(b, key, 2);
+    }
+    cmsAdd(b, "heavy", 1000);
+
+    // never under-estimates, over-estimate bounded by e / width * total (about 20 here)
+    size_t heavy = cmsEstimate(a, "heavy");
+    printf("%d\n", heavy >= 5000 && heavy < 5020); // 1
+    size_t light = cmsEstimate(a, "light42");
+    printf("%d\n", light >= 1 && light < 21); // 1
+
+    printf("%d\n", cmsMerge(a, c)); // 0
+    printf("%d\n", cmsMerge(a, b)); // 1
+    heavy = cmsEstimate(a, "heavy");
+    printf("%d\n", heavy >= 6000 && heavy < 6060); // 1
+    light = cmsEstimate(a, "light42");
+    printf("%d\n", light >= 3 && light < 63); // 1
+
+    cmsFree(a);
+    cmsFree(b);
+    cmsFree(c);
+    printf("CMS TEST DONE.\n");
+}
+
+size_t fnvHash(const void *s)
+{
+    size_t h = 2166136261u;
+    const unsigned char *cs = (const unsigned char *)s;
+    while (*cs != '\0')
+    {
+        h ^= *cs;
+        h *= 16777619u;
+        cs++;
+    }
+    return h;
+}